@@ -2,12 +2,15 @@
 #include "../defines_private.h"
 #include "../exceptions.h"
 #include "../strings.h"
+#include "./allocator_slab_private.h"
+#include "./allocator_private.h"
 
 #if ENGINE_PROFILER
     #include "./profiler_private.h"
 #endif
 
 #include <fmt/format.h>
+#include <string.h>
 
 namespace rengine{
     namespace core {
@@ -17,83 +20,260 @@ namespace rengine{
             alloc_malloc_callback malloc;
             alloc_free_callback free;
             alloc_realloc_callback realloc;
+            alloc_budget_callback budget_callback;
 
             size_t limit;
-            size_t usage;
             size_t scratch_usage;
-
-            size_t num_alloc;
-            size_t num_realloc;
-            size_t num_free;
         };
         
         extern alloc_data g_data = {
             malloc,
             free,
             realloc,
+            null,
             CORE_ALLOC_DEFAULT_LIMIT,
             0,
-            0,
         };
 		extern byte* g_scratch_buffer = null;
 
+        /*
+        * Every allocation is prefixed by a 64 bit header.
+        * Low 56 bits stores size, next 7 bits stores alloc_tag
+        * and aligned allocations marks the last bit and stores alignment
+        * and offset to original allocation right before the size header.
+        */
+        typedef u64 alloc_header;
+        static constexpr u32 g_alloc_tag_shift = 56;
+        static constexpr alloc_header g_alloc_size_mask = ((alloc_header)1 << g_alloc_tag_shift) - 1;
+        static constexpr alloc_header g_alloc_tag_mask = 0x7F;
+        static constexpr alloc_header g_alloc_aligned_flag = (alloc_header)1 << 63;
+
+        static_assert((u8)alloc_tag::count <= g_alloc_tag_mask + 1, "alloc_tag doesn't fit on allocation header");
+        static_assert(_countof(strings::g_alloc_tag_names) == (u8)alloc_tag::count, "Missing alloc_tag names");
+
+        struct alloc_aligned_header {
+            u32 offset;
+            u32 alignment;
+            alloc_header size;
+        };
+
+        /*
+        * General tag isn't tracked here, most of allocations are general
+        * and tracking them would make every thread touch the same cache line.
+        * General stats are derived from thread stats minus tagged stats.
+        */
+        struct alloc_tag_state {
+            alignas(CORE_CACHE_LINE_SIZE) std::atomic<i64> live{ 0 };
+            std::atomic<i64> peak{ 0 };
+            std::atomic<u64> num_alloc{ 0 };
+            std::atomic<u64> num_free{ 0 };
+            std::atomic<u64> num_over_budget{ 0 };
+            std::atomic<size_t> budget{ 0 };
+        };
+        static alloc_tag_state g_alloc_tags[(u8)alloc_tag::count];
+
+        static alloc_header alloc__encode_header(size_t size, alloc_tag tag) {
+            return (alloc_header)size | ((alloc_header)tag << g_alloc_tag_shift);
+        }
+
+        static size_t alloc__decode_size(alloc_header header) {
+            return (size_t)(header & g_alloc_size_mask);
+        }
+
+        static alloc_tag alloc__decode_tag(alloc_header header) {
+            return (alloc_tag)((header >> g_alloc_tag_shift) & g_alloc_tag_mask);
+        }
+
+        static c_str alloc__get_pool_name(alloc_tag tag) {
+            // general allocations goes to tracy default pool
+            return tag == alloc_tag::general ? null : strings::g_alloc_tag_names[(u8)tag];
+        }
+
+        static void alloc__update_peak(std::atomic<i64>& peak, i64 live) {
+            i64 curr_peak = peak.load(std::memory_order_relaxed);
+            while (live > curr_peak && !peak.compare_exchange_weak(curr_peak, live, std::memory_order_relaxed));
+        }
+
+        static void alloc__track_tag(alloc_tag tag, i64 size, std::atomic<u64> alloc_tag_state::* counter) {
+            if (tag == alloc_tag::general)
+                return;
+
+            auto& state = g_alloc_tags[(u8)tag];
+            const i64 live = state.live.fetch_add(size, std::memory_order_relaxed) + size;
+            if (counter)
+                (state.*counter).fetch_add(1, std::memory_order_relaxed);
+            if (size <= 0)
+                return;
+
+            alloc__update_peak(state.peak, live);
+
+            // notify only when live bytes crosses the budget
+            const i64 budget = (i64)state.budget.load(std::memory_order_relaxed);
+            if (budget == 0 || live <= budget || live - size > budget)
+                return;
+
+            state.num_over_budget.fetch_add(1, std::memory_order_relaxed);
+            if (g_data.budget_callback)
+                g_data.budget_callback(tag, alloc_get_stats(tag));
+        }
+
+        static i64 alloc__get_general_live() {
+            i64 live = alloc_slab__sum_usage();
+            for (u8 i = (u8)alloc_tag::general + 1; i < (u8)alloc_tag::count; ++i)
+                live -= g_alloc_tags[i].live.load(std::memory_order_relaxed);
+            return live < 0 ? 0 : live;
+        }
+
         void alloc__assert_limit(size_t limit) {
-            if(g_data.usage + limit <= g_data.limit )
+            if(g_alloc_slab_state.committed.load(std::memory_order_relaxed) + limit <= g_data.limit)
                 return;
             throw alloc_exception(strings::exceptions::g_core_alloc_memory_exceeded);
         }
 
-        ptr alloc(size_t size) {
+        ptr alloc__commit(size_t size) {
             alloc__assert_limit(size);
-            g_data.usage += size;
-            ++g_data.num_alloc;
+            g_alloc_slab_state.committed.fetch_add(size, std::memory_order_relaxed);
+            return g_data.malloc(size);
+        }
+
+        void alloc__decommit(ptr mem, size_t size) {
+            g_alloc_slab_state.committed.fetch_sub(size, std::memory_order_relaxed);
+            g_data.free(mem);
+        }
 
-            ptr ptr = g_data.malloc(size + sizeof(size_t));
-            *(size_t*)ptr = size;
+        ptr alloc(size_t size, alloc_tag tag) {
+            const size_t block_size = size + sizeof(alloc_header);
+            const u8 size_class = alloc_slab__get_class(block_size);
+
+            ptr ptr = size_class == g_alloc_slab_no_class
+                ? alloc__commit(block_size)
+                : alloc_slab__alloc(size_class);
+            *(alloc_header*)ptr = alloc__encode_header(size, tag);
+            alloc_slab__track((i64)size, &alloc_thread_stats::num_alloc);
+            alloc__track_tag(tag, (i64)size, &alloc_tag_state::num_alloc);
 
 #if ENGINE_PROFILER
-            profiler__alloc(ptr, size);
+            profiler__alloc(ptr, size, alloc__get_pool_name(tag));
 #endif
-            return (char*)ptr + sizeof(size_t);
+            return (char*)ptr + sizeof(alloc_header);
         }
 
         void alloc_free(ptr _ptr) {
             if(!_ptr)
                 return;
 
-            _ptr = (char*)_ptr - sizeof(size_t);
-            size_t size = *(size_t*)_ptr;
+            const alloc_header header = *((alloc_header*)_ptr - 1);
+            if (header & g_alloc_aligned_flag) {
+                alloc_free_aligned(_ptr);
+                return;
+            }
+
+            _ptr = (char*)_ptr - sizeof(alloc_header);
+            const size_t size = alloc__decode_size(header);
+            const alloc_tag tag = alloc__decode_tag(header);
+            const size_t block_size = size + sizeof(alloc_header);
+            const u8 size_class = alloc_slab__get_class(block_size);
 
 #if ENGINE_PROFILER
-            profiler__free(_ptr);
+            profiler__free(_ptr, alloc__get_pool_name(tag));
 #endif
 
-            g_data.usage -= size;
-            g_data.free(_ptr);
-            ++g_data.num_free;
+            if (size_class == g_alloc_slab_no_class)
+                alloc__decommit(_ptr, block_size);
+            else
+                alloc_slab__free(_ptr, size_class);
+            alloc_slab__track(-(i64)size, &alloc_thread_stats::num_free);
+            alloc__track_tag(tag, -(i64)size, &alloc_tag_state::num_free);
         }
 
         ptr alloc_realloc(ptr _ptr, size_t size) {
-            alloc__assert_limit(size);
             if(!_ptr)
-                return null;
+                return alloc(size);
+            if (*((alloc_header*)_ptr - 1) & g_alloc_aligned_flag)
+                return alloc_realloc_aligned(_ptr, size, ((alloc_aligned_header*)_ptr - 1)->alignment);
             
-            _ptr = (char*)_ptr - sizeof(size_t);
-            size_t old_size = *(size_t*)_ptr;
-            g_data.usage -= old_size;
-            ++g_data.num_realloc;
+            _ptr = (char*)_ptr - sizeof(alloc_header);
+            const alloc_header header = *(alloc_header*)_ptr;
+            const size_t old_size = alloc__decode_size(header);
+            const alloc_tag tag = alloc__decode_tag(header);
+            const u8 old_class = alloc_slab__get_class(old_size + sizeof(alloc_header));
+            const u8 new_class = alloc_slab__get_class(size + sizeof(alloc_header));
+
+            // same slab class, block has room enough for the new size
+            if (old_class == new_class && new_class != g_alloc_slab_no_class) {
+                *(alloc_header*)_ptr = alloc__encode_header(size, tag);
+                alloc_slab__track((i64)size - (i64)old_size, &alloc_thread_stats::num_realloc);
+                alloc__track_tag(tag, (i64)size - (i64)old_size, null);
+                return (char*)_ptr + sizeof(alloc_header);
+            }
+
+            if (old_class != g_alloc_slab_no_class || new_class != g_alloc_slab_no_class) {
+                ptr result = alloc(size, tag);
+                memcpy(result, (char*)_ptr + sizeof(alloc_header), old_size < size ? old_size : size);
+                alloc_free((char*)_ptr + sizeof(alloc_header));
+                return result;
+            }
+
+            if (size > old_size)
+                alloc__assert_limit(size - old_size);
 
 #if ENGINE_PROFILER
-            profiler__free(_ptr);
+            profiler__free(_ptr, alloc__get_pool_name(tag));
 #endif
-            _ptr = g_data.realloc(_ptr, size);
-            g_data.usage += size;
+            _ptr = g_data.realloc(_ptr, size + sizeof(alloc_header));
+            *(alloc_header*)_ptr = alloc__encode_header(size, tag);
+            g_alloc_slab_state.committed.fetch_add(size - old_size, std::memory_order_relaxed);
+            alloc_slab__track((i64)size - (i64)old_size, &alloc_thread_stats::num_realloc);
+            alloc__track_tag(tag, (i64)size - (i64)old_size, null);
 
 #if ENGINE_PROFILER
-            profiler__alloc(_ptr, size);
+            profiler__alloc(_ptr, size, alloc__get_pool_name(tag));
 #endif
 
-            return (char*)_ptr + sizeof(size_t);
+            return (char*)_ptr + sizeof(alloc_header);
+        }
+
+        ptr alloc_aligned(size_t size, size_t alignment, alloc_tag tag) {
+            return alloc__aligned_offset(size, alignment, 0, tag);
+        }
+
+        ptr alloc__aligned_offset(size_t size, size_t alignment, size_t offset, alloc_tag tag) {
+            if (alignment <= CORE_ALLOC_DEFAULT_ALIGNMENT && (offset & (alignment - 1)) == 0)
+                return alloc(size, tag);
+
+            // result + offset is aligned, result stays between header and mem + header + alignment
+            byte* mem = (byte*)alloc(size + alignment + sizeof(alloc_aligned_header), tag);
+            byte* result = (byte*)alloc_align_forward(mem + sizeof(alloc_aligned_header) + offset, alignment) - offset;
+
+            auto* header = (alloc_aligned_header*)result - 1;
+            header->offset = (u32)(result - mem);
+            header->alignment = (u32)alignment;
+            header->size = (alloc_header)size | g_alloc_aligned_flag;
+            return result;
+        }
+
+        void alloc_free_aligned(ptr _ptr) {
+            if (!_ptr)
+                return;
+
+            const auto* header = (alloc_aligned_header*)_ptr - 1;
+            if (!(header->size & g_alloc_aligned_flag)) {
+                alloc_free(_ptr);
+                return;
+            }
+
+            alloc_free((byte*)_ptr - header->offset);
+        }
+
+        ptr alloc_realloc_aligned(ptr _ptr, size_t size, size_t alignment) {
+            if (!_ptr)
+                return alloc_aligned(size, alignment);
+
+            const size_t old_size = alloc_get_pointer_size(_ptr);
+            ptr result = alloc_aligned(size, alignment, alloc_get_pointer_tag(_ptr));
+            memcpy(result, _ptr, old_size < size ? old_size : size);
+            alloc_free(_ptr);
+            return result;
         }
 
         void alloc_set_limit(size_t limit) {
@@ -103,7 +283,28 @@ namespace rengine{
             return g_data.limit;
         }
         size_t alloc_get_usage() {
-            return g_data.usage;
+            const i64 usage = alloc_slab__sum_usage();
+            return usage < 0 ? 0 : (size_t)usage;
+        }
+
+        size_t alloc_get_committed()
+        {
+            return g_alloc_slab_state.committed.load(std::memory_order_relaxed);
+        }
+
+        size_t alloc_get_num_allocs()
+        {
+            return alloc_slab__sum_counter(&alloc_thread_stats::num_alloc);
+        }
+
+        size_t alloc_get_num_reallocs()
+        {
+            return alloc_slab__sum_counter(&alloc_thread_stats::num_realloc);
+        }
+
+        size_t alloc_get_num_frees()
+        {
+            return alloc_slab__sum_counter(&alloc_thread_stats::num_free);
         }
 
         size_t alloc_get_scratch_usage()
@@ -114,8 +315,93 @@ namespace rengine{
         size_t alloc_get_pointer_size(ptr _ptr)
         {
             byte* data = (byte*)_ptr;
-            data -= sizeof(size_t);
-            return *(size_t*)data;
+            data -= sizeof(alloc_header);
+            const alloc_header header = *(alloc_header*)data;
+            if (header & g_alloc_aligned_flag)
+                return (size_t)(header & ~g_alloc_aligned_flag);
+            return alloc__decode_size(header);
+        }
+
+        alloc_tag alloc_get_pointer_tag(ptr _ptr)
+        {
+            const auto* header = (alloc_aligned_header*)_ptr - 1;
+            // aligned allocations keeps tag at original allocation header
+            if (header->size & g_alloc_aligned_flag)
+                _ptr = (byte*)_ptr - header->offset;
+            return alloc__decode_tag(*((alloc_header*)_ptr - 1));
+        }
+
+        alloc_tag_stats alloc_get_stats(alloc_tag tag)
+        {
+            alloc_tag_stats result = {};
+            if (tag >= alloc_tag::count)
+                return result;
+
+            auto& state = g_alloc_tags[(u8)tag];
+            if (tag != alloc_tag::general) {
+                const i64 live = state.live.load(std::memory_order_relaxed);
+                result.live = live < 0 ? 0 : (size_t)live;
+                result.peak = (size_t)state.peak.load(std::memory_order_relaxed);
+                result.num_allocs = state.num_alloc.load(std::memory_order_relaxed);
+                result.num_frees = state.num_free.load(std::memory_order_relaxed);
+                result.budget = state.budget.load(std::memory_order_relaxed);
+                result.num_over_budget = state.num_over_budget.load(std::memory_order_relaxed);
+                return result;
+            }
+
+            u64 num_allocs = alloc_slab__sum_counter(&alloc_thread_stats::num_alloc);
+            u64 num_frees = alloc_slab__sum_counter(&alloc_thread_stats::num_free);
+            for (u8 i = (u8)alloc_tag::general + 1; i < (u8)alloc_tag::count; ++i) {
+                num_allocs -= g_alloc_tags[i].num_alloc.load(std::memory_order_relaxed);
+                num_frees -= g_alloc_tags[i].num_free.load(std::memory_order_relaxed);
+            }
+
+            // stored peak is only updated by sampling, current value still counts
+            const i64 live = alloc__get_general_live();
+            const i64 peak = state.peak.load(std::memory_order_relaxed);
+            result.live = (size_t)live;
+            result.peak = (size_t)(live > peak ? live : peak);
+            result.num_allocs = num_allocs;
+            result.num_frees = num_frees;
+            result.budget = state.budget.load(std::memory_order_relaxed);
+            result.num_over_budget = state.num_over_budget.load(std::memory_order_relaxed);
+            return result;
+        }
+
+        void alloc__sample_general_stats()
+        {
+            // live keeps the last sample to detect budget crossing
+            auto& state = g_alloc_tags[(u8)alloc_tag::general];
+            const i64 live = alloc__get_general_live();
+            const i64 prev_live = state.live.exchange(live, std::memory_order_relaxed);
+            alloc__update_peak(state.peak, live);
+
+            const i64 budget = (i64)state.budget.load(std::memory_order_relaxed);
+            if (budget == 0 || live <= budget || prev_live > budget)
+                return;
+
+            state.num_over_budget.fetch_add(1, std::memory_order_relaxed);
+            if (g_data.budget_callback)
+                g_data.budget_callback(alloc_tag::general, alloc_get_stats(alloc_tag::general));
+        }
+
+        void alloc_set_budget(alloc_tag tag, size_t budget)
+        {
+            if (tag >= alloc_tag::count)
+                return;
+            g_alloc_tags[(u8)tag].budget.store(budget, std::memory_order_relaxed);
+        }
+
+        void alloc_set_budget_callback(const alloc_budget_callback callback)
+        {
+            g_data.budget_callback = callback;
+        }
+
+        c_str alloc_get_tag_name(alloc_tag tag)
+        {
+            if (tag >= alloc_tag::count)
+                return strings::g_empty;
+            return strings::g_alloc_tag_names[(u8)tag];
         }
 
         void alloc_set_malloc_callback(const alloc_malloc_callback callback) {
@@ -137,5 +423,5 @@ void* operator new[](size_t size, const char* pName, int flags, unsigned debugFl
 
 void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* pName, int flags, unsigned debugFlags, const char* file, int line)
 {
-    return rengine::core::alloc(size);
+    return rengine::core::alloc__aligned_offset(size, alignment, alignmentOffset, rengine::core::alloc_tag::general);
 }
@@ -13,27 +13,105 @@ namespace rengine {
         typedef alloc_free_callback_ alloc_free_callback;
         typedef alloc_realloc_callback_ alloc_realloc_callback;
 
-        R_EXPORT ptr alloc(size_t size);
+        /*
+        * Subsystem that owns an allocation. Each tag keeps its own
+        * live bytes, peak, counters and budget. Tag is stored on allocation header
+        * then realloc and free doesn't need to know it.
+        */
+        enum class alloc_tag : u8 {
+            general = 0,
+            drawing,
+            imgui,
+            diligent,
+            image,
+            string_pool,
+            logger,
+            render_command,
+            profiler,
+            events,
+            count
+        };
+
+        struct alloc_tag_stats {
+            size_t live;
+            size_t peak;
+            size_t num_allocs;
+            size_t num_frees;
+            // 0 means unlimited
+            size_t budget;
+            // number of allocations that made live bytes go above budget
+            size_t num_over_budget;
+        };
+
+        typedef void (*alloc_budget_callback_)(alloc_tag, const alloc_tag_stats&);
+        typedef alloc_budget_callback_ alloc_budget_callback;
+
+        R_EXPORT ptr alloc(size_t size, alloc_tag tag = alloc_tag::general);
         R_EXPORT void alloc_free(ptr _ptr);
+        // reallocation keeps the tag of the given pointer
         R_EXPORT ptr alloc_realloc(ptr _ptr, size_t size);
+        /*
+        * Allocate memory aligned to given alignment, alignment must be power of two.
+        * Returned memory can be released by alloc_free or alloc_free_aligned
+        * and alloc_get_pointer_size returns the requested size.
+        */
+        R_EXPORT ptr alloc_aligned(size_t size, size_t alignment, alloc_tag tag = alloc_tag::general);
+        R_EXPORT void alloc_free_aligned(ptr _ptr);
+        R_EXPORT ptr alloc_realloc_aligned(ptr _ptr, size_t size, size_t alignment);
         R_EXPORT void alloc_set_limit(size_t limit);
         R_EXPORT size_t alloc_get_limit();
         R_EXPORT size_t alloc_get_usage();
+        // bytes requested to allocator backend, memory limit is checked against this value
+        R_EXPORT size_t alloc_get_committed();
+        R_EXPORT size_t alloc_get_num_allocs();
+        R_EXPORT size_t alloc_get_num_reallocs();
+        R_EXPORT size_t alloc_get_num_frees();
 		R_EXPORT size_t alloc_get_scratch_usage();
         R_EXPORT size_t alloc_get_pointer_size(ptr _ptr);
+        R_EXPORT alloc_tag alloc_get_pointer_tag(ptr _ptr);
+        // doesn't change any state, general tag peak and budget are sampled once per frame
+        R_EXPORT alloc_tag_stats alloc_get_stats(alloc_tag tag);
+        // budget is a soft limit, exceeding it calls budget callback instead of throwing
+        R_EXPORT void alloc_set_budget(alloc_tag tag, size_t budget);
+        R_EXPORT void alloc_set_budget_callback(const alloc_budget_callback callback);
+        R_EXPORT c_str alloc_get_tag_name(alloc_tag tag);
         R_EXPORT void alloc_set_malloc_callback(const alloc_malloc_callback callback);
         R_EXPORT void alloc_set_free_callback(const alloc_free_callback callback);
         R_EXPORT void alloc_set_realloc_callback(const alloc_realloc_callback callback);
 
+        constexpr size_t alloc_align_size(size_t size, size_t alignment) {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        inline ptr alloc_align_forward(ptr mem, size_t alignment) {
+            return (ptr)alloc_align_size((size_t)mem, alignment);
+        }
+
         template <typename T, typename... Args>
         inline T* alloc_new(Args&&... args) {
-            T* ptr = (T*)alloc(sizeof(T));
+            T* ptr = alignof(T) > CORE_ALLOC_DEFAULT_ALIGNMENT
+                ? (T*)alloc_aligned(sizeof(T), alignof(T))
+                : (T*)alloc(sizeof(T));
             return new(ptr) T(std::forward<Args>(args)...);
         }
 
+        template <typename T, typename... Args>
+        inline T* alloc_new_tagged(alloc_tag tag, Args&&... args) {
+            T* ptr = alignof(T) > CORE_ALLOC_DEFAULT_ALIGNMENT
+                ? (T*)alloc_aligned(sizeof(T), alignof(T), tag)
+                : (T*)alloc(sizeof(T), tag);
+            return new(ptr) T(std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        inline T* alloc_array_alloc(size_t count, alloc_tag tag = alloc_tag::general) {
+            T* ptr = (T*)alloc(sizeof(T) * count, tag);
+            return ptr;
+        }
+
         template <typename T>
-        inline T* alloc_array_alloc(size_t count) {
-            T* ptr = (T*)alloc(sizeof(T) * count);
+        inline T* alloc_array_alloc_aligned(size_t count, size_t alignment = alignof(T)) {
+            T* ptr = (T*)alloc_aligned(sizeof(T) * count, alignment);
             return ptr;
         }
 
@@ -20,18 +20,19 @@ namespace rengine {
 
 		class EngineStlAllocator {
 		public:
-			explicit EngineStlAllocator(c_str name = "rengine") : name_(name) {}
+			explicit EngineStlAllocator(c_str name = "rengine", alloc_tag tag = alloc_tag::general) : name_(name), tag_(tag) {}
 			EngineStlAllocator(const EngineStlAllocator& x) {
 				name_ = x.name_;
+				tag_ = x.tag_;
 			}
-			EngineStlAllocator(const EngineStlAllocator& x, c_str name): name_(name) {
+			EngineStlAllocator(const EngineStlAllocator& x, c_str name): name_(name), tag_(x.tag_) {
 			}
 
 			void* allocate(size_t size, int flags = 0) {
-				return alloc(size);
+				return alloc(size, tag_);
 			}
 			void* allocate(size_t n, size_t alignment, size_t offset, int flags) {
-				return alloc(n);
+				return alloc_aligned(n, alignment, tag_);
 			}
 			void deallocate(void* ptr, size_t size) {
 				alloc_free(ptr);
@@ -39,6 +40,8 @@ namespace rengine {
 
 			c_str get_name() const { return name_; }
 			void set_name(c_str name) { name_ = name; }
+			alloc_tag get_tag() const { return tag_; }
+			void set_tag(alloc_tag tag) { tag_ = tag; }
 
 			bool operator==(const EngineStlAllocator& target) const {
 				return strcmp(name_, target.name_) == 0;
@@ -48,14 +51,23 @@ namespace rengine {
 			}
 		private:
 			c_str name_;
+			alloc_tag tag_;
 		};
 
-		template<AllocatorIdentifier identifier>
+		template<AllocatorIdentifier identifier, alloc_tag tag = alloc_tag::general>
 		class EngineAllocator : public EngineStlAllocator {
 		public:
-			EngineAllocator() : EngineStlAllocator(identifier.c_str()){}
+			EngineAllocator() : EngineStlAllocator(identifier.c_str(), tag){}
 		};
 
+		/*
+		* General tag isn't tracked per allocation, its peak and budget
+		* are sampled once per frame and budget callback is called from here.
+		*/
+		void alloc__sample_general_stats();
+		// same as alloc_aligned but aligns address + offset, required by EASTL aligned allocations
+		ptr alloc__aligned_offset(size_t size, size_t alignment, size_t offset, alloc_tag tag);
+
 		//EngineStlAllocator* g_default_stl_allocator_ptr = &g_default_stl_allocator;
 
 		/*EngineStlAllocator* get_default_allocator() {
@@ -0,0 +1,221 @@
+#include "./allocator_slab_private.h"
+
+namespace rengine {
+	namespace core {
+		alloc_slab_state g_alloc_slab_state = {};
+
+		static thread_local alloc_thread_cache g_alloc_thread_cache = {};
+		// thread cache can be destroyed before static objects that still release memory at exit
+		static thread_local bool g_alloc_thread_cache_destroyed = false;
+
+		struct alloc_slab_class_table {
+			u8 classes[(CORE_ALLOC_SLAB_MAX_SIZE / g_alloc_slab_granularity) + 1];
+
+			constexpr alloc_slab_class_table() : classes() {
+				u8 curr_class = 0;
+				for (u32 i = 0; i < _countof(classes); ++i) {
+					while (g_alloc_slab_sizes[curr_class] < i * g_alloc_slab_granularity)
+						++curr_class;
+					classes[i] = curr_class;
+				}
+			}
+		};
+		constexpr static alloc_slab_class_table g_alloc_slab_class_table = {};
+
+		alloc_thread_cache::~alloc_thread_cache()
+		{
+			for (u8 i = 0; i < g_alloc_slab_num_classes; ++i)
+				alloc_slab__flush_bin(bins[i], i, bins[i].count);
+
+			if (registered) {
+				auto& state = g_alloc_slab_state;
+				std::lock_guard<std::mutex> lock(state.threads_lock);
+				if (prev)
+					prev->next = next;
+				else
+					state.threads = next;
+				if (next)
+					next->prev = prev;
+
+				state.retired.usage.fetch_add(stats.usage.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				state.retired.num_alloc.fetch_add(stats.num_alloc.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				state.retired.num_realloc.fetch_add(stats.num_realloc.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				state.retired.num_free.fetch_add(stats.num_free.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				registered = false;
+			}
+
+			g_alloc_thread_cache_destroyed = true;
+		}
+
+		u8 alloc_slab__get_class(size_t size)
+		{
+			if (size > CORE_ALLOC_SLAB_MAX_SIZE)
+				return g_alloc_slab_no_class;
+			return g_alloc_slab_class_table.classes[(size + g_alloc_slab_granularity - 1) / g_alloc_slab_granularity];
+		}
+
+		ptr alloc_slab__alloc(u8 size_class)
+		{
+			if (g_alloc_thread_cache_destroyed) {
+				alloc_slab_bin bin = {};
+				alloc_slab__refill_bin(bin, size_class);
+				auto* block = bin.head;
+				bin.head = block->next;
+				--bin.count;
+				alloc_slab__flush_bin(bin, size_class, bin.count);
+				return block;
+			}
+
+			auto& bin = alloc_slab__get_thread_cache().bins[size_class];
+			if (!bin.head)
+				alloc_slab__refill_bin(bin, size_class);
+
+			auto* block = bin.head;
+			bin.head = block->next;
+			--bin.count;
+			return block;
+		}
+
+		void alloc_slab__free(ptr block, u8 size_class)
+		{
+			auto* slab_block = (alloc_slab_block*)block;
+			if (g_alloc_thread_cache_destroyed) {
+				alloc_slab_bin bin = {};
+				slab_block->next = null;
+				bin.head = slab_block;
+				bin.count = 1;
+				alloc_slab__flush_bin(bin, size_class, 1);
+				return;
+			}
+
+			auto& bin = alloc_slab__get_thread_cache().bins[size_class];
+			slab_block->next = bin.head;
+			bin.head = slab_block;
+			++bin.count;
+
+			// keep thread cache bounded, return the excess to depot
+			if (bin.count >= CORE_ALLOC_SLAB_BATCH_COUNT * 2)
+				alloc_slab__flush_bin(bin, size_class, CORE_ALLOC_SLAB_BATCH_COUNT);
+		}
+
+		alloc_thread_cache& alloc_slab__get_thread_cache()
+		{
+			auto& cache = g_alloc_thread_cache;
+			if (cache.registered)
+				return cache;
+
+			auto& state = g_alloc_slab_state;
+			std::lock_guard<std::mutex> lock(state.threads_lock);
+			cache.prev = null;
+			cache.next = state.threads;
+			if (state.threads)
+				state.threads->prev = &cache;
+			state.threads = &cache;
+			cache.registered = true;
+			return cache;
+		}
+
+		void alloc_slab__track(i64 usage, std::atomic<u64> alloc_thread_stats::* counter)
+		{
+			if (g_alloc_thread_cache_destroyed) {
+				auto& retired = g_alloc_slab_state.retired;
+				retired.usage.fetch_add(usage, std::memory_order_relaxed);
+				(retired.*counter).fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			auto& stats = alloc_slab__get_thread_cache().stats;
+			alloc_slab__add_stat(stats.usage, usage);
+			alloc_slab__add_stat(stats.*counter, 1);
+		}
+
+		void alloc_slab__flush_bin(alloc_slab_bin& bin, u8 size_class, u32 count)
+		{
+			if (count == 0 || !bin.head)
+				return;
+
+			alloc_slab_block* first = bin.head;
+			alloc_slab_block* last = first;
+			u32 num_blocks = 1;
+			while (num_blocks < count && last->next) {
+				last = last->next;
+				++num_blocks;
+			}
+
+			bin.head = last->next;
+			bin.count -= num_blocks;
+
+			auto& depot = g_alloc_slab_state.bins[size_class];
+			std::lock_guard<std::mutex> lock(depot.lock);
+			last->next = depot.head;
+			depot.head = first;
+			depot.count += num_blocks;
+		}
+
+		void alloc_slab__refill_bin(alloc_slab_bin& bin, u8 size_class)
+		{
+			auto& depot = g_alloc_slab_state.bins[size_class];
+			std::lock_guard<std::mutex> lock(depot.lock);
+			if (depot.count < CORE_ALLOC_SLAB_BATCH_COUNT)
+				alloc_slab__carve_span(depot, size_class);
+
+			u32 num_blocks = 0;
+			while (num_blocks < CORE_ALLOC_SLAB_BATCH_COUNT && depot.head) {
+				auto* block = depot.head;
+				depot.head = block->next;
+				block->next = bin.head;
+				bin.head = block;
+				++num_blocks;
+			}
+
+			depot.count -= num_blocks;
+			bin.count += num_blocks;
+		}
+
+		void alloc_slab__carve_span(alloc_depot_bin& depot, u8 size_class)
+		{
+			const size_t block_size = g_alloc_slab_sizes[size_class];
+			const size_t num_blocks = CORE_ALLOC_SLAB_SPAN_SIZE / block_size;
+			byte* span = (byte*)alloc__commit(CORE_ALLOC_SLAB_SPAN_SIZE);
+
+			// link blocks on address order, first allocations will be contiguous
+			for (size_t i = num_blocks; i > 0; --i) {
+				auto* block = (alloc_slab_block*)(span + (i - 1) * block_size);
+				block->next = depot.head;
+				depot.head = block;
+			}
+			depot.count += num_blocks;
+		}
+
+		void alloc_slab__add_stat(std::atomic<i64>& stat, i64 value)
+		{
+			// single writer, avoid locked instructions on hot path
+			stat.store(stat.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		void alloc_slab__add_stat(std::atomic<u64>& stat, u64 value)
+		{
+			stat.store(stat.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		i64 alloc_slab__sum_usage()
+		{
+			auto& state = g_alloc_slab_state;
+			std::lock_guard<std::mutex> lock(state.threads_lock);
+			i64 result = state.retired.usage.load(std::memory_order_relaxed);
+			for (auto* cache = state.threads; cache; cache = cache->next)
+				result += cache->stats.usage.load(std::memory_order_relaxed);
+			return result;
+		}
+
+		u64 alloc_slab__sum_counter(std::atomic<u64> alloc_thread_stats::* counter)
+		{
+			auto& state = g_alloc_slab_state;
+			std::lock_guard<std::mutex> lock(state.threads_lock);
+			u64 result = (state.retired.*counter).load(std::memory_order_relaxed);
+			for (auto* cache = state.threads; cache; cache = cache->next)
+				result += (cache->stats.*counter).load(std::memory_order_relaxed);
+			return result;
+		}
+	}
+}
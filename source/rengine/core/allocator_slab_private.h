@@ -0,0 +1,87 @@
+#pragma once
+#include "../base_private.h"
+#include "./allocator.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace rengine {
+	namespace core {
+		constexpr static size_t g_alloc_slab_sizes[] = {
+			16, 32, 48, 64, 80, 96, 112, 128,
+			160, 192, 224, 256, 320, 384, 448, 512,
+			640, 768, 896, 1024, 1280, 1536, 1792, 2048
+		};
+		constexpr static u32 g_alloc_slab_num_classes = sizeof(g_alloc_slab_sizes) / sizeof(size_t);
+		constexpr static u32 g_alloc_slab_granularity = 16;
+		constexpr static u8 g_alloc_slab_no_class = MAX_U8_VALUE;
+
+		static_assert(g_alloc_slab_sizes[g_alloc_slab_num_classes - 1] == CORE_ALLOC_SLAB_MAX_SIZE, "Last slab size class must be equal to CORE_ALLOC_SLAB_MAX_SIZE");
+
+		struct alloc_slab_block {
+			alloc_slab_block* next;
+		};
+
+		struct alloc_slab_bin {
+			alloc_slab_block* head{ null };
+			u32 count{ 0 };
+		};
+
+		/*
+		* Counters are written only by the owner thread
+		* and read by any thread when stats are aggregated
+		*/
+		struct alloc_thread_stats {
+			std::atomic<i64> usage{ 0 };
+			std::atomic<u64> num_alloc{ 0 };
+			std::atomic<u64> num_realloc{ 0 };
+			std::atomic<u64> num_free{ 0 };
+		};
+
+		struct alloc_thread_cache {
+			alloc_slab_bin bins[g_alloc_slab_num_classes];
+			alloc_thread_stats stats;
+			alloc_thread_cache* prev{ null };
+			alloc_thread_cache* next{ null };
+			bool registered{ false };
+
+			~alloc_thread_cache();
+		};
+
+		struct alloc_depot_bin {
+			std::mutex lock;
+			alloc_slab_block* head{ null };
+			size_t count{ 0 };
+		};
+
+		struct alloc_slab_state {
+			alloc_depot_bin bins[g_alloc_slab_num_classes];
+			std::mutex threads_lock;
+			alloc_thread_cache* threads{ null };
+			// stats from threads that has been finished
+			alloc_thread_stats retired;
+			// bytes requested to backend (slab spans + large allocations)
+			std::atomic<size_t> committed{ 0 };
+		};
+		extern alloc_slab_state g_alloc_slab_state;
+
+		// request memory from allocator backend (malloc callback), checks memory limit
+		ptr alloc__commit(size_t size);
+		void alloc__decommit(ptr mem, size_t size);
+
+		u8 alloc_slab__get_class(size_t size);
+		ptr alloc_slab__alloc(u8 size_class);
+		void alloc_slab__free(ptr block, u8 size_class);
+		alloc_thread_cache& alloc_slab__get_thread_cache();
+		// update calling thread counters
+		void alloc_slab__track(i64 usage, std::atomic<u64> alloc_thread_stats::* counter);
+		void alloc_slab__flush_bin(alloc_slab_bin& bin, u8 size_class, u32 count);
+		void alloc_slab__refill_bin(alloc_slab_bin& bin, u8 size_class);
+		void alloc_slab__carve_span(alloc_depot_bin& depot, u8 size_class);
+
+		void alloc_slab__add_stat(std::atomic<i64>& stat, i64 value);
+		void alloc_slab__add_stat(std::atomic<u64>& stat, u64 value);
+		i64 alloc_slab__sum_usage();
+		u64 alloc_slab__sum_counter(std::atomic<u64> alloc_thread_stats::* counter);
+	}
+}
@@ -1,10 +1,13 @@
 #include "arena.h"
 #include "allocator.h"
 #include "./arena_private.h"
+#include "./virtual_memory_private.h"
 
 #include "../exceptions.h"
 #include "rengine/math/math-operations.h"
 
+#include <fmt/format.h>
+
 namespace rengine {
 	namespace core {
 		class DefaultArena final : public IDefaultArena {
@@ -20,6 +23,14 @@ namespace rengine {
 				return core::alloc(size);
 			}
 
+			ptr alloc_aligned(const size_t size, const size_t alignment) override {
+				if (!size)
+					return null;
+
+				usage_ += size;
+				return core::alloc_aligned(size, alignment);
+			}
+
 			ptr realloc(ptr mem, const size_t new_size) override {
 				if (!mem)
 					return null;
@@ -63,20 +74,27 @@ namespace rengine {
 			}
 
 			ptr alloc(const size_t size) override {
-				ptr result = null;
-				const auto available_bucket_size = bucket_mem_size_ - curr_bucket_mem_size_;
+				return alloc_aligned(size, 1);
+			}
 
+			ptr alloc_aligned(const size_t size, const size_t alignment) override {
+				ptr result = null;
 				if (0 == size)
 					return result;
 
-				usage_ += size;
-				if (size <= available_bucket_size) {
-					result = bucket_mem_ + curr_bucket_mem_size_;
-					curr_bucket_mem_size_ += size;
+				byte* curr_mem = bucket_mem_ + curr_bucket_mem_size_;
+				const size_t padding = (byte*)alloc_align_forward(curr_mem, alignment) - curr_mem;
+				const auto available_bucket_size = bucket_mem_size_ - curr_bucket_mem_size_;
+
+				usage_ += size + padding;
+				if (bucket_mem_ && size + padding <= available_bucket_size) {
+					result = curr_mem + padding;
+					curr_bucket_mem_size_ += size + padding;
 					return result;
 				}
 
-				byte* untrack_mem = (byte*)core::alloc(sizeof(untrack_mem_link_t) + size);
+				const size_t extra_size = alignment > 1 ? alignment : 0;
+				byte* untrack_mem = (byte*)core::alloc(sizeof(untrack_mem_link_t) + size + extra_size);
 				untrack_mem_link_t* link = (untrack_mem_link_t*)untrack_mem;
 				link->prev = links_;
 				link->next = null;
@@ -85,7 +103,7 @@ namespace rengine {
 				links_ = link;
 
 				++num_blocks_;
-				return untrack_mem + sizeof(untrack_mem_link_t);
+				return alloc_align_forward(untrack_mem + sizeof(untrack_mem_link_t), alignment);
 			}
 
 			ptr realloc(ptr mem, const size_t new_size) override {
@@ -146,14 +164,296 @@ namespace rengine {
 			}
 
 			ptr alloc(const size_t size) override {
+				return alloc_aligned(size, 1);
+			}
+
+			ptr alloc_aligned(const size_t size, const size_t alignment) override {
 				const auto available_space = capacity_ - usage_;
-				if (size > available_space)
+				if (size + alignment - 1 > available_space)
 					throw out_of_memory_exception();
 
-				return FrameArena::alloc(size);
+				return FrameArena::alloc_aligned(size, alignment);
+			}
+		private:
+			size_t capacity_{ 0 };
+		};
+
+		/*
+		* Frame arena backed by a chain of pages.
+		* When a page is full, next page is allocated with geometric growth
+		* and pages are kept between resets, so memory is never copied.
+		*/
+		class PagedFrameArena final : public IFrameArena {
+		public:
+			struct page_t {
+				page_t* next;
+				size_t size;
+				size_t used;
+			};
+
+			PagedFrameArena() {}
+			~PagedFrameArena() override {
+				while (first_) {
+					auto* next = first_->next;
+					core::alloc_free(first_);
+					first_ = next;
+				}
+			}
+
+			void init_page(const size_t size, const alloc_tag tag) {
+				tag_ = tag;
+				first_ = curr_ = alloc_page(size);
+			}
+
+			ptr alloc(const size_t size) override {
+				return alloc_aligned(size, 1);
+			}
+
+			ptr alloc_aligned(const size_t size, const size_t alignment) override {
+				if (0 == size)
+					return null;
+
+				while (true) {
+					byte* page_mem = (byte*)(curr_ + 1);
+					byte* curr_mem = page_mem + curr_->used;
+					const size_t padding = (byte*)alloc_align_forward(curr_mem, alignment) - curr_mem;
+
+					if (curr_->used + padding + size <= curr_->size) {
+						curr_->used += padding + size;
+						usage_ += padding + size;
+						return curr_mem + padding;
+					}
+
+					if (!curr_->next) {
+						const size_t min_size = size + alignment;
+						const size_t next_size = curr_->size * 2;
+						curr_->next = alloc_page(next_size > min_size ? next_size : min_size);
+						++num_blocks_;
+					}
+
+					curr_ = curr_->next;
+					curr_->used = 0;
+				}
+			}
+
+			ptr realloc(ptr mem, const size_t new_size) override {
+				return alloc(new_size);
+			}
+
+			void reset() override {
+				curr_ = first_;
+				curr_->used = 0;
+				usage_ = 0;
 			}
+
+			void destroy_block() override {
+				if (!first_->next)
+					return;
+
+				page_t* prev = first_;
+				while (prev->next->next)
+					prev = prev->next;
+
+				if (curr_ == prev->next)
+					curr_ = prev;
+
+				capacity_ -= prev->next->size;
+				core::alloc_free(prev->next);
+				prev->next = null;
+				--num_blocks_;
+			}
+
+			void destroy_all_blocks() override {
+				while (first_->next)
+					destroy_block();
+			}
+
+			size_t usage() const override { return usage_; }
+			size_t size() const override { return capacity_; }
+			size_t get_blocks_count() const override { return num_blocks_; }
 		private:
+			page_t* alloc_page(const size_t size) {
+				auto* page = (page_t*)core::alloc(sizeof(page_t) + size, tag_);
+				page->next = null;
+				page->size = size;
+				page->used = 0;
+				capacity_ += size;
+				return page;
+			}
+
+			page_t* first_{ null };
+			page_t* curr_{ null };
+			size_t num_blocks_{ 0 };
 			size_t capacity_{ 0 };
+			size_t usage_{ 0 };
+			alloc_tag tag_{ alloc_tag::general };
+		};
+
+		class FrameRingArena final : public IFrameRingArena {
+		public:
+			struct frame_slot_t {
+				PagedFrameArena* arena{ null };
+				u64 fence_value{ 0 };
+			};
+
+			FrameRingArena() {}
+			~FrameRingArena() override {
+				for (u32 i = 0; i < num_frames_; ++i) {
+					slots_[i].arena->~PagedFrameArena();
+					core::alloc_free(slots_[i].arena);
+				}
+			}
+
+			void init_frames(const size_t initial_size, const u32 frames_in_flight, const alloc_tag tag) {
+				num_frames_ = math::clamp(frames_in_flight, 1u, (u32)CORE_ARENA_MAX_FRAMES_IN_FLIGHT);
+				for (u32 i = 0; i < num_frames_; ++i) {
+					slots_[i].arena = core::alloc_new_tagged<PagedFrameArena>(tag);
+					slots_[i].arena->init_page(initial_size, tag);
+				}
+			}
+
+			void next_frame() override {
+				const auto& fence = g_arena_state.frame_fence;
+				slots_[curr_frame_].fence_value = fence.submitted ? fence.submitted(fence.user_data) : 0;
+
+				curr_frame_ = (curr_frame_ + 1) % num_frames_;
+				auto& slot = slots_[curr_frame_];
+
+				// GPU is still consuming memory of this frame
+				if (fence.completed && fence.completed(fence.user_data) < slot.fence_value && fence.wait)
+					fence.wait(slot.fence_value, fence.user_data);
+
+				slot.arena->reset();
+			}
+
+			IFrameArena* current() const override { return slots_[curr_frame_].arena; }
+			u32 frames_in_flight() const override { return num_frames_; }
+
+			ptr alloc(const size_t size) override { return current()->alloc(size); }
+			ptr alloc_aligned(const size_t size, const size_t alignment) override { return current()->alloc_aligned(size, alignment); }
+			ptr realloc(ptr mem, const size_t new_size) override { return current()->realloc(mem, new_size); }
+			void reset() override { current()->reset(); }
+			void destroy_block() override { current()->destroy_block(); }
+			void destroy_all_blocks() override { current()->destroy_all_blocks(); }
+
+			size_t usage() const override { return current()->usage(); }
+			size_t size() const override { return current()->size(); }
+			size_t get_blocks_count() const override { return current()->get_blocks_count(); }
+		private:
+			frame_slot_t slots_[CORE_ARENA_MAX_FRAMES_IN_FLIGHT];
+			u32 num_frames_{ 0 };
+			u32 curr_frame_{ 0 };
+		};
+
+		class VirtualArena final : public IVirtualArena {
+		public:
+			VirtualArena() {}
+			~VirtualArena() override {
+				if (base_)
+					virtual_memory__release(base_, reserved_);
+			}
+
+			void init_range(const virtual_arena_desc& desc) {
+				const size_t granularity = desc.huge_pages
+					? virtual_memory__huge_page_size()
+					: virtual_memory__page_size();
+				page_size_ = virtual_memory__page_size();
+				reserved_ = alloc_align_size(desc.reserve_size, granularity);
+				// arena keeps at least first commit, otherwise each reset would decommit everything
+				high_water_mark_ = alloc_align_size(desc.high_water_mark ? desc.high_water_mark : CORE_ARENA_VIRTUAL_COMMIT_SIZE, page_size_);
+				base_ = (byte*)virtual_memory__reserve(reserved_, desc.huge_pages);
+
+				if (!base_)
+					throw alloc_exception(
+						fmt::format(strings::exceptions::g_core_virtual_memory_reserve_failed, reserved_).c_str()
+					);
+			}
+
+			ptr alloc(const size_t size) override {
+				return alloc_aligned(size, 1);
+			}
+
+			ptr alloc_aligned(const size_t size, const size_t alignment) override {
+				if (0 == size)
+					return null;
+
+				byte* curr_mem = base_ + usage_;
+				const size_t padding = (byte*)alloc_align_forward(curr_mem, alignment) - curr_mem;
+				const size_t required_size = usage_ + padding + size;
+				if (required_size > reserved_)
+					throw out_of_memory_exception();
+
+				require_commit(required_size);
+				last_alloc_ = curr_mem + padding;
+				usage_ = required_size;
+				return last_alloc_;
+			}
+
+			ptr realloc(ptr mem, const size_t new_size) override {
+				// last allocation can grow in place
+				if (mem && mem == last_alloc_) {
+					const size_t required_size = ((byte*)mem - base_) + new_size;
+					if (required_size > reserved_)
+						throw out_of_memory_exception();
+
+					require_commit(required_size);
+					usage_ = required_size;
+					return mem;
+				}
+
+				// block size is not tracked, then everything up to arena top is the upper bound of old block.
+				// it must be taken before alloc, new block always starts after it and never overlaps
+				const size_t old_size = mem ? (base_ + usage_) - (byte*)mem : 0;
+				ptr result = alloc(new_size);
+				if (mem)
+					memcpy(result, mem, old_size < new_size ? old_size : new_size);
+				return result;
+			}
+
+			void reset() override {
+				usage_ = 0;
+				last_alloc_ = null;
+				if (committed_ > high_water_mark_)
+					decommit(high_water_mark_);
+			}
+
+			void decommit(const size_t keep_size) override {
+				const size_t keep = alloc_align_size(keep_size > usage_ ? keep_size : usage_, page_size_);
+				if (keep >= committed_)
+					return;
+
+				virtual_memory__decommit(base_ + keep, committed_ - keep);
+				committed_ = keep;
+			}
+
+			size_t usage() const override { return usage_; }
+			size_t size() const override { return committed_; }
+			size_t committed() const override { return committed_; }
+			size_t reserved() const override { return reserved_; }
+		private:
+			void require_commit(const size_t required_size) {
+				if (required_size <= committed_)
+					return;
+
+				// grow at least by commit size to reduce number of syscalls
+				const size_t min_commit = committed_ + CORE_ARENA_VIRTUAL_COMMIT_SIZE;
+				size_t new_commit = alloc_align_size(required_size > min_commit ? required_size : min_commit, page_size_);
+				new_commit = new_commit > reserved_ ? reserved_ : new_commit;
+
+				if (!virtual_memory__commit(base_ + committed_, new_commit - committed_))
+					throw alloc_exception(
+						fmt::format(strings::exceptions::g_core_virtual_memory_commit_failed, new_commit - committed_).c_str()
+					);
+				committed_ = new_commit;
+			}
+
+			byte* base_{ null };
+			byte* last_alloc_{ null };
+			size_t page_size_{ 0 };
+			size_t reserved_{ 0 };
+			size_t committed_{ 0 };
+			size_t high_water_mark_{ 0 };
+			size_t usage_{ 0 };
 		};
 
 		class ScratchArena : public IScratchArena {
@@ -172,16 +472,21 @@ namespace rengine {
 			}
 
 			ptr alloc(const size_t size) override {
+				return alloc_aligned(size, 1);
+			}
+
+			ptr alloc_aligned(const size_t size, const size_t alignment) override {
 				if (0 == size)
 					return null;
 
+				byte* curr_mem = buffer_ + usage_;
+				const size_t padding = (byte*)alloc_align_forward(curr_mem, alignment) - curr_mem;
 				const auto available_space = size_ - usage_;
-				if (size > available_space)
+				if (size + padding > available_space)
 					throw out_of_memory_exception();
 
-				byte* result = buffer_ + usage_;
-				*(size_t*)result = size;
-				usage_ += size;
+				byte* result = curr_mem + padding;
+				usage_ += size + padding;
 				return result;
 			}
 
@@ -202,6 +507,45 @@ namespace rengine {
 
 			void reset() override {
 				usage_ = 0;
+#if ENGINE_DEBUG
+				depth_ = 0;
+#endif
+			}
+
+			scratch_marker mark() override {
+				scratch_marker marker;
+				marker.offset = usage_;
+#if ENGINE_DEBUG
+				marker.depth = ++depth_;
+#endif
+				return marker;
+			}
+
+			void rewind(const scratch_marker& marker) override {
+#if ENGINE_DEBUG
+				if (marker.depth != depth_ || marker.offset > usage_)
+					throw alloc_exception(
+						fmt::format(strings::exceptions::g_core_alloc_scratch_invalid_rewind, marker.depth, depth_).c_str()
+					);
+				--depth_;
+#endif
+				usage_ = marker.offset;
+			}
+
+			void rewind_scope(const scratch_marker& marker) noexcept override {
+#if ENGINE_DEBUG
+				if (marker.depth != depth_ || marker.offset > usage_) {
+					if (g_arena_state.log)
+						g_arena_state.log->error_fmt(strings::exceptions::g_core_alloc_scratch_invalid_rewind, marker.depth, depth_);
+					// scopes above marker were leaked, memory is still released up to marker
+					depth_ = marker.depth > 0 ? marker.depth - 1 : 0;
+				}
+				else {
+					--depth_;
+				}
+#endif
+				if (marker.offset < usage_)
+					usage_ = marker.offset;
 			}
 
 			size_t usage() const override {
@@ -215,6 +559,9 @@ namespace rengine {
 			byte* buffer_{ null };
 			size_t usage_{ 0 };
 			size_t size_{ 0 };
+#if ENGINE_DEBUG
+			u32 depth_{ 0 };
+#endif
 		};
 
 		IDefaultArena* arena_create_default()
@@ -241,6 +588,14 @@ namespace rengine {
 			return arena;
 		}
 
+		IFrameArena* arena_create_paged(const size_t page_size, const alloc_tag tag)
+		{
+			auto arena = arena__alloc<PagedFrameArena>(arena_kind::paged);
+			arena->init_page(page_size, tag);
+			arena__push(arena);
+			return arena;
+		}
+
 		IScratchArena* arena_create_scratch(const size_t scratch_size)
 		{ 
 			auto arena = arena__alloc<ScratchArena>(arena_kind::scratch);
@@ -248,6 +603,33 @@ namespace rengine {
 			return arena;
 		}
 
+		IVirtualArena* arena_create_virtual(const virtual_arena_desc& desc)
+		{
+			auto arena = arena__alloc<VirtualArena>(arena_kind::virtual_memory);
+			try {
+				arena->init_range(desc);
+			}
+			catch (...) {
+				arena__destroy(arena);
+				throw;
+			}
+			arena__push(arena);
+			return arena;
+		}
+
+		IFrameRingArena* arena_create_frame_ring(const size_t initial_size, const u32 frames_in_flight, const alloc_tag tag)
+		{
+			auto arena = arena__alloc<FrameRingArena>(arena_kind::frame_ring);
+			arena->init_frames(initial_size, frames_in_flight, tag);
+			arena__push(arena);
+			return arena;
+		}
+
+		void arena_set_frame_fence(const arena_frame_fence& fence)
+		{
+			g_arena_state.frame_fence = fence;
+		}
+
 		void arena_destroy(IArena* arena)
 		{
 			arena__destroy(arena);
@@ -1,6 +1,7 @@
 #pragma once
 #include <rengine/api.h>
 #include <rengine/types.h>
+#include <rengine/core/allocator.h>
 
 namespace rengine {
 	namespace core {
@@ -8,6 +9,8 @@ namespace rengine {
 		public:
 			virtual ~IArena() {}
 			virtual ptr alloc(const size_t size) = 0;
+			// alignment must be power of two
+			virtual ptr alloc_aligned(const size_t size, const size_t alignment) = 0;
 			virtual ptr realloc(ptr mem, const size_t new_size) = 0;
 			virtual size_t usage() const = 0;
 			virtual size_t size() const = 0;
@@ -26,17 +29,93 @@ namespace rengine {
 			virtual void destroy_all_blocks() = 0;
 		};
 
+		/*
+		* Frames-in-flight ring of frame arenas.
+		* Each frame gets its own arena, which is recycled only
+		* after frame fence has been signaled by the GPU.
+		*/
+		class IFrameRingArena : public IFrameArena {
+		public:
+			// moves to next frame arena, waits for frame fence if arena is still in use.
+			virtual void next_frame() = 0;
+			virtual IFrameArena* current() const = 0;
+			virtual u32 frames_in_flight() const = 0;
+		};
+
+		/*
+		* Arena that reserves a contiguous virtual address range
+		* and commits pages on demand. Pointers are stable while arena grows.
+		*/
+		class IVirtualArena : public IArena {
+		public:
+			// release all allocations, pages above high water mark are returned to OS
+			virtual void reset() = 0;
+			// return physical pages above keep_size to OS
+			virtual void decommit(const size_t keep_size) = 0;
+			virtual size_t committed() const = 0;
+			virtual size_t reserved() const = 0;
+		};
+
+		struct virtual_arena_desc {
+			// size of virtual address range, this is the max size arena can grow
+			size_t reserve_size{ 0 };
+			// committed memory above this size is released on reset, 0 keeps first commit size
+			size_t high_water_mark{ 0 };
+			// request transparent huge pages, if supported by platform
+			bool huge_pages{ false };
+		};
+
+		typedef u64 (*arena_fence_value_fn_)(ptr user_data);
+		typedef void (*arena_fence_wait_fn_)(u64 value, ptr user_data);
+		typedef arena_fence_value_fn_ arena_fence_value_fn;
+		typedef arena_fence_wait_fn_ arena_fence_wait_fn;
+
+		struct arena_frame_fence {
+			// last value enqueued to be signaled at the end of a frame
+			arena_fence_value_fn submitted{ null };
+			// last value signaled by the GPU
+			arena_fence_value_fn completed{ null };
+			arena_fence_wait_fn wait{ null };
+			ptr user_data{ null };
+		};
+
+		struct scratch_marker {
+			size_t offset{ 0 };
+			// scope depth, used to validate rewind order on debug builds.
+			// kept on all builds, then layout doesn't change between debug and release consumers
+			u32 depth{ 0 };
+		};
+
 		class IScratchArena : public IArena {
 		public:
 			virtual void free(const size_t memory_amount) = 0;
 			virtual void reset() = 0;
 			virtual void resize(const size_t scratch_size) = 0;
+			// returns current position of scratch stack
+			virtual scratch_marker mark() = 0;
+			/*
+			* Release everything allocated after the given marker.
+			* Markers must be rewind in reverse order of creation.
+			*/
+			virtual void rewind(const scratch_marker& marker) = 0;
+			// same as rewind, but invalid order is logged instead of thrown. used by destructors
+			virtual void rewind_scope(const scratch_marker& marker) noexcept = 0;
 		};
 
 		R_EXPORT IDefaultArena* arena_create_default();
 		R_EXPORT IFrameArena* arena_create_frame(const size_t initial_size);
 		R_EXPORT IFrameArena* arena_create_fixed(const size_t max_size);
+		// growable arena made of linked pages, allocated pointers are stable while arena grows
+		R_EXPORT IFrameArena* arena_create_paged(const size_t page_size, const alloc_tag tag = alloc_tag::general);
 		R_EXPORT IScratchArena* arena_create_scratch(const size_t scratch_size);
+		R_EXPORT IVirtualArena* arena_create_virtual(const virtual_arena_desc& desc);
+		// pages are allocated with given tag, then frame memory can be accounted per subsystem
+		R_EXPORT IFrameRingArena* arena_create_frame_ring(const size_t initial_size, const u32 frames_in_flight, const alloc_tag tag = alloc_tag::general);
+		/*
+		* Set fence used by frame ring arenas to know when
+		* a frame has been completed. Graphics set this fence by default.
+		*/
+		R_EXPORT void arena_set_frame_fence(const arena_frame_fence& fence);
 		/*
 		* Destroy an Arena allocated by the Engine
 		* Don't use this method to destroy your own
@@ -46,5 +125,32 @@ namespace rengine {
 
 		R_EXPORT IArena* arena_get_default();
 		R_EXPORT IScratchArena* arena_get_scratch();
+
+		/*
+		* Marks scratch arena on construction and rewind it
+		* on destruction, releasing all memory allocated inside the scope.
+		*/
+		class scratch_scope {
+		public:
+			explicit scratch_scope(IScratchArena* arena = arena_get_scratch()) : arena_(arena), marker_(arena->mark()) {}
+			// destructors can't throw, then rewind order errors are logged
+			~scratch_scope() { arena_->rewind_scope(marker_); }
+
+			scratch_scope(const scratch_scope&) = delete;
+			scratch_scope& operator=(const scratch_scope&) = delete;
+
+			ptr alloc(const size_t size) { return arena_->alloc(size); }
+			ptr alloc_aligned(const size_t size, const size_t alignment) { return arena_->alloc_aligned(size, alignment); }
+
+			template <typename T>
+			T* alloc_array(const size_t count) {
+				return (T*)arena_->alloc_aligned(sizeof(T) * count, alignof(T));
+			}
+
+			IScratchArena* arena() const { return arena_; }
+		private:
+			IScratchArena* arena_;
+			scratch_marker marker_;
+		};
 	}
 }
\ No newline at end of file
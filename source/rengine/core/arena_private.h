@@ -12,6 +12,9 @@ namespace rengine {
 			frame,
 			fixed,
 			scratch,
+			frame_ring,
+			virtual_memory,
+			paged,
 			unknown
 		};
 
@@ -30,6 +33,7 @@ namespace rengine {
 			arena_link_t* root { null };
 			IArena* default_arena{ null };
 			IScratchArena* scratch_arena{ null };
+			arena_frame_fence frame_fence{};
 			size_t count{ 0 };
 			io::ILog* log{ null };
 		};
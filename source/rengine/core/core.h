@@ -3,7 +3,10 @@
 #include <rengine/core/string_pool.h>
 #include <rengine/core/window.h>
 #include <rengine/core/hash.h>
+#include <rengine/core/static_hash.h>
 #include <rengine/core/pool.h>
+#include <rengine/core/ring_queue.h>
 #include <rengine/core/entity-utils.h>
 #include <rengine/core/profiler.h>
-#include <rengine/core/number_utils.h>
\ No newline at end of file
+#include <rengine/core/number_utils.h>
+#include <rengine/core/job_system.h>
\ No newline at end of file
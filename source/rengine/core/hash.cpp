@@ -2,6 +2,7 @@
 #include "./number_utils.h"
 
 #include <utility>
+#define XXH_STATIC_LINKING_ONLY
 #include <xxHash/xxhash.h>
 
 namespace rengine {
@@ -67,5 +68,65 @@ namespace rengine {
 		{
 			return (first << 16u) | (second >> 16) ^ second;
 		}
+
+		static_assert(sizeof(XXH3_state_t) <= CORE_HASH64_STATE_SIZE, "CORE_HASH64_STATE_SIZE is less than XXH3 state size");
+		static_assert(alignof(XXH3_state_t) <= CORE_CACHE_LINE_SIZE, "XXH3 state alignment is greater than storage alignment");
+
+		hash64_t hash64(c_str str)
+		{
+			if (!str)
+				return 0x0;
+			return XXH3_64bits_withSeed(str, strlen(str), CORE_DEFAULT_HASH_SEED);
+		}
+
+		hash64_t hash64(const void* data, size_t size)
+		{
+			return XXH3_64bits_withSeed(data, size, CORE_DEFAULT_HASH_SEED);
+		}
+
+		hash64_t hash64(u32 value)
+		{
+			return XXH3_64bits_withSeed(&value, sizeof(u32), CORE_DEFAULT_HASH_SEED);
+		}
+
+		hash64_t hash64(u64 value)
+		{
+			return XXH3_64bits_withSeed(&value, sizeof(u64), CORE_DEFAULT_HASH_SEED);
+		}
+
+		hash64_t hash64_combine(hash64_t first, hash64_t second)
+		{
+			// boost like combine, multiply-xor alone loses high bits on 64-bit keys
+			return first ^ (second + CORE_HASH64_PRIME + (first << 6) + (first >> 2));
+		}
+
+		hash64_stream::hash64_stream(hash64_t seed)
+		{
+			reset(seed);
+		}
+
+		void hash64_stream::reset(hash64_t seed)
+		{
+			XXH3_64bits_reset_withSeed(reinterpret_cast<XXH3_state_t*>(state_), seed);
+		}
+
+		void hash64_stream::update(const void* data, size_t size)
+		{
+			if (size == 0)
+				return;
+			XXH3_64bits_update(reinterpret_cast<XXH3_state_t*>(state_), data, size);
+		}
+
+		void hash64_stream::update_str(c_str str)
+		{
+			const u32 length = str ? (u32)strlen(str) : 0;
+			update(&length, sizeof(u32));
+			update(str, length);
+		}
+
+		hash64_t hash64_stream::digest() const
+		{
+			return XXH3_64bits_digest(reinterpret_cast<const XXH3_state_t*>(state_));
+		}
 	}
 }
\ No newline at end of file
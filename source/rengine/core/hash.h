@@ -2,6 +2,8 @@
 #include <rengine/api.h>
 #include <rengine/types.h>
 
+#include <type_traits>
+
 namespace rengine {
 	namespace core {
 		R_EXPORT hash_t hash(c_str str);
@@ -15,5 +17,34 @@ namespace rengine {
 		R_EXPORT hash_t hash(const u32* values, u32 count);
 		R_EXPORT hash_t hash_combine(hash_t first, hash_t second);
 		R_EXPORT hash_t hash_fast_combine(hash_t first, hash_t second);
+
+		// 64-bit hashes are built on XXH3, use them to identify cached objects
+		R_EXPORT hash64_t hash64(c_str str);
+		R_EXPORT hash64_t hash64(const void* data, size_t size);
+		R_EXPORT hash64_t hash64(u32 value);
+		R_EXPORT hash64_t hash64(u64 value);
+		R_EXPORT hash64_t hash64_combine(hash64_t first, hash64_t second);
+
+		/*
+		* Streaming XXH3 state, used to hash composite keys
+		* without building and combining intermediate hashes.
+		*/
+		class R_EXPORT hash64_stream {
+		public:
+			hash64_stream(hash64_t seed = CORE_DEFAULT_HASH_SEED);
+
+			void reset(hash64_t seed = CORE_DEFAULT_HASH_SEED);
+			void update(const void* data, size_t size);
+			// string length is written before content, then "ab" + "c" differs from "a" + "bc"
+			void update_str(c_str str);
+			template<typename T>
+			void update_value(const T& value) {
+				static_assert(std::is_trivially_copyable_v<T>, "Value must be trivially copyable");
+				update(&value, sizeof(T));
+			}
+			hash64_t digest() const;
+		private:
+			alignas(CORE_CACHE_LINE_SIZE) byte state_[CORE_HASH64_STATE_SIZE];
+		};
 	}
-}
\ No newline at end of file
+}
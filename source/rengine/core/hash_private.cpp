@@ -0,0 +1,33 @@
+#include "./hash_private.h"
+#include "./profiler_private.h"
+
+namespace rengine {
+	namespace core {
+		void hash__cache_hit(hash_cache_stats& stats)
+		{
+			++stats.hits;
+			profiler__plot(stats.hits_name, (i64)stats.hits);
+		}
+
+		void hash__cache_miss(hash_cache_stats& stats)
+		{
+			++stats.misses;
+			profiler__plot(stats.misses_name, (i64)stats.misses);
+		}
+
+		void hash__cache_collision(hash_cache_stats& stats)
+		{
+			++stats.collisions;
+			profiler__plot(stats.collisions_name, (i64)stats.collisions);
+		}
+
+		bool hash__str_equals(c_str a, c_str b)
+		{
+			if (a == b)
+				return true;
+			if (!a || !b)
+				return false;
+			return strcmp(a, b) == 0;
+		}
+	}
+}
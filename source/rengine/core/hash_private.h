@@ -0,0 +1,27 @@
+#pragma once
+#include "../base_private.h"
+#include "./hash.h"
+
+namespace rengine {
+	namespace core {
+		/*
+		* Counters of caches keyed by hash64.
+		* A collision means that hash has been found but stored key differs,
+		* cache must not return the stored object on this case.
+		*/
+		struct hash_cache_stats {
+			c_str hits_name{ null };
+			c_str misses_name{ null };
+			c_str collisions_name{ null };
+			u64 hits{ 0 };
+			u64 misses{ 0 };
+			u64 collisions{ 0 };
+		};
+
+		void hash__cache_hit(hash_cache_stats& stats);
+		void hash__cache_miss(hash_cache_stats& stats);
+		void hash__cache_collision(hash_cache_stats& stats);
+		// null strings are equal
+		bool hash__str_equals(c_str a, c_str b);
+	}
+}
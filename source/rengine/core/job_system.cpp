@@ -0,0 +1,115 @@
+#include "./job_system.h"
+#include "./job_system_private.h"
+
+namespace rengine {
+	namespace core {
+		job_t job_system_schedule(const job_desc& desc)
+		{
+			job_system__assert_init();
+
+			auto& state = g_job_system_state;
+			const u32 idx = job_system__alloc_job();
+			auto& job = state.jobs[idx];
+			job.kind = job_kind::single;
+			job.callback = desc.callback;
+			job.range_callback = null;
+			job.user_data = desc.user_data;
+			job.parent = MAX_U32_VALUE;
+
+			const job_t result = job_system__encode_id(idx, job.generation);
+			job_system__add_child(idx, desc.parent);
+			for (u32 i = 0; i < desc.num_dependencies; ++i)
+				job_system__add_dependent(idx, desc.dependencies[i]);
+
+			job_system__release(idx);
+			return result;
+		}
+
+		job_t job_system_schedule(job_callback callback, ptr user_data, job_t dependency)
+		{
+			job_desc desc = {};
+			desc.callback = callback;
+			desc.user_data = user_data;
+			desc.dependencies = &dependency;
+			desc.num_dependencies = dependency == no_job ? 0 : 1;
+			return job_system_schedule(desc);
+		}
+
+		job_t job_system_schedule_for(const job_parallel_for_desc& desc)
+		{
+			job_system__assert_init();
+
+			auto& state = g_job_system_state;
+			u32 batch_size = desc.batch_size;
+			if (batch_size == 0)
+				batch_size = desc.count / (state.num_workers * 4);
+			batch_size = batch_size == 0 ? 1 : batch_size;
+
+			const u32 idx = job_system__alloc_job();
+			auto& job = state.jobs[idx];
+			job.kind = job_kind::range;
+			job.callback = null;
+			job.range_callback = desc.callback;
+			job.user_data = desc.user_data;
+			job.range_begin = 0;
+			job.range_end = desc.count;
+			job.batch_size = batch_size;
+			job.parent = MAX_U32_VALUE;
+
+			const job_t result = job_system__encode_id(idx, job.generation);
+			job_system__add_child(idx, desc.parent);
+			for (u32 i = 0; i < desc.num_dependencies; ++i)
+				job_system__add_dependent(idx, desc.dependencies[i]);
+
+			job_system__release(idx);
+			return result;
+		}
+
+		void job_system_parallel_for(u32 count, u32 batch_size, job_range_callback callback, ptr user_data)
+		{
+			if (count == 0 || !callback)
+				return;
+
+			job_parallel_for_desc desc = {};
+			desc.callback = callback;
+			desc.user_data = user_data;
+			desc.count = count;
+			desc.batch_size = batch_size;
+			job_system_wait(job_system_schedule_for(desc));
+		}
+
+		void job_system_wait(job_t job)
+		{
+			while (!job_system_is_completed(job)) {
+				if (!job_system__try_execute())
+					std::this_thread::yield();
+			}
+		}
+
+		void job_system_wait_all(const job_t* jobs, u32 num_jobs)
+		{
+			for (u32 i = 0; i < num_jobs; ++i)
+				job_system_wait(jobs[i]);
+		}
+
+		bool job_system_is_completed(job_t job)
+		{
+			const u32 idx = job_system__decode_idx(job);
+			if (job == no_job || idx >= CORE_JOB_SYSTEM_MAX_JOBS || !g_job_system_state.jobs)
+				return true;
+
+			const auto& entry = g_job_system_state.jobs[idx];
+			return entry.generation != job_system__decode_generation(job) || entry.unfinished == 0;
+		}
+
+		u32 job_system_num_workers()
+		{
+			return g_job_system_state.num_workers;
+		}
+
+		u32 job_system_worker_index()
+		{
+			return g_job_worker_idx;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <rengine/api.h>
+#include <rengine/types.h>
+
+namespace rengine {
+	namespace core {
+		typedef void (*job_callback_)(ptr user_data);
+		typedef void (*job_range_callback_)(u32 begin, u32 end, ptr user_data);
+		typedef job_callback_ job_callback;
+		typedef job_range_callback_ job_range_callback;
+
+		struct job_desc {
+			job_callback callback{ null };
+			ptr user_data{ null };
+			// parent job will only be completed after all of their children has been completed
+			job_t parent{ no_job };
+			// job will not run until all dependencies has been completed
+			const job_t* dependencies{ null };
+			u32 num_dependencies{ 0 };
+		};
+
+		struct job_parallel_for_desc {
+			job_range_callback callback{ null };
+			ptr user_data{ null };
+			u32 count{ 0 };
+			// number of items executed per job, if 0 engine will pick a batch size from worker count
+			u32 batch_size{ 0 };
+			job_t parent{ no_job };
+			const job_t* dependencies{ null };
+			u32 num_dependencies{ 0 };
+		};
+
+		R_EXPORT job_t job_system_schedule(const job_desc& desc);
+		R_EXPORT job_t job_system_schedule(job_callback callback, ptr user_data = null, job_t dependency = no_job);
+		/*
+		* Schedule a parallel for over [0, count) range.
+		* Returned job will be completed when all range jobs has been completed
+		*/
+		R_EXPORT job_t job_system_schedule_for(const job_parallel_for_desc& desc);
+		R_EXPORT void job_system_parallel_for(u32 count, u32 batch_size, job_range_callback callback, ptr user_data = null);
+		/*
+		* Wait until job has been completed.
+		* Calling thread will execute pending jobs while is waiting.
+		*/
+		R_EXPORT void job_system_wait(job_t job);
+		R_EXPORT void job_system_wait_all(const job_t* jobs, u32 num_jobs);
+		R_EXPORT bool job_system_is_completed(job_t job);
+		R_EXPORT u32 job_system_num_workers();
+		// Returns worker index of the calling thread, main thread is always 0
+		R_EXPORT u32 job_system_worker_index();
+	}
+}
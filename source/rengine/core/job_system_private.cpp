@@ -0,0 +1,416 @@
+#include "./job_system_private.h"
+#include "./allocator.h"
+#include "./profiler_private.h"
+#include "../exceptions.h"
+
+#include <fmt/format.h>
+
+namespace rengine {
+	namespace core {
+		job_system_state g_job_system_state = {};
+		thread_local u32 g_job_worker_idx = MAX_U32_VALUE;
+
+		static constexpr u32 g_job_mask = CORE_JOB_SYSTEM_MAX_JOBS - 1;
+
+		void job_system__init()
+		{
+			auto& state = g_job_system_state;
+			state.log = io::logger_use(strings::logs::g_job_system_tag);
+
+#if PLATFORM_WEB
+			u32 num_workers = 1;
+#else
+			u32 num_workers = std::thread::hardware_concurrency();
+#endif
+			num_workers = num_workers < 1 ? 1 : num_workers;
+			num_workers = num_workers > CORE_JOB_SYSTEM_MAX_WORKERS ? CORE_JOB_SYSTEM_MAX_WORKERS : num_workers;
+
+			state.jobs = (job_entry*)alloc(sizeof(job_entry) * CORE_JOB_SYSTEM_MAX_JOBS);
+			for (u32 i = 0; i < CORE_JOB_SYSTEM_MAX_JOBS; ++i)
+				new (state.jobs + i) job_entry();
+
+			for (u32 i = 0; i < num_workers; ++i) {
+				auto& queue = state.queues[i];
+				queue.items = (std::atomic<u32>*)alloc(sizeof(std::atomic<u32>) * CORE_JOB_SYSTEM_MAX_JOBS);
+				for (u32 j = 0; j < CORE_JOB_SYSTEM_MAX_JOBS; ++j)
+					new (queue.items + j) std::atomic<u32>(MAX_U32_VALUE);
+				queue.top = queue.bottom = 0;
+			}
+
+			state.shared_queue.items = alloc_array_alloc<u32>(CORE_JOB_SYSTEM_MAX_JOBS);
+			state.shared_queue.head = state.shared_queue.count = 0;
+
+			state.num_workers = num_workers;
+			state.num_queued = state.num_sleeping = 0;
+			state.running = true;
+
+			// main thread is always the first worker
+			g_job_worker_idx = 0;
+			for (u32 i = 1; i < num_workers; ++i)
+				state.workers[i] = std::thread(job_system__worker_main, i);
+
+			state.log->info(fmt::format(strings::logs::g_job_system_started, num_workers).c_str());
+		}
+
+		void job_system__deinit()
+		{
+			auto& state = g_job_system_state;
+			if (!state.running)
+				return;
+
+			{
+				std::lock_guard<std::mutex> lock(state.wake_lock);
+				state.running = false;
+			}
+			state.wake_cond.notify_all();
+
+			for (u32 i = 1; i < state.num_workers; ++i) {
+				if (state.workers[i].joinable())
+					state.workers[i].join();
+			}
+
+			for (u32 i = 0; i < state.num_workers; ++i) {
+				auto& queue = state.queues[i];
+				alloc_free(queue.items);
+				queue.items = null;
+				queue.top = queue.bottom = 0;
+			}
+
+			for (u32 i = 0; i < CORE_JOB_SYSTEM_MAX_JOBS; ++i)
+				state.jobs[i].~job_entry();
+			alloc_free(state.jobs);
+			alloc_free(state.shared_queue.items);
+
+			state.jobs = null;
+			state.shared_queue.items = null;
+			state.num_workers = 0;
+			g_job_worker_idx = MAX_U32_VALUE;
+		}
+
+		void job_system__assert_init()
+		{
+			if (g_job_system_state.running)
+				return;
+			throw job_system_exception(strings::exceptions::g_job_system_not_initialized);
+		}
+
+		void job_system__worker_main(u32 worker_idx)
+		{
+			auto& state = g_job_system_state;
+			g_job_worker_idx = worker_idx;
+
+			char thread_name[CORE_PROFILER_THREAD_NAME_SIZE];
+			const auto result = fmt::format_to_n(thread_name, CORE_PROFILER_THREAD_NAME_SIZE - 1, strings::profiler::job_worker_thread, worker_idx);
+			*result.out = '\0';
+			profiler__set_thread_name(thread_name);
+
+			while (state.running) {
+				if (job_system__try_execute())
+					continue;
+
+				// spin a little before going to sleep, new jobs usually arrive in bursts
+				bool found = false;
+				for (u32 i = 0; i < 32 && !found; ++i) {
+					std::this_thread::yield();
+					found = job_system__try_execute();
+				}
+				if (found)
+					continue;
+
+				std::unique_lock<std::mutex> lock(state.wake_lock);
+				++state.num_sleeping;
+				state.wake_cond.wait(lock, [&state]() {
+					return state.num_queued > 0 || !state.running;
+				});
+				--state.num_sleeping;
+			}
+
+			g_job_worker_idx = MAX_U32_VALUE;
+		}
+
+		u32 job_system__alloc_job()
+		{
+			auto& state = g_job_system_state;
+			u32 attempts = 0;
+			while (true) {
+				const u32 idx = state.next_job.fetch_add(1) & g_job_mask;
+				auto& job = state.jobs[idx];
+				{
+					std::lock_guard<std::mutex> lock(job.lock);
+					if (job.unfinished == 0) {
+						job.unfinished = 1;
+						job.pending_deps = 1;
+						job.num_dependents = 0;
+						job.generation = job.generation + 1;
+						return idx;
+					}
+				}
+
+				// all slots are busy, help other workers until a slot has been released
+				if (++attempts < CORE_JOB_SYSTEM_MAX_JOBS)
+					continue;
+				attempts = 0;
+				if (!job_system__try_execute())
+					std::this_thread::yield();
+			}
+		}
+
+		job_t job_system__encode_id(u32 idx, u16 generation)
+		{
+			return ((u32)generation << 16) | idx;
+		}
+
+		u32 job_system__decode_idx(job_t job)
+		{
+			return job & 0xFFFF;
+		}
+
+		u16 job_system__decode_generation(job_t job)
+		{
+			return (u16)(job >> 16);
+		}
+
+		bool job_system__add_child(u32 idx, job_t parent)
+		{
+			auto& state = g_job_system_state;
+			const u32 parent_idx = job_system__decode_idx(parent);
+			if (parent == no_job || parent_idx >= CORE_JOB_SYSTEM_MAX_JOBS)
+				return false;
+
+			auto& parent_job = state.jobs[parent_idx];
+			std::lock_guard<std::mutex> lock(parent_job.lock);
+			if (parent_job.generation != job_system__decode_generation(parent) || parent_job.unfinished == 0)
+				return false;
+
+			++parent_job.unfinished;
+			state.jobs[idx].parent = parent_idx;
+			return true;
+		}
+
+		bool job_system__add_dependent(u32 idx, job_t dependency)
+		{
+			auto& state = g_job_system_state;
+			const u32 dep_idx = job_system__decode_idx(dependency);
+			if (dependency == no_job || dep_idx >= CORE_JOB_SYSTEM_MAX_JOBS)
+				return false;
+
+			auto& dep_job = state.jobs[dep_idx];
+			{
+				std::lock_guard<std::mutex> lock(dep_job.lock);
+				if (dep_job.generation != job_system__decode_generation(dependency) || dep_job.unfinished == 0)
+					return false;
+
+				if (dep_job.num_dependents < CORE_JOB_SYSTEM_MAX_DEPENDENTS) {
+					dep_job.dependents[dep_job.num_dependents++] = idx;
+					++state.jobs[idx].pending_deps;
+					return true;
+				}
+			}
+
+			throw job_system_exception(
+				fmt::format(strings::exceptions::g_job_system_reached_dependents, dependency, CORE_JOB_SYSTEM_MAX_DEPENDENTS).c_str()
+			);
+		}
+
+		void job_system__release(u32 idx)
+		{
+			auto& job = g_job_system_state.jobs[idx];
+			if (--job.pending_deps != 0)
+				return;
+			job_system__push(idx);
+		}
+
+		void job_system__finish(u32 idx)
+		{
+			auto& job = g_job_system_state.jobs[idx];
+			u32 dependents[CORE_JOB_SYSTEM_MAX_DEPENDENTS];
+			u32 num_dependents = 0;
+			u32 parent = MAX_U32_VALUE;
+
+			{
+				// slot can be reused as soon as unfinished reaches 0,
+				// copy everything we need before leave the lock.
+				std::lock_guard<std::mutex> lock(job.lock);
+				if (--job.unfinished != 0)
+					return;
+
+				parent = job.parent;
+				num_dependents = job.num_dependents;
+				for (u32 i = 0; i < num_dependents; ++i)
+					dependents[i] = job.dependents[i];
+				job.num_dependents = 0;
+				job.parent = MAX_U32_VALUE;
+			}
+
+			for (u32 i = 0; i < num_dependents; ++i)
+				job_system__release(dependents[i]);
+
+			if (parent != MAX_U32_VALUE)
+				job_system__finish(parent);
+		}
+
+		void job_system__execute(u32 idx)
+		{
+			auto& job = g_job_system_state.jobs[idx];
+			switch (job.kind)
+			{
+			case job_kind::single:
+				if (job.callback)
+					job.callback(job.user_data);
+				break;
+			case job_kind::range:
+				if (job.range_end - job.range_begin > job.batch_size)
+					job_system__split_range(idx);
+				else
+					job.range_callback(job.range_begin, job.range_end, job.user_data);
+				break;
+			}
+
+			job_system__finish(idx);
+		}
+
+		void job_system__split_range(u32 idx)
+		{
+			auto& state = g_job_system_state;
+			auto& job = state.jobs[idx];
+			const job_t self = job_system__encode_id(idx, job.generation);
+			const u32 middle = job.range_begin + (job.range_end - job.range_begin) / 2;
+
+			const u32 ranges[][2] = {
+				{ job.range_begin, middle },
+				{ middle, job.range_end },
+			};
+
+			for (u32 i = 0; i < _countof(ranges); ++i) {
+				const u32 child_idx = job_system__alloc_job();
+				auto& child = state.jobs[child_idx];
+				child.kind = job_kind::range;
+				child.callback = null;
+				child.range_callback = job.range_callback;
+				child.user_data = job.user_data;
+				child.range_begin = ranges[i][0];
+				child.range_end = ranges[i][1];
+				child.batch_size = job.batch_size;
+				child.parent = MAX_U32_VALUE;
+
+				job_system__add_child(child_idx, self);
+				job_system__release(child_idx);
+			}
+		}
+
+		void job_system__push(u32 idx)
+		{
+			auto& state = g_job_system_state;
+			const u32 worker_idx = g_job_worker_idx;
+
+			if (worker_idx < state.num_workers) {
+				job_queue__push(state.queues[worker_idx], idx);
+			}
+			else {
+				auto& shared = state.shared_queue;
+				std::lock_guard<std::mutex> lock(shared.lock);
+				shared.items[(shared.head + shared.count) & g_job_mask] = idx;
+				++shared.count;
+			}
+
+			++state.num_queued;
+			job_system__wake();
+		}
+
+		bool job_system__pop(u32& idx)
+		{
+			auto& state = g_job_system_state;
+			const u32 worker_idx = g_job_worker_idx;
+
+			if (worker_idx < state.num_workers && job_queue__pop(state.queues[worker_idx], idx))
+				return true;
+
+			{
+				auto& shared = state.shared_queue;
+				std::lock_guard<std::mutex> lock(shared.lock);
+				if (shared.count > 0) {
+					idx = shared.items[shared.head];
+					shared.head = (shared.head + 1) & g_job_mask;
+					--shared.count;
+					return true;
+				}
+			}
+
+			// steal from other workers, starting from next worker to spread contention
+			const u32 start = worker_idx < state.num_workers ? worker_idx + 1 : 0;
+			for (u32 i = 0; i < state.num_workers; ++i) {
+				const u32 victim = (start + i) % state.num_workers;
+				if (victim == worker_idx)
+					continue;
+				if (job_queue__steal(state.queues[victim], idx))
+					return true;
+			}
+
+			return false;
+		}
+
+		bool job_system__try_execute()
+		{
+			u32 idx;
+			if (g_job_system_state.num_queued <= 0 || !job_system__pop(idx))
+				return false;
+
+			--g_job_system_state.num_queued;
+			job_system__execute(idx);
+			return true;
+		}
+
+		void job_system__wake()
+		{
+			auto& state = g_job_system_state;
+			if (state.num_sleeping == 0)
+				return;
+
+			// acquire lock to make sure sleeping worker is already waiting
+			{ std::lock_guard<std::mutex> lock(state.wake_lock); }
+			state.wake_cond.notify_one();
+		}
+
+		void job_queue__push(job_queue& queue, u32 idx)
+		{
+			const i64 bottom = queue.bottom.load(std::memory_order_relaxed);
+			queue.items[bottom & g_job_mask].store(idx, std::memory_order_relaxed);
+			queue.bottom.store(bottom + 1, std::memory_order_release);
+		}
+
+		bool job_queue__pop(job_queue& queue, u32& idx)
+		{
+			const i64 bottom = queue.bottom.load(std::memory_order_relaxed) - 1;
+			queue.bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			i64 top = queue.top.load(std::memory_order_relaxed);
+
+			if (top > bottom) {
+				queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			idx = queue.items[bottom & g_job_mask].load(std::memory_order_relaxed);
+			if (top != bottom)
+				return true;
+
+			// last item, race against thieves
+			const bool result = queue.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+			return result;
+		}
+
+		bool job_queue__steal(job_queue& queue, u32& idx)
+		{
+			i64 top = queue.top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const i64 bottom = queue.bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return false;
+
+			idx = queue.items[top & g_job_mask].load(std::memory_order_relaxed);
+			return queue.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+	}
+}
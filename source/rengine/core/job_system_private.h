@@ -0,0 +1,105 @@
+#pragma once
+#include "../base_private.h"
+#include "./job_system.h"
+
+#include "../io/logger.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+namespace rengine {
+	namespace core {
+		enum class job_kind : u8 {
+			single = 0,
+			range
+		};
+
+		struct job_entry {
+			job_callback callback{ null };
+			job_range_callback range_callback{ null };
+			ptr user_data{ null };
+			u32 range_begin{ 0 };
+			u32 range_end{ 0 };
+			u32 batch_size{ 0 };
+			u32 parent{ MAX_U32_VALUE };
+			job_kind kind{ job_kind::single };
+
+			// job itself + unfinished children. job is completed when it reaches 0
+			std::atomic<i32> unfinished{ 0 };
+			// unfinished dependencies. job is queued when it reaches 0
+			std::atomic<i32> pending_deps{ 0 };
+			std::atomic<u16> generation{ 0 };
+
+			// guards unfinished transition to 0, generation and dependents
+			std::mutex lock;
+			u32 dependents[CORE_JOB_SYSTEM_MAX_DEPENDENTS];
+			u32 num_dependents{ 0 };
+		};
+
+		/*
+		* Chase-Lev work stealing deque.
+		* Owner worker push and pop at bottom, other workers steal from top
+		*/
+		struct job_queue {
+			alignas(CORE_CACHE_LINE_SIZE) std::atomic<i64> top{ 0 };
+			alignas(CORE_CACHE_LINE_SIZE) std::atomic<i64> bottom{ 0 };
+			std::atomic<u32>* items{ null };
+		};
+
+		// shared queue used by threads that are not workers
+		struct job_shared_queue {
+			std::mutex lock;
+			u32* items{ null };
+			u32 head{ 0 };
+			u32 count{ 0 };
+		};
+
+		struct job_system_state {
+			job_entry* jobs{ null };
+			job_queue queues[CORE_JOB_SYSTEM_MAX_WORKERS];
+			job_shared_queue shared_queue;
+			std::thread workers[CORE_JOB_SYSTEM_MAX_WORKERS];
+			u32 num_workers{ 0 };
+
+			alignas(CORE_CACHE_LINE_SIZE) std::atomic<u32> next_job{ 0 };
+			alignas(CORE_CACHE_LINE_SIZE) std::atomic<i32> num_queued{ 0 };
+			std::atomic<i32> num_sleeping{ 0 };
+			std::atomic<bool> running{ false };
+			std::mutex wake_lock;
+			std::condition_variable wake_cond;
+
+			io::ILog* log{ null };
+		};
+		extern job_system_state g_job_system_state;
+		// worker index of the current thread, MAX_U32_VALUE if thread is not a worker
+		extern thread_local u32 g_job_worker_idx;
+
+		void job_system__init();
+		void job_system__deinit();
+
+		void job_system__assert_init();
+		void job_system__worker_main(u32 worker_idx);
+
+		u32 job_system__alloc_job();
+		job_t job_system__encode_id(u32 idx, u16 generation);
+		u32 job_system__decode_idx(job_t job);
+		u16 job_system__decode_generation(job_t job);
+		bool job_system__add_child(u32 idx, job_t parent);
+		bool job_system__add_dependent(u32 idx, job_t dependency);
+		void job_system__release(u32 idx);
+		void job_system__finish(u32 idx);
+		void job_system__execute(u32 idx);
+		void job_system__split_range(u32 idx);
+
+		void job_system__push(u32 idx);
+		bool job_system__pop(u32& idx);
+		bool job_system__try_execute();
+		void job_system__wake();
+
+		void job_queue__push(job_queue& queue, u32 idx);
+		bool job_queue__pop(job_queue& queue, u32& idx);
+		bool job_queue__steal(job_queue& queue, u32& idx);
+	}
+}
@@ -15,54 +15,55 @@ namespace rengine {
             T value;
         };
 
+        /*
+        * Sparse set pool.
+        * Values are packed on dense array, then iteration costs O(count)
+        * and data() can be walked as a contiguous array of count() entries.
+        * Sparse table maps slot index from id to dense index and each slot
+        * has its own generation, stale ids fails on is_valid.
+        * Erase moves the last entry into the erased place, then
+        * entries must not be erased while iterating.
+        */
         template<typename T, u32 N, typename Entity = u16, Entity InvalidId = 0xFFFFFFFF>
         class array_pool {
         public:
+            typedef pool_entry<T, Entity> entry_type;
+
             constexpr array_pool(c_str identifier = strings::g_pool_id): 
-                count_(0), 
-                magic_(0), 
-                identifier_(identifier) {
+                identifier_(identifier),
+                count_(0) {
                 for (u32 i = 0; i < N; ++i) {
-                    entries_[i].id = InvalidId;
+                    dense_[i].id = InvalidId;
+                    sparse_[i] = N;
+                    generations_[i] = 0;
                     available_idx_[(N - 1) - i] = i;
                 }
             }
             
             class Iterator {
             public:
-				Iterator() : pool_(nullptr), index_(0) {}
-				Iterator(array_pool<T, N>* pool, u32 index) : pool_(pool), index_(index) {}
-				const pool_entry<T, Entity>& operator*() {
-                    if (index_ == N)
-                        return pool_entry<T, Entity>{};
-					return pool_->entries_[index_];
+				Iterator() : entry_(nullptr) {}
+				Iterator(const entry_type* entry) : entry_(entry) {}
+				const entry_type& operator*() const {
+					return *entry_;
+				}
+				const entry_type* operator->() const {
+					return entry_;
 				}
-                const pool_entry<T, Entity>& operator*() const {
-                    if (index_ == N)
-                        return pool_entry<T, Entity>{};
-                    return pool_->entries_[index_];
-                }
 
 				Iterator& operator++() {
-                    index_ = find_next_valid_idx();
+					++entry_;
 					return *this;
 				}
 
 				bool operator!=(const Iterator& other) const {
-					return index_ != other.index_;
+					return entry_ != other.entry_;
+				}
+				bool operator==(const Iterator& other) const {
+					return entry_ == other.entry_;
 				}
             private:
-                u32 find_next_valid_idx() {
-					for (u32 i = index_ + 1; i < N; ++i) {
-                        if (pool_->entries_[i].id == InvalidId)
-                            continue;
-						return i;
-					}
-					return N;
-                }
-
-				array_pool<T, N>* pool_;
-				u16 index_;
+				const entry_type* entry_;
             };
 
             constexpr Entity push_back(const T& value) {
@@ -71,93 +72,77 @@ namespace rengine {
                         fmt::format(strings::exceptions::g_pool_is_full, N).c_str()
                     );
 
-                pool_entry<T> entry;
-                const auto idx = available_idx_[(N - count_) - 1];
-                entry.id = encode_id(idx, ++magic_);
+                const u32 idx = available_idx_[(N - count_) - 1];
+                auto& entry = dense_[count_];
+                entry.id = next_id(idx);
 				entry.value = value;
-                entries_[idx] = entry;
+                sparse_[idx] = count_;
 
                 ++count_;
                 return entry.id;
             }
 
             constexpr void erase(const Entity& id) {
-                if (empty())
-                    return;
-
-                const auto idx = decode_id(id);
-                auto& entry = entries_[idx];
                 // must remove only if the whole id matches with the current entry
-                if (entry.id != id)
+                if (!is_valid(id))
                     return;
 
-                entry.id = invalid_id;
+                const u32 idx = decode_id(id);
+                const u32 dense_idx = sparse_[idx];
+                const u32 last_idx = count_ - 1;
+
+                // keep dense array packed
+                if (dense_idx != last_idx) {
+                    dense_[dense_idx] = dense_[last_idx];
+                    sparse_[decode_id(dense_[dense_idx].id)] = dense_idx;
+                }
+
+                dense_[last_idx].id = invalid_id;
+                sparse_[idx] = N;
                 --count_;
                 available_idx_[(N - count_) - 1] = idx;
             }
 
 			constexpr void overwrite(const Entity& id, const T& value) {
-				if (!is_valid(id))
-					throw pool_exception(
-						fmt::format(strings::exceptions::g_pool_invalid_id, id).c_str()
-					);
-				const auto& idx = decode_id(id);
-				auto& entry = entries_[idx];
-				entry.value = value;
+				get_entry(id).value = value;
 			}
 
             constexpr Entity replace(const Entity& id, const T& value) {
-                if (!is_valid(id))
-                    throw pool_exception(
-                        fmt::format(strings::exceptions::g_pool_invalid_id, id).c_str()
-                    );
-
-                const auto& idx = decode_id(id);
-                auto& entry = entries_[idx];
-                entry.id = encode_id(idx, ++magic_);
+                auto& entry = get_entry(id);
+                entry.id = next_id(decode_id(id));
                 entry.value = value;
-
                 return entry.id;
             }
 
             constexpr Entity regenerate_id(const Entity& id) {
-                if (!is_valid(id))
-                    throw pool_exception(
-                        fmt::format(strings::exceptions::g_pool_invalid_id, id).c_str()
-                    );
-
-                const auto& idx = decode_id(idx);
-                auto& entry = entries_[idx];
-                entry.id = encode_id(idx, ++magic_);
+                auto& entry = get_entry(id);
+                entry.id = next_id(decode_id(id));
                 return entry.id;
             }
 
             constexpr void clear() {
-                for(u32 i = 0; i < N; ++i)
-					entries_[i].id = InvalidId;
-				count_ = magic_ = 0;
+                // generations are kept, then ids from before clear are still invalid
+                for (u32 i = 0; i < N; ++i) {
+					dense_[i].id = InvalidId;
+                    sparse_[i] = N;
+                    available_idx_[(N - 1) - i] = i;
+                }
+				count_ = 0;
             }
 
-            constexpr const pool_entry<T, Entity>* data() noexcept {
-                return entries_;
+            constexpr const entry_type* data() noexcept {
+                return dense_;
             }
-            constexpr const pool_entry<T, Entity>* data() const noexcept {
-                return entries_;
+            constexpr const entry_type* data() const noexcept {
+                return dense_;
             }
 
-            constexpr const pool_entry<T, Entity>& at(u32 idx) {
-                if (idx > count_)
+            constexpr const entry_type& at(u32 idx) const {
+                if (idx >= count_)
                     throw pool_exception(
                         fmt::format(strings::exceptions::g_pool_out_of_range, idx).c_str()
                     );
-                return &entries_[idx];
-            }
-            constexpr const pool_entry<T, Entity>& at(u32 idx) const noexcept {
-                if (idx > count_)
-                    throw pool_exception(
-                        fmt::format(strings::exceptions::g_pool_out_of_range, idx).c_str()
-                    );
-                return &entries_[idx];
+                return dense_[idx];
             }
 
             constexpr u32 count() const noexcept { return count_; }
@@ -168,77 +153,49 @@ namespace rengine {
             constexpr bool is_full() const noexcept { return count_ == N; }
             constexpr bool is_valid(const Entity& id) const noexcept {
                 const auto idx = decode_id(id);
-                if (idx >= N)
+                if (idx >= N || sparse_[idx] >= count_)
                     return false;
-
-                auto& entry = entries_[idx];
-                return entry.id == id;
+                return dense_[sparse_[idx]].id == id;
             }
 
-            constexpr Iterator begin() noexcept {
-                Iterator it;
-				find_valid_begin_iterator(&it);
-                return it;
-            }
             constexpr Iterator begin() const noexcept {
-                Iterator it;
-                find_valid_begin_iterator(&it);
-                return it;
+                return Iterator(dense_);
             }
-			constexpr const Iterator cbegin() const noexcept {
-                return Iterator(this, 0);
+			constexpr Iterator cbegin() const noexcept {
+                return Iterator(dense_);
 			}
-            constexpr const pool_entry<T, Entity>& front() {
-                return &entries_[0];
+            constexpr const entry_type& front() const {
+                return at(0);
             }
-            constexpr const pool_entry<T, Entity>& front() const {
-                return &entries_[0];
-            }
-			constexpr Iterator end() noexcept {
-                return Iterator(this, N);
-			}
-			constexpr const Iterator end() const noexcept {
-                return Iterator(this, N);
+			constexpr Iterator end() const noexcept {
+                return Iterator(dense_ + count_);
 			}
-            constexpr const Iterator cend() const noexcept {
-                return Iterator(this, N);
+            constexpr Iterator cend() const noexcept {
+                return Iterator(dense_ + count_);
             }
 
-            constexpr const pool_entry<T>& operator[](Entity id) {
-                if (!is_valid(id))
-                    throw pool_exception(
-                        fmt::format(strings::exceptions::g_pool_invalid_id, id).c_str()
-                    );
-
-                const auto& idx = decode_id(id);
-                return entries_[idx];
+            constexpr const entry_type& operator[](Entity id) const {
+                return const_cast<array_pool*>(this)->get_entry(id);
             }
-            constexpr const pool_entry<T>& operator[](Entity id) const {
+
+            static constexpr Entity invalid_id = (Entity)InvalidId;
+        private:
+            constexpr entry_type& get_entry(const Entity& id) {
                 if (!is_valid(id))
                     throw pool_exception(
                         fmt::format(strings::exceptions::g_pool_invalid_id, id).c_str()
                     );
-
-                const auto& idx = decode_id(id);
-                return entries_[idx];
+                return dense_[sparse_[decode_id(id)]];
             }
 
-            static constexpr Entity invalid_id = (Entity)InvalidId;
-        private:
-            void find_valid_begin_iterator(Iterator* it_out) {
-                if (empty()) {
-                    *it_out = end();
-                    return;
-                }
-
-                for (u32 i = 0; i < N; ++i) {
-					if (entries_[i].id == invalid_id)
-						continue;
-					*it_out = Iterator(this, i);
-                    return;
-                }
+            constexpr Entity next_id(u32 idx) {
+                Entity id = encode_id(idx, ++generations_[idx]);
+                // generation wrap can produce an id equal to invalid id
+                if (id == invalid_id)
+                    id = encode_id(idx, ++generations_[idx]);
+                return id;
             }
-            
+
             static constexpr Entity encode_id(u32 idx, u8 magic) {
 				entity_id_encoder<Entity> encoder;
 				return encoder.encode(idx, magic);
@@ -250,23 +207,288 @@ namespace rengine {
 
             c_str identifier_;
 
-            pool_entry<T, Entity> entries_[N];
-            Entity available_idx_[N];
+            entry_type dense_[N];
+            u32 sparse_[N];
+            u32 available_idx_[N];
+            u8 generations_[N];
 
             u32 count_;
-            u8 magic_;
         };
     
+        /*
+        * Growable handle pool with 32 bit ids (16 bits index + 16 bits generation).
+        * Entries lives on fixed size pages, then growing never moves existing entries
+        * and pages are kept until release() is called.
+        * Live entries are tracked on a packed index table, iteration costs O(count)
+        * and erase moves last index into the erased place, then entries must not
+        * be erased while iterating.
+        */
+        template<typename T, u32 PageSize = 64>
+        class paged_pool {
+        public:
+            typedef pool_entry<T, u32> entry_type;
+            static constexpr u32 invalid_id = MAX_U32_VALUE;
+            // last index is reserved, otherwise it could be encoded as invalid_id
+            static constexpr u32 max_items = MAX_U16_VALUE;
+
+            static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "PageSize must be power of two");
+
+            class Iterator {
+            public:
+                Iterator() : pool_(nullptr), index_(0) {}
+                Iterator(const paged_pool* pool, u32 index) : pool_(pool), index_(index) {}
+                const entry_type& operator*() const {
+                    return pool_->get_slot(pool_->dense_[index_]).entry;
+                }
+                const entry_type* operator->() const {
+                    return &pool_->get_slot(pool_->dense_[index_]).entry;
+                }
+
+                Iterator& operator++() {
+                    ++index_;
+                    return *this;
+                }
+
+                bool operator!=(const Iterator& other) const {
+                    return index_ != other.index_;
+                }
+                bool operator==(const Iterator& other) const {
+                    return index_ == other.index_;
+                }
+            private:
+                const paged_pool* pool_;
+                u32 index_;
+            };
+
+            paged_pool(c_str identifier = strings::g_pool_id, alloc_tag tag = alloc_tag::general) :
+                identifier_(identifier),
+                tag_(tag) {}
+            paged_pool(const paged_pool&) = delete;
+            paged_pool(paged_pool&& other) noexcept : paged_pool() {
+                swap(other);
+            }
+            ~paged_pool() {
+                release();
+            }
+
+            paged_pool& operator=(const paged_pool&) = delete;
+            paged_pool& operator=(paged_pool&& other) noexcept {
+                swap(other);
+                return *this;
+            }
+
+            u32 push_back(const T& value) {
+                if (num_free_ == 0)
+                    grow();
+
+                const u32 idx = free_[--num_free_];
+                auto& slot = get_slot(idx);
+                slot.entry.id = next_id(slot, idx);
+                slot.entry.value = value;
+                slot.dense_idx = count_;
+                dense_[count_] = idx;
+
+                ++count_;
+                return slot.entry.id;
+            }
+
+            void erase(u32 id) {
+                // must remove only if the whole id matches with the current entry
+                if (!is_valid(id))
+                    return;
+
+                const u32 idx = decode_id(id);
+                auto& slot = get_slot(idx);
+                const u32 last_idx = count_ - 1;
+
+                // keep index table packed
+                if (slot.dense_idx != last_idx) {
+                    const u32 moved_idx = dense_[last_idx];
+                    dense_[slot.dense_idx] = moved_idx;
+                    get_slot(moved_idx).dense_idx = slot.dense_idx;
+                }
+
+                slot.dense_idx = invalid_id;
+                slot.entry.value = T{};
+                --count_;
+                free_[num_free_++] = idx;
+            }
+
+            void overwrite(u32 id, const T& value) {
+                get_entry(id).value = value;
+            }
+
+            u32 replace(u32 id, const T& value) {
+                auto& entry = get_entry(id);
+                entry.id = next_id(get_slot(decode_id(id)), decode_id(id));
+                entry.value = value;
+                return entry.id;
+            }
+
+            u32 regenerate_id(u32 id) {
+                auto& entry = get_entry(id);
+                entry.id = next_id(get_slot(decode_id(id)), decode_id(id));
+                return entry.id;
+            }
+
+            // releases all entries but keeps pages and generations,
+            // then ids from before clear are still invalid
+            void clear() {
+                for (u32 i = 0; i < count_; ++i) {
+                    auto& slot = get_slot(dense_[i]);
+                    slot.dense_idx = invalid_id;
+                    slot.entry.value = T{};
+                }
+
+                count_ = 0;
+                num_free_ = 0;
+                for (u32 i = num_slots_; i > 0; --i)
+                    free_[num_free_++] = i - 1;
+            }
+
+            // releases all pages, this is the only operation that resets generations
+            void release() {
+                for (u32 i = 0; i < num_pages_; ++i) {
+                    for (u32 j = 0; j < PageSize; ++j)
+                        pages_[i][j].~slot_t();
+                    core::alloc_free(pages_[i]);
+                }
+
+                core::alloc_free(pages_);
+                core::alloc_free(dense_);
+                core::alloc_free(free_);
+                pages_ = null;
+                dense_ = free_ = null;
+                num_pages_ = num_slots_ = count_ = num_free_ = 0;
+            }
+
+            const entry_type& at(u32 idx) const {
+                if (idx >= count_)
+                    throw pool_exception(
+                        fmt::format(strings::exceptions::g_pool_out_of_range, idx).c_str()
+                    );
+                return get_slot(dense_[idx]).entry;
+            }
+
+            u32 count() const noexcept { return count_; }
+            u32 size() const noexcept { return num_slots_; }
+            u32 max_size() const noexcept { return max_items; }
+            u32 num_pages() const noexcept { return num_pages_; }
+            c_str identifier() const noexcept { return identifier_; }
+
+            bool empty() const noexcept { return count_ == 0u; }
+            bool is_full() const noexcept { return count_ == max_items; }
+            bool is_valid(u32 id) const noexcept {
+                const u32 idx = decode_id(id);
+                if (idx >= num_slots_)
+                    return false;
+
+                const auto& slot = get_slot(idx);
+                return slot.dense_idx != invalid_id && slot.entry.id == id;
+            }
+
+            Iterator begin() const noexcept { return Iterator(this, 0); }
+            Iterator cbegin() const noexcept { return Iterator(this, 0); }
+            Iterator end() const noexcept { return Iterator(this, count_); }
+            Iterator cend() const noexcept { return Iterator(this, count_); }
+
+            const entry_type& operator[](u32 id) const {
+                return const_cast<paged_pool*>(this)->get_entry(id);
+            }
+        private:
+            struct slot_t {
+                entry_type entry{};
+                u32 dense_idx{ invalid_id };
+                u16 generation{ 0 };
+            };
+
+            slot_t& get_slot(u32 idx) const {
+                return pages_[idx / PageSize][idx & (PageSize - 1)];
+            }
+
+            entry_type& get_entry(u32 id) {
+                if (!is_valid(id))
+                    throw pool_exception(
+                        fmt::format(strings::exceptions::g_pool_invalid_id, id).c_str()
+                    );
+                return get_slot(decode_id(id)).entry;
+            }
+
+            void grow() {
+                if (num_slots_ >= max_items)
+                    throw pool_exception(
+                        fmt::format(strings::exceptions::g_pool_is_full, max_items).c_str()
+                    );
+
+                const u32 capacity = (num_pages_ + 1) * PageSize;
+                pages_ = (slot_t**)core::alloc_realloc(pages_, sizeof(slot_t*) * (num_pages_ + 1));
+                dense_ = (u32*)core::alloc_realloc(dense_, sizeof(u32) * capacity);
+                free_ = (u32*)core::alloc_realloc(free_, sizeof(u32) * capacity);
+
+                slot_t* page = alignof(slot_t) > CORE_ALLOC_DEFAULT_ALIGNMENT
+                    ? (slot_t*)core::alloc_aligned(sizeof(slot_t) * PageSize, alignof(slot_t), tag_)
+                    : (slot_t*)core::alloc(sizeof(slot_t) * PageSize, tag_);
+                for (u32 i = 0; i < PageSize; ++i)
+                    new (page + i) slot_t();
+                pages_[num_pages_++] = page;
+
+                // push on reverse order, lower indices are used first
+                const u32 first_slot = num_slots_;
+                num_slots_ = capacity > max_items ? max_items : capacity;
+                for (u32 i = num_slots_; i > first_slot; --i)
+                    free_[num_free_++] = i - 1;
+            }
+
+            static u32 next_id(slot_t& slot, u32 idx) {
+                // generation 0 is never used, then id 0 is never a valid id
+                if (++slot.generation == 0)
+                    ++slot.generation;
+                return encode_id(idx, slot.generation);
+            }
+
+            void swap(paged_pool& other) noexcept {
+                std::swap(identifier_, other.identifier_);
+                std::swap(tag_, other.tag_);
+                std::swap(pages_, other.pages_);
+                std::swap(dense_, other.dense_);
+                std::swap(free_, other.free_);
+                std::swap(num_pages_, other.num_pages_);
+                std::swap(num_slots_, other.num_slots_);
+                std::swap(count_, other.count_);
+                std::swap(num_free_, other.num_free_);
+            }
+
+            static constexpr u32 encode_id(u32 idx, u16 generation) {
+                entity_id_encoder<u32> encoder;
+                return encoder.encode(idx, generation);
+            }
+            static constexpr u32 decode_id(u32 id) {
+                entity_id_encoder<u32> encoder;
+                return encoder.decode(id);
+            }
+
+            c_str identifier_;
+            alloc_tag tag_;
+
+            slot_t** pages_{ null };
+            // packed slot indices of live entries
+            u32* dense_{ null };
+            u32* free_{ null };
+            u32 num_pages_{ 0 };
+            u32 num_slots_{ 0 };
+            u32 count_{ 0 };
+            u32 num_free_{ 0 };
+        };
+
+        // single threaded FIFO ring, see ring_queue.h for cross thread queues
         template<typename T, u32 N, typename Size = u32>
         class fixed_queue {
         public:
-            constexpr fixed_queue(): count_(0) {}
+            constexpr fixed_queue(): count_(0), curr_(0) {}
 			constexpr void push(const T& value) {
                 if (is_full())
                     return;
-                Size idx = curr_ > 0 ? --curr_ : count_;
-				entries_[idx] = value;
-
+				entries_[(curr_ + count_) % N] = value;
                 count_++;
 			}
 
@@ -274,7 +496,7 @@ namespace rengine {
                 if (empty())
                     return;
 				count_--;
-                curr_++;
+                curr_ = (curr_ + 1) % N;
             }
 
             constexpr void clear() {
@@ -306,7 +528,7 @@ namespace rengine {
 					throw pool_exception(
 						strings::exceptions::g_queue_empty
 					);
-				return entries_[count_ - 1];
+				return entries_[(curr_ + count_ - 1) % N];
             }
         private:
 			T entries_[N];
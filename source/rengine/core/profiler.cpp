@@ -1,9 +1,10 @@
 #include "profiler.h"
 #include "./profiler_private.h"
+#include "./profiler_trace_private.h"
 
 namespace rengine {
 	namespace core {
-		void profiler_entry_push(profiler_entry_info* entry)
+		void profiler_entry_push(const profiler_entry_info* entry)
 		{
 			profiler__entry_push(entry);
 		}
@@ -13,6 +14,11 @@ namespace rengine {
 			profiler__entry_pop();
 		}
 
+		void profiler_set_thread_name(c_str name)
+		{
+			profiler__set_thread_name(name);
+		}
+
 		void profiler_log(c_str str)
 		{
 			profiler__log(str);
@@ -20,7 +26,39 @@ namespace rengine {
 
 		bool profiler_connected()
 		{
-			return g_profiler_state.connected;
+#if ENGINE_PROFILER
+			return g_profiler_state.connected.load(std::memory_order_relaxed);
+#else
+			return false;
+#endif
+		}
+
+		void profiler_capture_begin()
+		{
+			profiler_trace__begin();
+		}
+
+		void profiler_capture_end(c_str path, profiler_capture_format format)
+		{
+			profiler_trace_capture capture;
+			profiler_trace__end(capture);
+
+			if (format == profiler_capture_format::binary)
+				profiler_trace__write_binary(capture, path);
+			else
+				profiler_trace__write_json(capture, path);
+		}
+
+		bool profiler_capturing()
+		{
+			return profiler_trace__recording();
+		}
+
+		void profiler_capture_convert(c_str binary_path, c_str json_path)
+		{
+			profiler_trace_capture capture;
+			profiler_trace__read_binary(capture, binary_path);
+			profiler_trace__write_json(capture, json_path);
 		}
 	}
 }
@@ -1,8 +1,10 @@
 #pragma once
+#include <rengine/api.h>
 #include <rengine/types.h>
 
 namespace rengine {
 	namespace core {
+		// layout must match tracy source location, entries are sent to tracy as is
 		struct profiler_entry_info {
 			c_str name{ null };
 			c_str function{ null };
@@ -11,10 +13,31 @@ namespace rengine {
 			u32 padding{ 0 };
 		};
 
-		void profiler_entry_push(profiler_entry_info* entry);
-		void profiler_entry_pop();
-		void profiler_log(c_str str);
-		bool profiler_connected();
+		enum class profiler_capture_format : u8 {
+			// chrome trace event format, can be opened on chrome://tracing or perfetto
+			json = 0,
+			// compact dump, use trace_converter tool to convert it to json
+			binary
+		};
+
+		// entry must live until program exits, profile macros declare it as static
+		R_EXPORT void profiler_entry_push(const profiler_entry_info* entry);
+		R_EXPORT void profiler_entry_pop();
+		// names current thread on profiler, zones are recorded per thread
+		R_EXPORT void profiler_set_thread_name(c_str name);
+		R_EXPORT void profiler_log(c_str str);
+		R_EXPORT bool profiler_connected();
+
+		/*
+		* Offline capture, records zones, frames and allocations of all threads
+		* without a tracy client connected. Each thread keeps only its last
+		* CORE_PROFILER_TRACE_EVENTS events, older events are overwritten.
+		*/
+		R_EXPORT void profiler_capture_begin();
+		R_EXPORT void profiler_capture_end(c_str path, profiler_capture_format format = profiler_capture_format::json);
+		R_EXPORT bool profiler_capturing();
+		// converts a binary capture to json
+		R_EXPORT void profiler_capture_convert(c_str binary_path, c_str json_path);
 		
 		struct profiler_scope {
 			~profiler_scope() {
@@ -26,8 +49,9 @@ namespace rengine {
 #define profiler__concat(x, y) profiler__concat_indirect(x, y)
 #define profiler__line __LINE__
 #define profiler__entry_def(line) profiler__concat(___profiler_entry, line)
+// name must be a static string, entry is initialized only once
 #define profiler__entry(name, line) \
-	rengine::core::profiler_entry_info profiler__entry_def(line) = {\
+	static const rengine::core::profiler_entry_info profiler__entry_def(line) = {\
 		name, __func__, __FILE__, line, 0 \
 	};
 #define profile_begin() \
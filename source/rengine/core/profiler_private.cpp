@@ -1,44 +1,47 @@
 #include "profiler_private.h"
+#include "./profiler_trace_private.h"
 #include "./allocator.h"
 #include "../exceptions.h"
 
+#include <fmt/format.h>
+
 namespace rengine {
 	namespace core {
 		profiler_state g_profiler_state = {};
+#if ENGINE_PROFILER
+		thread_local profiler_thread_state g_profiler_thread_state = {};
+
+		profiler_thread_state::~profiler_thread_state()
+		{
+			while (first) {
+				auto* next = first->next;
+				core::alloc_free(first);
+				first = next;
+			}
+			curr = null;
+		}
+#endif
 
 		void profiler__init()
 		{
 #if ENGINE_PROFILER
 			___tracy_startup_profiler();
 			TracySetProgramName(nameof(rengine));
+			profiler__set_thread_name(strings::profiler::main_thread);
 
-			auto& state = g_profiler_state;
-			state.malloc_call = profiler__alloc_direct;
-			state.free_call = profiler__free_direct;
-
-			// digest memory allocations
-			auto mem_info = g_profiler_state.delayed_mem_alloc.begin;
-			while (mem_info != null) {
-				if (mem_info->op == profiler_mem_op::alloc)
-					TracyAlloc(mem_info->mem, mem_info->size);
-				else
-					TracyFree(mem_info->mem);
-
-				auto curr_mem_info = mem_info;
-				mem_info = mem_info->next;
-				free(curr_mem_info);
-			}
+			profiler__replay_mem_events();
 #endif
 		}
 
 		void profiler__deinit()
 		{
+			profiler_trace__deinit();
 #if ENGINE_PROFILER
 			___tracy_shutdown_profiler();
 
 			auto& state = g_profiler_state;
-			state.malloc_call = profiler__alloc_stub;
-			state.free_call = profiler__free_stub;
+			state.malloc_call.store(profiler__alloc_stub, std::memory_order_release);
+			state.free_call.store(profiler__free_stub, std::memory_order_release);
 #endif
 		}
 
@@ -60,76 +63,57 @@ namespace rengine {
 #endif
 		}
 
-		void profiler__alloc(ptr mem, size_t size)
+		void profiler__alloc(ptr mem, size_t size, c_str pool_name)
 		{
+			profiler_trace__alloc(mem, size, pool_name);
 #if ENGINE_PROFILER
-			auto& state = g_profiler_state;
-			state.malloc_call(mem, size);
+			g_profiler_state.malloc_call.load(std::memory_order_acquire)(mem, size, pool_name);
 #endif
 		}
 
-		void profiler__free(ptr mem)
+		void profiler__free(ptr mem, c_str pool_name)
 		{
+			profiler_trace__free(mem, pool_name);
 #if ENGINE_PROFILER
-			auto& state = g_profiler_state;
-			state.free_call(mem);
+			g_profiler_state.free_call.load(std::memory_order_acquire)(mem, pool_name);
 #endif
 		}
 
 #if ENGINE_PROFILER
-		void profiler__alloc_direct(ptr mem, size_t size)
+		void profiler__alloc_direct(ptr mem, size_t size, c_str pool_name)
 		{
-			TracyAlloc(mem, size);
+			if (pool_name)
+				TracyAllocN(mem, size, pool_name);
+			else
+				TracyAlloc(mem, size);
 		}
 
-		void profiler__free_direct(ptr mem)
+		void profiler__free_direct(ptr mem, c_str pool_name)
 		{
-			TracyFree(mem);
+			if (pool_name)
+				TracyFreeN(mem, pool_name);
+			else
+				TracyFree(mem);
 		}
 
-		void profiler__alloc_delayed(ptr mem, size_t size)
+		void profiler__alloc_delayed(ptr mem, size_t size, c_str pool_name)
 		{
-			auto& delayed_mem_alloc = g_profiler_state.delayed_mem_alloc;
-			
-			// Allocation occurs before app start, so 'new' operator is called
-			// even before allocator initialization, for this reason we will use malloc instead
-			// to allocate our linked list
-			profiler_mem_alloc_info* node = (profiler_mem_alloc_info*)malloc(sizeof(profiler_mem_alloc_info));
-			*node = profiler_mem_alloc_info{};
-			node->mem = mem;
-			node->size = size;
-			node->op = profiler_mem_op::alloc;
-
-			if (delayed_mem_alloc.begin == null)
-				delayed_mem_alloc.begin = node;
-
-			if (delayed_mem_alloc.end != null)
-				delayed_mem_alloc.end->next = node;
-			delayed_mem_alloc.end = node;
+			if (!profiler__push_mem_event({ mem, size, pool_name, profiler_mem_op::alloc }))
+				g_profiler_state.malloc_call.load(std::memory_order_acquire)(mem, size, pool_name);
 		}
 
-		void profiler__free_delayed(ptr mem)
+		void profiler__free_delayed(ptr mem, c_str pool_name)
 		{
-			profiler_mem_alloc_info* node = (profiler_mem_alloc_info*)malloc(sizeof(profiler_mem_alloc_info));
-			*node = profiler_mem_alloc_info{};
-			node->mem = mem;
-			node->op = profiler_mem_op::free;
-
-			auto& delayed_mem_alloc = g_profiler_state.delayed_mem_alloc;
-
-			if (delayed_mem_alloc.begin == null)
-				delayed_mem_alloc.begin = node;
-
-			if (delayed_mem_alloc.end != null)
-				delayed_mem_alloc.end->next = node;
+			if (!profiler__push_mem_event({ mem, 0, pool_name, profiler_mem_op::free }))
+				g_profiler_state.free_call.load(std::memory_order_acquire)(mem, pool_name);
 		}
 
-		void profiler__alloc_stub(ptr mem, size_t size)
+		void profiler__alloc_stub(ptr mem, size_t size, c_str pool_name)
 		{
 			// noop
 		}
 
-		void profiler__free_stub(ptr mem)
+		void profiler__free_stub(ptr mem, c_str pool_name)
 		{
 			// noop
 		}
@@ -137,58 +121,54 @@ namespace rengine {
 		
 		void profiler__begin_frame()
 		{
+			profiler_trace__frame_begin();
 #if ENGINE_PROFILER
 			auto& state = g_profiler_state;
-			state.connected = tracy::GetProfiler().IsConnected();
-			state.zones.reset_lose_memory();
-			state.entries.reset_lose_memory();
-			state.curr_zone = MAX_U32_VALUE;
+			state.connected.store(tracy::GetProfiler().IsConnected(), std::memory_order_relaxed);
 			FrameMarkStart(strings::profiler::engine_loop);
 #endif
 		}
 
 		void profiler__end_frame()
 		{
+			profiler_trace__frame_end();
 #if ENGINE_PROFILER
 			FrameMarkEnd(strings::profiler::engine_loop);
 #endif
 		}
 
-		void profiler__entry_push(profiler_entry_info* entry)
+		void profiler__entry_push(const profiler_entry_info* entry)
 		{
+			// offline capture doesn't depend on tracy connection
+			profiler_trace__zone_begin(entry);
 #if ENGINE_PROFILER
-			auto& state = g_profiler_state;
-			// we must skip if profiler isn't connected
-			if (!state.connected)
+			auto& thread_state = g_profiler_thread_state;
+			// zone is pushed even if profiler isn't connected,
+			// then pop always matches with this push
+			auto* zone = profiler__push_zone(thread_state);
+			zone->active = g_profiler_state.connected.load(std::memory_order_relaxed);
+			if (!zone->active)
 				return;
 
-#if ENGINE_DEBUG
-			if (state.zones.size() == CORE_MAX_PROFILER_ENTRIES)
-				throw profiler_exception(strings::exceptions::g_profiler_reached_entries);
-#endif
+			if (thread_state.name_pending)
+				profiler__apply_thread_name(thread_state);
+
 			// time must get before zone insertion logic
 			// this will give more precise time
 			u64 time = tracy::Profiler::GetTime();
+			zone->id = tracy::GetProfiler().GetNextZoneId();
 
-			auto& zones = state.zones;
-			auto& zone = zones.push_back();
-			zone.id = tracy::GetProfiler().GetNextZoneId();
-			zone.prev_idx = state.curr_zone;
-			state.curr_zone = state.entries.size();
-
-			state.entries.push_back(*entry);
-
-			// commit our profile data to tracy
+			// commit our profile data to tracy, queue is owned by the calling thread
 			{
 				TracyQueuePrepareC(tracy::QueueType::ZoneValidation);
-				item->zoneValidation.id = zone.id;
+				item->zoneValidation.id = zone->id;
 				TracyQueueCommitC(zoneValidationThread);
 			}
 
 			{
 				TracyQueuePrepareC(tracy::QueueType::ZoneBegin);
 				item->zoneBegin.time = time;
-				item->zoneBegin.srcloc = (uint64_t)&state.entries.back();
+				item->zoneBegin.srcloc = (uint64_t)entry;
 				TracyQueueCommitC(zoneBeginThread);
 			}
 #endif
@@ -196,19 +176,16 @@ namespace rengine {
 
 		void profiler__entry_pop()
 		{
+			profiler_trace__zone_end();
 #if ENGINE_PROFILER
-			auto& state = g_profiler_state;
-			// we must skip if profiler isn't connected
-			if (!state.connected || state.curr_zone == MAX_U32_VALUE)
+			auto* zone = profiler__pop_zone(g_profiler_thread_state);
+			if (!zone || !zone->active)
 				return;
 
-			auto& zone = state.zones[state.curr_zone];
-			state.curr_zone = zone.prev_idx;
-
 			// commit our profile data to tracy
 			{
 				TracyQueuePrepareC(tracy::QueueType::ZoneValidation);
-				item->zoneValidation.id = zone.id;
+				item->zoneValidation.id = zone->id;
 				TracyQueueCommitC(zoneValidationThread);
 			}
 
@@ -220,11 +197,148 @@ namespace rengine {
 #endif
 		}
 
+		void profiler__set_thread_name(c_str name)
+		{
+			profiler_trace__set_thread_name(name);
+#if ENGINE_PROFILER
+			if (!name)
+				return;
+
+			auto& thread_state = g_profiler_thread_state;
+			const size_t len = strlen(name);
+			const size_t copy_len = len < CORE_PROFILER_THREAD_NAME_SIZE - 1 ? len : CORE_PROFILER_THREAD_NAME_SIZE - 1;
+			memcpy(thread_state.name, name, copy_len);
+			thread_state.name[copy_len] = '\0';
+			thread_state.name_pending = true;
+
+			if (profiler__started())
+				profiler__apply_thread_name(thread_state);
+#endif
+		}
+
 		void profiler__log(c_str str)
 		{
 #if ENGINE_PROFILER
 			TracyMessage(str, strlen(str));
 #endif
 		}
+
+		void profiler__plot(c_str name, i64 value)
+		{
+#if ENGINE_PROFILER
+			TracyPlot(name, (int64_t)value);
+#endif
+		}
+
+#if ENGINE_PROFILER
+		bool profiler__push_mem_event(const profiler_mem_event& event)
+		{
+			auto& log = g_profiler_state.delayed_mem_log;
+			std::lock_guard<std::mutex> lock(log.lock);
+			if (log.replayed)
+				return false;
+
+			auto* chunk = log.curr ? log.curr : &log.first;
+			if (chunk->count == CORE_PROFILER_DELAYED_CHUNK_SIZE) {
+				if (log.num_chunks == CORE_PROFILER_DELAYED_MAX_CHUNKS) {
+					++log.num_dropped;
+					return true;
+				}
+
+				// Allocation occurs before app start, so engine allocator can't be used here
+				auto* next_chunk = (profiler_mem_chunk*)malloc(sizeof(profiler_mem_chunk));
+				next_chunk->next = null;
+				next_chunk->count = 0;
+				chunk->next = next_chunk;
+				log.curr = chunk = next_chunk;
+				++log.num_chunks;
+			}
+
+			chunk->events[chunk->count++] = event;
+			return true;
+		}
+
+		void profiler__replay_mem_events()
+		{
+			auto& state = g_profiler_state;
+			auto& log = state.delayed_mem_log;
+			std::lock_guard<std::mutex> lock(log.lock);
+
+			// with dropped events, frees could reach tracy without their allocs,
+			// then memory tracking is disabled for this session
+			const bool discard = log.num_dropped > 0;
+			if (discard) {
+				const auto msg = fmt::format(strings::logs::g_profiler_mem_events_dropped, log.num_dropped);
+				TracyMessage(msg.c_str(), msg.size());
+			}
+
+			// threads that still sees delayed calls are redirected by replayed flag
+			state.malloc_call.store(discard ? profiler__alloc_stub : profiler__alloc_direct, std::memory_order_release);
+			state.free_call.store(discard ? profiler__free_stub : profiler__free_direct, std::memory_order_release);
+			log.replayed = true;
+
+			auto* chunk = &log.first;
+			while (chunk) {
+				for (u32 i = 0; i < chunk->count && !discard; ++i) {
+					const auto& event = chunk->events[i];
+					if (event.op == profiler_mem_op::alloc)
+						profiler__alloc_direct(event.mem, event.size, event.pool_name);
+					else
+						profiler__free_direct(event.mem, event.pool_name);
+				}
+
+				auto* next = chunk->next;
+				if (chunk != &log.first)
+					free(chunk);
+				chunk = next;
+			}
+
+			log.first.next = null;
+			log.first.count = 0;
+			log.curr = null;
+			log.num_chunks = 1;
+		}
+
+		profiler_zone_entry* profiler__push_zone(profiler_thread_state& thread_state)
+		{
+			auto* page = thread_state.curr;
+			if (!page || page->count == CORE_PROFILER_ZONE_PAGE_SIZE) {
+				auto* next_page = page ? page->next : thread_state.first;
+				if (!next_page) {
+					next_page = (profiler_zone_page*)core::alloc(sizeof(profiler_zone_page), alloc_tag::profiler);
+					next_page->prev = page;
+					next_page->next = null;
+					if (page)
+						page->next = next_page;
+					else
+						thread_state.first = next_page;
+				}
+
+				next_page->count = 0;
+				thread_state.curr = page = next_page;
+			}
+
+			return &page->zones[page->count++];
+		}
+
+		profiler_zone_entry* profiler__pop_zone(profiler_thread_state& thread_state)
+		{
+			auto* page = thread_state.curr;
+			if (page && page->count == 0 && page->prev)
+				thread_state.curr = page = page->prev;
+
+			// unbalanced pop
+			if (!page || page->count == 0)
+				return null;
+
+			return &page->zones[--page->count];
+		}
+
+		void profiler__apply_thread_name(profiler_thread_state& thread_state)
+		{
+			TracyCSetThreadName(thread_state.name);
+			thread_state.name_pending = false;
+		}
+#endif
 	}
 }
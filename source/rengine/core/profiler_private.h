@@ -2,6 +2,9 @@
 #include "../base_private.h"
 #include "./profiler.h"
 
+#include <atomic>
+#include <mutex>
+
 #if ENGINE_PROFILER
 	#include <tracy/Tracy.hpp>
 	#include <tracy/TracyC.h>
@@ -13,43 +16,82 @@ namespace rengine {
 			alloc = 0,
 			free = 1
 		};
-		typedef void (*profiler_alloc_fn)(ptr mem, size_t size);
-		typedef void (*profiler_free_fn)(ptr mem);
+		// pool_name must be a static string, null goes to default pool
+		typedef void (*profiler_alloc_fn)(ptr mem, size_t size, c_str pool_name);
+		typedef void (*profiler_free_fn)(ptr mem, c_str pool_name);
 
 #if ENGINE_PROFILER
-		void profiler__alloc_direct(ptr mem, size_t size);
-		void profiler__free_direct(ptr mem);
-		void profiler__alloc_delayed(ptr mem, size_t size);
-		void profiler__free_delayed(ptr mem);
-		void profiler__alloc_stub(ptr mem, size_t size);
-		void profiler__free_stub(ptr mem);
+		void profiler__alloc_direct(ptr mem, size_t size, c_str pool_name);
+		void profiler__free_direct(ptr mem, c_str pool_name);
+		void profiler__alloc_delayed(ptr mem, size_t size, c_str pool_name);
+		void profiler__free_delayed(ptr mem, c_str pool_name);
+		void profiler__alloc_stub(ptr mem, size_t size, c_str pool_name);
+		void profiler__free_stub(ptr mem, c_str pool_name);
 #endif
 
 #if ENGINE_PROFILER
 		struct profiler_zone_entry {
 			u32 id;
-			u32 prev_idx;
+			// zone is only sent when profiler is connected, end must match begin
+			bool active;
+		};
+
+		struct profiler_zone_page {
+			profiler_zone_page* prev;
+			profiler_zone_page* next;
+			u32 count;
+			profiler_zone_entry zones[CORE_PROFILER_ZONE_PAGE_SIZE];
+		};
+
+		/*
+		* Each thread has its own zone stack, zones are stored on
+		* linked pages that are kept for reuse until thread exits.
+		*/
+		struct profiler_thread_state {
+			profiler_zone_page* first{ null };
+			profiler_zone_page* curr{ null };
+			char name[CORE_PROFILER_THREAD_NAME_SIZE]{};
+			// name is applied when profiler starts
+			bool name_pending{ false };
+
+			~profiler_thread_state();
 		};
+		extern thread_local profiler_thread_state g_profiler_thread_state;
 
-		struct profiler_mem_alloc_info {
+		struct profiler_mem_event {
 			ptr mem;
 			size_t size;
+			c_str pool_name;
 			profiler_mem_op op;
-			profiler_mem_alloc_info* next;
 		};
 
-		struct profiler_mem_alloc_link {
-			profiler_mem_alloc_info* begin{ null };
-			profiler_mem_alloc_info* end{ null };
+		struct profiler_mem_chunk {
+			profiler_mem_chunk* next;
+			u32 count;
+			profiler_mem_event events[CORE_PROFILER_DELAYED_CHUNK_SIZE];
 		};
+
+		/*
+		* Memory events recorded before tracy starts, they're replayed by profiler__init.
+		* First chunk is static, extra chunks are allocated by malloc because engine
+		* allocator is the one being tracked. When log is full, events are dropped
+		* and memory tracking is disabled, tracy requires allocs and frees to be paired.
+		*/
+		struct profiler_mem_log {
+			std::mutex lock;
+			profiler_mem_chunk first{};
+			profiler_mem_chunk* curr{ null };
+			u32 num_chunks{ 1 };
+			u64 num_dropped{ 0 };
+			// set after replay, late events must go direct to tracy
+			bool replayed{ false };
+		};
+
 		struct profiler_state {
-			fixed_vector<profiler_entry_info, CORE_MAX_PROFILER_ENTRIES> entries;
-			fixed_vector<profiler_zone_entry, CORE_MAX_PROFILER_ENTRIES> zones;
-			u32 curr_zone { MAX_U32_VALUE };
-			profiler_mem_alloc_link delayed_mem_alloc;
-			profiler_alloc_fn malloc_call{ profiler__alloc_delayed };
-			profiler_free_fn free_call{ profiler__free_delayed };
-			bool connected{ false };
+			profiler_mem_log delayed_mem_log;
+			std::atomic<profiler_alloc_fn> malloc_call{ profiler__alloc_delayed };
+			std::atomic<profiler_free_fn> free_call{ profiler__free_delayed };
+			std::atomic<bool> connected{ false };
 		};
 		extern profiler_state g_profiler_state;
 #endif
@@ -60,14 +102,28 @@ namespace rengine {
 		bool profiler__enabled();
 		bool profiler__started();
 
-		void profiler__alloc(ptr mem, size_t size);
-		void profiler__free(ptr mem);
+		void profiler__alloc(ptr mem, size_t size, c_str pool_name = null);
+		void profiler__free(ptr mem, c_str pool_name = null);
 
 
 		void profiler__begin_frame();
 		void profiler__end_frame();
-		void profiler__entry_push(profiler_entry_info* entry);
+		// entry is used as tracy source location, it must live until program exits
+		void profiler__entry_push(const profiler_entry_info* entry);
 		void profiler__entry_pop();
+		// name is copied, thread name is applied when profiler starts
+		void profiler__set_thread_name(c_str name);
 		void profiler__log(c_str str);
+		// name must be a static string
+		void profiler__plot(c_str name, i64 value);
+
+#if ENGINE_PROFILER
+		// returns false if log has replayed, then event must be sent directly
+		bool profiler__push_mem_event(const profiler_mem_event& event);
+		void profiler__replay_mem_events();
+		profiler_zone_entry* profiler__push_zone(profiler_thread_state& thread_state);
+		profiler_zone_entry* profiler__pop_zone(profiler_thread_state& thread_state);
+		void profiler__apply_thread_name(profiler_thread_state& thread_state);
+#endif
 	}
 }
\ No newline at end of file
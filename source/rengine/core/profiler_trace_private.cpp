@@ -0,0 +1,455 @@
+#include "./profiler_trace_private.h"
+#include "./allocator.h"
+#include "../exceptions.h"
+
+#include <EASTL/sort.h>
+#include <chrono>
+#include <fstream>
+#include <fmt/format.h>
+
+namespace rengine {
+	namespace core {
+		profiler_trace_state g_profiler_trace_state = {};
+		thread_local profiler_trace_thread g_profiler_trace_thread = {};
+		// trivially destructible, then it can be checked while other thread locals are being destroyed
+		static thread_local bool g_profiler_trace_thread_destroyed = false;
+
+		static constexpr u64 g_profiler_trace_mask = CORE_PROFILER_TRACE_EVENTS - 1;
+
+		profiler_trace_thread::~profiler_trace_thread()
+		{
+			// buffer may still have events of a running capture, it's released after capture ends
+			g_profiler_trace_thread_destroyed = true;
+			if (buffer)
+				buffer->exited.store(true, std::memory_order_release);
+			buffer = null;
+		}
+
+		void profiler_trace__deinit()
+		{
+			auto& state = g_profiler_trace_state;
+			state.recording.store(false, std::memory_order_release);
+
+			std::lock_guard<std::mutex> lock(state.lock);
+			auto* buffer = state.buffers;
+			while (buffer) {
+				auto* next = buffer->next;
+				core::alloc_free(buffer->events);
+				buffer->~profiler_trace_buffer();
+				core::alloc_free(buffer);
+				buffer = next;
+			}
+			state.buffers = null;
+			g_profiler_trace_thread.buffer = null;
+		}
+
+		void profiler_trace__begin()
+		{
+			auto& state = g_profiler_trace_state;
+			if (state.recording.load(std::memory_order_acquire))
+				throw profiler_exception(strings::exceptions::g_profiler_capture_in_progress);
+
+			state.start_time = profiler_trace__get_time();
+			// threads resets their own buffers when they see a new generation
+			state.generation.fetch_add(1, std::memory_order_relaxed);
+			state.recording.store(true, std::memory_order_release);
+		}
+
+		void profiler_trace__end(profiler_trace_capture& capture)
+		{
+			auto& state = g_profiler_trace_state;
+			if (!state.recording.exchange(false, std::memory_order_acq_rel))
+				throw profiler_exception(strings::exceptions::g_profiler_capture_not_started);
+
+			const u32 generation = state.generation.load(std::memory_order_relaxed);
+			std::lock_guard<std::mutex> lock(state.lock);
+
+			auto* buffer = state.buffers;
+			while (buffer) {
+				// generation is read first, its release store is done after head reset
+				const u32 buffer_generation = buffer->generation.load(std::memory_order_acquire);
+				const u64 head = buffer->head.load(std::memory_order_acquire);
+				if (buffer_generation != generation || head == 0) {
+					buffer = buffer->next;
+					continue;
+				}
+
+				// owner thread may be writing a single event after recording stops,
+				// oldest slot is skipped when ring has wrapped
+				const u64 begin = head > CORE_PROFILER_TRACE_EVENTS ? head - CORE_PROFILER_TRACE_EVENTS + 1 : 0;
+				auto& thread = capture.threads.push_back();
+				thread.id = buffer->thread_id;
+				thread.name_idx = buffer->name[0] == '\0' ? MAX_U32_VALUE : profiler_trace__get_string_idx(capture, buffer->name);
+				thread.events.reserve((size_t)(head - begin));
+
+				for (u64 i = begin; i < head; ++i) {
+					const auto& event = buffer->events[i & g_profiler_trace_mask];
+					auto& file_event = thread.events.push_back();
+					file_event = {};
+					file_event.time = event.time > state.start_time ? event.time - state.start_time : 0;
+					file_event.value = event.value;
+					file_event.type = event.type;
+					file_event.name_idx = MAX_U32_VALUE;
+					file_event.file_idx = MAX_U32_VALUE;
+
+					switch (event.type) {
+					case profiler_trace_event_type::zone_begin:
+					{
+						const auto* entry = (const profiler_entry_info*)event.data;
+						file_event.name_idx = profiler_trace__get_string_idx(capture, entry->name ? entry->name : entry->function);
+						file_event.file_idx = profiler_trace__get_string_idx(capture, entry->file);
+						file_event.line = entry->line;
+					}
+						break;
+					case profiler_trace_event_type::alloc:
+					case profiler_trace_event_type::free:
+						file_event.address = (u64)(uintptr_t)event.data;
+						file_event.name_idx = profiler_trace__get_string_idx(capture, event.name);
+						break;
+					default:
+						break;
+					}
+				}
+
+				buffer = buffer->next;
+			}
+
+			profiler_trace__free_exited_buffers();
+		}
+
+		bool profiler_trace__recording()
+		{
+			return g_profiler_trace_state.recording.load(std::memory_order_relaxed);
+		}
+
+		void profiler_trace__zone_begin(const profiler_entry_info* entry)
+		{
+			if (profiler_trace__recording())
+				profiler_trace__record(profiler_trace_event_type::zone_begin, entry, null, 0);
+		}
+
+		void profiler_trace__zone_end()
+		{
+			if (profiler_trace__recording())
+				profiler_trace__record(profiler_trace_event_type::zone_end, null, null, 0);
+		}
+
+		void profiler_trace__frame_begin()
+		{
+			if (profiler_trace__recording())
+				profiler_trace__record(profiler_trace_event_type::frame_begin, null, null, 0);
+		}
+
+		void profiler_trace__frame_end()
+		{
+			if (profiler_trace__recording())
+				profiler_trace__record(profiler_trace_event_type::frame_end, null, null, 0);
+		}
+
+		void profiler_trace__alloc(ptr mem, size_t size, c_str pool_name)
+		{
+			if (profiler_trace__recording())
+				profiler_trace__record(profiler_trace_event_type::alloc, mem, pool_name, size);
+		}
+
+		void profiler_trace__free(ptr mem, c_str pool_name)
+		{
+			if (profiler_trace__recording())
+				profiler_trace__record(profiler_trace_event_type::free, mem, pool_name, 0);
+		}
+
+		void profiler_trace__set_thread_name(c_str name)
+		{
+			auto& thread = g_profiler_trace_thread;
+			if (!name || g_profiler_trace_thread_destroyed)
+				return;
+
+			strncpy(thread.name, name, CORE_PROFILER_THREAD_NAME_SIZE - 1);
+			thread.name[CORE_PROFILER_THREAD_NAME_SIZE - 1] = '\0';
+			if (!thread.buffer)
+				return;
+
+			std::lock_guard<std::mutex> lock(g_profiler_trace_state.lock);
+			memcpy(thread.buffer->name, thread.name, CORE_PROFILER_THREAD_NAME_SIZE);
+		}
+
+		u64 profiler_trace__get_time()
+		{
+			return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()
+			).count();
+		}
+
+		void profiler_trace__record(profiler_trace_event_type type, const void* data, c_str name, u64 value)
+		{
+			auto* buffer = profiler_trace__get_buffer();
+			if (!buffer)
+				return;
+
+			const u64 head = buffer->head.load(std::memory_order_relaxed);
+			auto& event = buffer->events[head & g_profiler_trace_mask];
+			event.time = profiler_trace__get_time();
+			event.value = value;
+			event.data = data;
+			event.name = name;
+			event.type = type;
+			buffer->head.store(head + 1, std::memory_order_release);
+		}
+
+		profiler_trace_buffer* profiler_trace__get_buffer()
+		{
+			if (g_profiler_trace_thread_destroyed)
+				return null;
+
+			auto& state = g_profiler_trace_state;
+			auto& thread = g_profiler_trace_thread;
+			auto* buffer = thread.buffer;
+
+			if (!buffer) {
+				if (thread.creating)
+					return null;
+
+				thread.creating = true;
+				buffer = new (core::alloc(sizeof(profiler_trace_buffer), alloc_tag::profiler)) profiler_trace_buffer();
+				buffer->events = (profiler_trace_event*)core::alloc(sizeof(profiler_trace_event) * CORE_PROFILER_TRACE_EVENTS, alloc_tag::profiler);
+				buffer->generation.store(state.generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				thread.creating = false;
+
+				std::lock_guard<std::mutex> lock(state.lock);
+				memcpy(buffer->name, thread.name, CORE_PROFILER_THREAD_NAME_SIZE);
+				buffer->thread_id = state.next_thread_id++;
+				buffer->next = state.buffers;
+				state.buffers = buffer;
+				thread.buffer = buffer;
+			}
+
+			const u32 generation = state.generation.load(std::memory_order_relaxed);
+			// head is reset before generation is published, capture never sees old events on new generation
+			if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+				buffer->head.store(0, std::memory_order_relaxed);
+				buffer->generation.store(generation, std::memory_order_release);
+			}
+			return buffer;
+		}
+
+		void profiler_trace__free_exited_buffers()
+		{
+			auto& state = g_profiler_trace_state;
+			profiler_trace_buffer** link = &state.buffers;
+			while (*link) {
+				auto* buffer = *link;
+				if (!buffer->exited.load(std::memory_order_acquire)) {
+					link = &buffer->next;
+					continue;
+				}
+
+				*link = buffer->next;
+				core::alloc_free(buffer->events);
+				buffer->~profiler_trace_buffer();
+				core::alloc_free(buffer);
+			}
+		}
+
+		u32 profiler_trace__get_string_idx(profiler_trace_capture& capture, c_str str)
+		{
+			if (!str)
+				return MAX_U32_VALUE;
+
+			const auto it = capture.string_tbl.find(str);
+			if (it != capture.string_tbl.end())
+				return it->second;
+
+			const u32 idx = (u32)capture.strings.size();
+			capture.strings.push_back(string(str));
+			capture.string_tbl[str] = idx;
+			return idx;
+		}
+
+		void profiler_trace__write_binary(const profiler_trace_capture& capture, c_str path)
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!file)
+				throw profiler_exception(fmt::format(strings::exceptions::g_profiler_capture_open_failed, path).c_str());
+
+			const profiler_trace_file_header header = {
+				CORE_PROFILER_TRACE_MAGIC,
+				CORE_PROFILER_TRACE_VERSION,
+				(u32)capture.strings.size(),
+				(u32)capture.threads.size()
+			};
+			file.write((const char*)&header, sizeof(header));
+
+			for (const auto& str : capture.strings) {
+				const u32 length = (u32)str.size();
+				file.write((const char*)&length, sizeof(u32));
+				file.write(str.data(), length);
+			}
+
+			for (const auto& thread : capture.threads) {
+				const u32 thread_header[] = { thread.id, thread.name_idx, (u32)thread.events.size() };
+				file.write((const char*)thread_header, sizeof(thread_header));
+				file.write((const char*)thread.events.data(), sizeof(profiler_trace_file_event) * thread.events.size());
+			}
+		}
+
+		void profiler_trace__read_binary(profiler_trace_capture& capture, c_str path)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file)
+				throw profiler_exception(fmt::format(strings::exceptions::g_profiler_capture_open_failed, path).c_str());
+
+			profiler_trace_file_header header = {};
+			file.read((char*)&header, sizeof(header));
+			if (!file || header.magic != CORE_PROFILER_TRACE_MAGIC || header.version != CORE_PROFILER_TRACE_VERSION)
+				throw profiler_exception(fmt::format(strings::exceptions::g_profiler_capture_invalid_file, path).c_str());
+
+			capture.strings.resize(header.num_strings);
+			for (u32 i = 0; i < header.num_strings; ++i) {
+				u32 length = 0;
+				file.read((char*)&length, sizeof(u32));
+				capture.strings[i].resize(length);
+				file.read(capture.strings[i].data(), length);
+			}
+
+			capture.threads.resize(header.num_threads);
+			for (u32 i = 0; i < header.num_threads; ++i) {
+				u32 thread_header[3] = {};
+				file.read((char*)thread_header, sizeof(thread_header));
+
+				auto& thread = capture.threads[i];
+				thread.id = thread_header[0];
+				thread.name_idx = thread_header[1];
+				thread.events.resize(thread_header[2]);
+				file.read((char*)thread.events.data(), sizeof(profiler_trace_file_event) * thread.events.size());
+			}
+
+			if (!file)
+				throw profiler_exception(fmt::format(strings::exceptions::g_profiler_capture_invalid_file, path).c_str());
+		}
+
+		static void profiler_trace__append_json_str(fmt::memory_buffer& output, c_str str)
+		{
+			output.push_back('"');
+			for (; *str; ++str) {
+				const char c = *str;
+				if (c == '"' || c == '\\') {
+					output.push_back('\\');
+					output.push_back(c);
+				}
+				else if ((u8)c < 0x20)
+					fmt::format_to(fmt::appender(output), "\\u{:04x}", (u32)(u8)c);
+				else
+					output.push_back(c);
+			}
+			output.push_back('"');
+		}
+
+		static c_str profiler_trace__get_str(const profiler_trace_capture& capture, u32 idx, c_str default_str)
+		{
+			return idx < capture.strings.size() ? capture.strings[idx].c_str() : default_str;
+		}
+
+		void profiler_trace__write_json(const profiler_trace_capture& capture, c_str path)
+		{
+			fmt::memory_buffer output;
+			bool first = true;
+			const auto begin_event = [&output, &first]() {
+				if (!first)
+					output.push_back(',');
+				output.push_back('\n');
+				first = false;
+			};
+			// chrome trace uses microseconds
+			const auto to_us = [](u64 time) { return (double)time / 1000.0; };
+
+			fmt::format_to(fmt::appender(output), "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+			vector<const profiler_trace_file_event*> mem_events;
+			for (const auto& thread : capture.threads) {
+				begin_event();
+				fmt::format_to(fmt::appender(output), "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":", thread.id);
+				if (thread.name_idx < capture.strings.size())
+					profiler_trace__append_json_str(output, capture.strings[thread.name_idx].c_str());
+				else
+					profiler_trace__append_json_str(output, fmt::format(strings::profiler::trace_thread, thread.id).c_str());
+				fmt::format_to(fmt::appender(output), "}}}}");
+
+				// ring may start in the middle of a zone, unmatched ends are dropped
+				u32 zone_depth = 0;
+				u32 frame_depth = 0;
+				for (const auto& event : thread.events) {
+					switch (event.type) {
+					case profiler_trace_event_type::zone_begin:
+						++zone_depth;
+						begin_event();
+						fmt::format_to(fmt::appender(output), "{{\"name\":");
+						profiler_trace__append_json_str(output, profiler_trace__get_str(capture, event.name_idx, strings::profiler::trace_unknown));
+						fmt::format_to(fmt::appender(output), ",\"cat\":\"zone\",\"ph\":\"B\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"args\":{{\"file\":", thread.id, to_us(event.time));
+						profiler_trace__append_json_str(output, profiler_trace__get_str(capture, event.file_idx, strings::profiler::trace_unknown));
+						fmt::format_to(fmt::appender(output), ",\"line\":{}}}}}", event.line);
+						break;
+					case profiler_trace_event_type::zone_end:
+						if (zone_depth == 0)
+							break;
+						--zone_depth;
+						begin_event();
+						fmt::format_to(fmt::appender(output), "{{\"ph\":\"E\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}}}", thread.id, to_us(event.time));
+						break;
+					case profiler_trace_event_type::frame_begin:
+						++frame_depth;
+						begin_event();
+						fmt::format_to(fmt::appender(output), "{{\"name\":\"{}\",\"cat\":\"frame\",\"ph\":\"B\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}}}",
+							strings::profiler::engine_loop, thread.id, to_us(event.time));
+						break;
+					case profiler_trace_event_type::frame_end:
+						if (frame_depth == 0)
+							break;
+						--frame_depth;
+						begin_event();
+						fmt::format_to(fmt::appender(output), "{{\"ph\":\"E\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}}}", thread.id, to_us(event.time));
+						break;
+					case profiler_trace_event_type::alloc:
+					case profiler_trace_event_type::free:
+						mem_events.push_back(&event);
+						break;
+					}
+				}
+			}
+
+			// memory counters are computed in time order across all threads,
+			// frees of memory allocated before capture begins are ignored
+			eastl::sort(mem_events.begin(), mem_events.end(), [](const profiler_trace_file_event* a, const profiler_trace_file_event* b) {
+				return a->time < b->time;
+			});
+
+			hash_map<u64, u64> live_allocs;
+			hash_map<u32, i64> pool_usage;
+			for (const auto* event : mem_events) {
+				i64& usage = pool_usage[event->name_idx];
+				if (event->type == profiler_trace_event_type::alloc) {
+					live_allocs[event->address] = event->value;
+					usage += (i64)event->value;
+				}
+				else {
+					const auto it = live_allocs.find(event->address);
+					if (it == live_allocs.end())
+						continue;
+					usage -= (i64)it->second;
+					live_allocs.erase(it);
+				}
+
+				begin_event();
+				fmt::format_to(fmt::appender(output), "{{\"name\":");
+				profiler_trace__append_json_str(output, profiler_trace__get_str(capture, event->name_idx, strings::g_alloc_tag_names[0]));
+				fmt::format_to(fmt::appender(output), ",\"cat\":\"memory\",\"ph\":\"C\",\"pid\":1,\"ts\":{:.3f},\"args\":{{\"bytes\":{}}}}}", to_us(event->time), usage);
+			}
+
+			fmt::format_to(fmt::appender(output), "\n]}}\n");
+
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!file)
+				throw profiler_exception(fmt::format(strings::exceptions::g_profiler_capture_open_failed, path).c_str());
+			file.write(output.data(), output.size());
+		}
+	}
+}
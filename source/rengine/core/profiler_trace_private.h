@@ -0,0 +1,122 @@
+#pragma once
+#include "../base_private.h"
+#include "./profiler.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace rengine {
+	namespace core {
+		enum class profiler_trace_event_type : u32 {
+			zone_begin = 0,
+			zone_end,
+			frame_begin,
+			frame_end,
+			alloc,
+			free
+		};
+
+		// raw event recorded by threads, pointers are resolved only when capture ends
+		struct profiler_trace_event {
+			u64 time;
+			u64 value;
+			const void* data;
+			c_str name;
+			profiler_trace_event_type type;
+			u32 padding;
+		};
+
+		/*
+		* Per thread ring of events, oldest events are overwritten when buffer is full.
+		* Only owner thread writes on it, head is published with release
+		* then capture can read events while thread is still running.
+		*/
+		struct profiler_trace_buffer {
+			profiler_trace_buffer* next{ null };
+			profiler_trace_event* events{ null };
+			std::atomic<u64> head{ 0 };
+			// buffer is reset by owner thread when capture generation changes, capture reads it from other thread
+			std::atomic<u32> generation{ 0 };
+			u32 thread_id{ 0 };
+			std::atomic<bool> exited{ false };
+			char name[CORE_PROFILER_THREAD_NAME_SIZE]{};
+		};
+
+		struct profiler_trace_thread {
+			profiler_trace_buffer* buffer{ null };
+			// buffer allocation also records alloc events, this avoids recursion
+			bool creating{ false };
+			char name[CORE_PROFILER_THREAD_NAME_SIZE]{};
+
+			~profiler_trace_thread();
+		};
+
+		struct profiler_trace_state {
+			std::atomic<bool> recording{ false };
+			std::atomic<u32> generation{ 0 };
+			u64 start_time{ 0 };
+			// guards buffers list and thread names
+			std::mutex lock;
+			profiler_trace_buffer* buffers{ null };
+			u32 next_thread_id{ 0 };
+		};
+		extern profiler_trace_state g_profiler_trace_state;
+		extern thread_local profiler_trace_thread g_profiler_trace_thread;
+
+		// serialized event, all pointers are replaced by string indices
+		struct profiler_trace_file_event {
+			u64 time;
+			u64 value;
+			u64 address;
+			u32 name_idx;
+			u32 file_idx;
+			u32 line;
+			profiler_trace_event_type type;
+		};
+
+		struct profiler_trace_file_header {
+			u32 magic;
+			u32 version;
+			u32 num_strings;
+			u32 num_threads;
+		};
+
+		struct profiler_trace_capture_thread {
+			u32 id;
+			u32 name_idx;
+			vector<profiler_trace_file_event> events;
+		};
+
+		struct profiler_trace_capture {
+			vector<string> strings;
+			vector<profiler_trace_capture_thread> threads;
+			// keys are source pointers, they're only used while capture is being collected
+			hash_map<const void*, u32> string_tbl;
+		};
+
+		// buffers of running threads are freed, then it must be called after worker threads are joined
+		void profiler_trace__deinit();
+
+		void profiler_trace__begin();
+		void profiler_trace__end(profiler_trace_capture& capture);
+		bool profiler_trace__recording();
+
+		void profiler_trace__zone_begin(const profiler_entry_info* entry);
+		void profiler_trace__zone_end();
+		void profiler_trace__frame_begin();
+		void profiler_trace__frame_end();
+		void profiler_trace__alloc(ptr mem, size_t size, c_str pool_name);
+		void profiler_trace__free(ptr mem, c_str pool_name);
+		void profiler_trace__set_thread_name(c_str name);
+
+		u64 profiler_trace__get_time();
+		void profiler_trace__record(profiler_trace_event_type type, const void* data, c_str name, u64 value);
+		profiler_trace_buffer* profiler_trace__get_buffer();
+		void profiler_trace__free_exited_buffers();
+		u32 profiler_trace__get_string_idx(profiler_trace_capture& capture, c_str str);
+
+		void profiler_trace__write_binary(const profiler_trace_capture& capture, c_str path);
+		void profiler_trace__read_binary(profiler_trace_capture& capture, c_str path);
+		void profiler_trace__write_json(const profiler_trace_capture& capture, c_str path);
+	}
+}
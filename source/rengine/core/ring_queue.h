@@ -0,0 +1,261 @@
+#pragma once
+#include <rengine/types.h>
+
+#include <atomic>
+#include <utility>
+
+namespace rengine {
+    namespace core {
+        /*
+        * Bounded lock-free single producer, single consumer ring queue.
+        * Indices are free running and wrapped by capacity mask,
+        * each side keeps a cached copy of the other side index
+        * then shared cache line is only touched when cached value is exhausted.
+        */
+        template<typename T, u32 Capacity>
+        class spsc_queue {
+        public:
+            static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+            static_assert(Capacity <= (1u << 31), "Capacity must be less than 2^31");
+
+            spsc_queue() {}
+            spsc_queue(const spsc_queue&) = delete;
+            spsc_queue& operator=(const spsc_queue&) = delete;
+
+            // producer only
+            bool try_push(const T& value) {
+                const u32 tail = tail_.load(std::memory_order_relaxed);
+                if (!has_room(tail, 1))
+                    return false;
+
+                items_[tail & g_mask] = value;
+                tail_.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            // producer only
+            bool try_push(T&& value) {
+                const u32 tail = tail_.load(std::memory_order_relaxed);
+                if (!has_room(tail, 1))
+                    return false;
+
+                items_[tail & g_mask] = std::move(value);
+                tail_.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            // producer only, push as many items as fits and returns pushed count
+            u32 try_push_batch(const T* values, u32 count) {
+                const u32 tail = tail_.load(std::memory_order_relaxed);
+                u32 free_count = Capacity - (tail - cached_head_);
+                if (free_count < count) {
+                    cached_head_ = head_.load(std::memory_order_acquire);
+                    free_count = Capacity - (tail - cached_head_);
+                }
+
+                count = count < free_count ? count : free_count;
+                for (u32 i = 0; i < count; ++i)
+                    items_[(tail + i) & g_mask] = values[i];
+
+                // single release publishes the whole batch
+                if (count > 0)
+                    tail_.store(tail + count, std::memory_order_release);
+                return count;
+            }
+
+            // consumer only
+            bool try_pop(T& output) {
+                const u32 head = head_.load(std::memory_order_relaxed);
+                if (!has_items(head, 1))
+                    return false;
+
+                output = std::move(items_[head & g_mask]);
+                head_.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            // consumer only, pop up to max_count items and returns popped count
+            u32 try_pop_batch(T* output, u32 max_count) {
+                const u32 head = head_.load(std::memory_order_relaxed);
+                u32 count = cached_tail_ - head;
+                if (count < max_count) {
+                    cached_tail_ = tail_.load(std::memory_order_acquire);
+                    count = cached_tail_ - head;
+                }
+
+                count = count < max_count ? count : max_count;
+                for (u32 i = 0; i < count; ++i)
+                    output[i] = std::move(items_[(head + i) & g_mask]);
+
+                if (count > 0)
+                    head_.store(head + count, std::memory_order_release);
+                return count;
+            }
+
+            // value can be outdated when called while other thread is operating
+            u32 size_approx() const {
+                const u32 tail = tail_.load(std::memory_order_acquire);
+                const u32 head = head_.load(std::memory_order_acquire);
+                return tail - head;
+            }
+            bool empty() const { return size_approx() == 0; }
+            constexpr u32 capacity() const { return Capacity; }
+        private:
+            bool has_room(u32 tail, u32 count) {
+                if (Capacity - (tail - cached_head_) >= count)
+                    return true;
+                cached_head_ = head_.load(std::memory_order_acquire);
+                return Capacity - (tail - cached_head_) >= count;
+            }
+
+            bool has_items(u32 head, u32 count) {
+                if (cached_tail_ - head >= count)
+                    return true;
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                return cached_tail_ - head >= count;
+            }
+
+            static constexpr u32 g_mask = Capacity - 1;
+
+            // consumer side
+            alignas(CORE_CACHE_LINE_SIZE) std::atomic<u32> head_{ 0 };
+            u32 cached_tail_{ 0 };
+            // producer side
+            alignas(CORE_CACHE_LINE_SIZE) std::atomic<u32> tail_{ 0 };
+            u32 cached_head_{ 0 };
+
+            alignas(CORE_CACHE_LINE_SIZE) T items_[Capacity];
+        };
+
+        /*
+        * Bounded lock-free multiple producer, single consumer ring queue.
+        * Each cell has a sequence number that tells if cell is ready
+        * to be written by producers or read by consumer.
+        * Producers claim cells by CAS on tail, consumer doesn't need any locked operation.
+        */
+        template<typename T, u32 Capacity>
+        class mpsc_queue {
+        public:
+            static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+            static_assert(Capacity <= (1u << 31), "Capacity must be less than 2^31");
+
+            mpsc_queue() {
+                for (u32 i = 0; i < Capacity; ++i)
+                    cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            mpsc_queue(const mpsc_queue&) = delete;
+            mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+            bool try_push(const T& value) {
+                u32 pos;
+                cell_t* cell = claim_cell(pos);
+                if (!cell)
+                    return false;
+
+                cell->value = value;
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool try_push(T&& value) {
+                u32 pos;
+                cell_t* cell = claim_cell(pos);
+                if (!cell)
+                    return false;
+
+                cell->value = std::move(value);
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            // claim a contiguous range of cells with a single CAS,
+            // push as many items as fits and returns pushed count
+            u32 try_push_batch(const T* values, u32 count) {
+                if (count == 0)
+                    return 0;
+
+                u32 pos = tail_.load(std::memory_order_relaxed);
+                u32 num_items;
+                while (true) {
+                    // head can be outdated, then free count is underestimated but never wrong
+                    const u32 head = head_.load(std::memory_order_acquire);
+                    const u32 free_count = Capacity - (pos - head);
+                    num_items = count < free_count ? count : free_count;
+                    if (num_items == 0)
+                        return 0;
+
+                    if (tail_.compare_exchange_weak(pos, pos + num_items, std::memory_order_relaxed))
+                        break;
+                }
+
+                for (u32 i = 0; i < num_items; ++i) {
+                    auto& cell = cells_[(pos + i) & g_mask];
+                    cell.value = values[i];
+                    cell.sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                return num_items;
+            }
+
+            // consumer only
+            bool try_pop(T& output) {
+                const u32 pos = head_.load(std::memory_order_relaxed);
+                auto& cell = cells_[pos & g_mask];
+                const u32 seq = cell.sequence.load(std::memory_order_acquire);
+                // producer didn't finish writing yet or queue is empty
+                if ((i32)(seq - (pos + 1)) < 0)
+                    return false;
+
+                output = std::move(cell.value);
+                cell.sequence.store(pos + Capacity, std::memory_order_release);
+                head_.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            // consumer only, stops at first cell that isn't ready
+            u32 try_pop_batch(T* output, u32 max_count) {
+                u32 count = 0;
+                while (count < max_count && try_pop(output[count]))
+                    ++count;
+                return count;
+            }
+
+            // value can be outdated when called while other thread is operating
+            u32 size_approx() const {
+                const u32 tail = tail_.load(std::memory_order_acquire);
+                const u32 head = head_.load(std::memory_order_acquire);
+                return tail - head;
+            }
+            bool empty() const { return size_approx() == 0; }
+            constexpr u32 capacity() const { return Capacity; }
+        private:
+            struct cell_t {
+                std::atomic<u32> sequence;
+                T value;
+            };
+
+            cell_t* claim_cell(u32& pos) {
+                pos = tail_.load(std::memory_order_relaxed);
+                while (true) {
+                    auto& cell = cells_[pos & g_mask];
+                    const u32 seq = cell.sequence.load(std::memory_order_acquire);
+                    const i32 diff = (i32)(seq - pos);
+                    if (diff == 0) {
+                        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            return &cell;
+                    }
+                    // cell from previous lap wasn't consumed, queue is full
+                    else if (diff < 0)
+                        return null;
+                    else
+                        pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+
+            static constexpr u32 g_mask = Capacity - 1;
+
+            alignas(CORE_CACHE_LINE_SIZE) std::atomic<u32> head_{ 0 };
+            alignas(CORE_CACHE_LINE_SIZE) std::atomic<u32> tail_{ 0 };
+            alignas(CORE_CACHE_LINE_SIZE) cell_t cells_[Capacity];
+        };
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <rengine/types.h>
+
+#include <cstddef>
+
+namespace rengine {
+	namespace core {
+		/*
+		* String hash known at compile time.
+		* Value is the same of core::hash(c_str), then it can be used
+		* anywhere runtime string hashes are used, like shader resource slots.
+		* String is kept only to be displayed, debug builds registers it on string pool.
+		*/
+		struct string_hash {
+			hash_t value{ 0 };
+			c_str str{ null };
+
+			constexpr string_hash() {}
+			constexpr string_hash(hash_t hash_value) : value(hash_value), str(null) {}
+			constexpr string_hash(hash_t hash_value, c_str hash_str) : value(hash_value), str(hash_str) {}
+
+			constexpr operator hash_t() const { return value; }
+		};
+
+		// constexpr implementation of XXH32, must produce same result of XXH32 on little endian targets
+		namespace static_hash_impl {
+			constexpr static u32 g_prime_1 = 0x9E3779B1U;
+			constexpr static u32 g_prime_2 = 0x85EBCA77U;
+			constexpr static u32 g_prime_3 = 0xC2B2AE3DU;
+			constexpr static u32 g_prime_4 = 0x27D4EB2FU;
+			constexpr static u32 g_prime_5 = 0x165667B1U;
+
+			constexpr u32 rotl(u32 value, u32 bits) {
+				return (value << bits) | (value >> (32 - bits));
+			}
+
+			constexpr u32 read_u32(c_str str, size_t offset) {
+				return (u32)(u8)str[offset]
+					| ((u32)(u8)str[offset + 1] << 8)
+					| ((u32)(u8)str[offset + 2] << 16)
+					| ((u32)(u8)str[offset + 3] << 24);
+			}
+
+			constexpr u32 round(u32 acc, u32 input) {
+				acc += input * g_prime_2;
+				acc = rotl(acc, 13);
+				return acc * g_prime_1;
+			}
+
+			constexpr size_t length(c_str str) {
+				size_t result = 0;
+				while (str[result] != '\0')
+					++result;
+				return result;
+			}
+
+			constexpr u32 xxh32(c_str str, size_t len, u32 seed) {
+				size_t offset = 0;
+				u32 result = 0;
+				if (len >= 16) {
+					u32 v1 = seed + g_prime_1 + g_prime_2;
+					u32 v2 = seed + g_prime_2;
+					u32 v3 = seed;
+					u32 v4 = seed - g_prime_1;
+					const size_t limit = len - 16;
+					do {
+						v1 = round(v1, read_u32(str, offset));
+						v2 = round(v2, read_u32(str, offset + 4));
+						v3 = round(v3, read_u32(str, offset + 8));
+						v4 = round(v4, read_u32(str, offset + 12));
+						offset += 16;
+					} while (offset <= limit);
+					result = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+				}
+				else {
+					result = seed + g_prime_5;
+				}
+
+				result += (u32)len;
+				while (offset + 4 <= len) {
+					result += read_u32(str, offset) * g_prime_3;
+					result = rotl(result, 17) * g_prime_4;
+					offset += 4;
+				}
+
+				while (offset < len) {
+					result += (u32)(u8)str[offset] * g_prime_5;
+					result = rotl(result, 11) * g_prime_1;
+					++offset;
+				}
+
+				result ^= result >> 15;
+				result *= g_prime_2;
+				result ^= result >> 13;
+				result *= g_prime_3;
+				result ^= result >> 16;
+				return result;
+			}
+
+			template<size_t N>
+			struct fixed_string {
+				char value[N]{};
+
+				constexpr fixed_string(const char (&str)[N]) {
+					for (size_t i = 0; i < N; ++i)
+						value[i] = str[i];
+				}
+			};
+		}
+
+		constexpr string_hash const_hash(c_str str, size_t length) {
+			if (!str)
+				return string_hash{};
+			return string_hash(static_hash_impl::xxh32(str, length, CORE_DEFAULT_HASH_SEED), str);
+		}
+
+		constexpr string_hash const_hash(c_str str) {
+			if (!str)
+				return string_hash{};
+			return const_hash(str, static_hash_impl::length(str));
+		}
+
+		// usage: core::static_hash<"g_texture">
+		template<static_hash_impl::fixed_string Str>
+		constexpr string_hash static_hash = const_hash(Str.value, sizeof(Str.value) - 1);
+	}
+
+	// usage: "g_texture"_rh
+	consteval core::string_hash operator""_rh(const char* str, size_t length) {
+		return core::const_hash(str, length);
+	}
+}
@@ -1,68 +1,163 @@
 #include "./string_pool.h"
 #include "./hash.h"
-#include "./allocator.h"
 #include "./string_pool_private.h"
+#include "../exceptions.h"
+
+#include <fmt/format.h>
 
 namespace rengine {
     namespace core {
-        c_str rengine::core::string_pool_intern(const c_str str, core::hash_t* output_hash)
+        c_str string_pool_intern(const c_str str, core::hash_t* output_hash)
         {
-			auto& state = g_string_pool_state;
-            auto str_hash = hash(str);
-			auto pair = state.strings.find_as(str_hash);
+            if (!str) {
+                if (output_hash)
+                    *output_hash = 0;
+                return null;
+            }
 
+            const u32 length = (u32)strlen(str);
+            const auto* entry = string_pool__intern(str, length, hash64(str, length));
             if (output_hash)
-                *output_hash = str_hash;
-			if (state.strings.end() != pair)
-				return pair->second;
+                *output_hash = entry->hash32;
+            return entry->str();
+        }
+
+        void string_pool_intern_many(const c_str* strs, u32 count, c_str* output_strs, core::hash_t* output_hashes)
+        {
+            auto& state = g_string_pool_state;
+            hash64_t hashes[CORE_STRING_POOL_BATCH_SIZE];
+            u32 lengths[CORE_STRING_POOL_BATCH_SIZE];
+            u32 misses[CORE_STRING_POOL_BATCH_SIZE];
 
-			char* intern_str = (char*)alloc(strlen(str) + 1);
-            strcpy(intern_str, str);
+            const auto set_output = [output_strs, output_hashes](u32 idx, const string_pool_entry* entry) {
+                output_strs[idx] = entry->str();
+                if (output_hashes)
+                    output_hashes[idx] = entry->hash32;
+            };
 
-			state.strings[str_hash] = intern_str;
-            ++state.num_strings;
+            for (u32 offset = 0; offset < count; offset += CORE_STRING_POOL_BATCH_SIZE) {
+                const u32 batch_count = count - offset < CORE_STRING_POOL_BATCH_SIZE ? count - offset : CORE_STRING_POOL_BATCH_SIZE;
+                u32 num_misses = 0;
 
-            return intern_str;
+                // first pass is lock free, most of strings are expected to be already interned
+                const auto* table = state.table.load(std::memory_order_acquire);
+                for (u32 i = 0; i < batch_count; ++i) {
+                    const u32 idx = offset + i;
+                    const c_str str = strs[idx];
+                    if (!str) {
+                        output_strs[idx] = null;
+                        if (output_hashes)
+                            output_hashes[idx] = 0;
+                        continue;
+                    }
+
+                    lengths[i] = (u32)strlen(str);
+                    hashes[i] = hash64(str, lengths[i]);
+                    const auto* entry = string_pool__find(table, str, lengths[i], hashes[i]);
+                    if (entry)
+                        set_output(idx, entry);
+                    else
+                        misses[num_misses++] = i;
+                }
+
+                // missing strings are inserted stripe by stripe, each pass locks a single stripe
+                while (num_misses > 0) {
+                    string_pool__reserve(num_misses);
+
+                    auto& stripe = string_pool__get_stripe(hashes[misses[0]]);
+                    u32 num_remaining = 0;
+                    {
+                        std::lock_guard<std::mutex> lock(stripe.lock);
+                        for (u32 i = 0; i < num_misses; ++i) {
+                            const u32 miss = misses[i];
+                            if (&string_pool__get_stripe(hashes[miss]) != &stripe) {
+                                misses[num_remaining++] = miss;
+                                continue;
+                            }
+
+                            const auto* entry = string_pool__insert(stripe, strs[offset + miss], lengths[miss], hashes[miss]);
+                            // table must grow, string will be inserted on next pass
+                            if (!entry) {
+                                misses[num_remaining++] = miss;
+                                continue;
+                            }
+                            set_output(offset + miss, entry);
+                        }
+                    }
+                    num_misses = num_remaining;
+                }
+            }
         }
 
         c_str string_pool_get_from_hash(core::hash_t hash)
         {
-            auto& state = g_string_pool_state;
-            auto pair = state.strings.find_as(hash);
-
-            if (state.strings.end() == pair)
+            const auto* entry = string_pool__find_32(g_string_pool_state.table.load(std::memory_order_acquire), hash);
+            if (!entry)
                 return null;
+            return entry->str();
+        }
 
-            return pair->second;
+        void string_pool_register(const string_hash& hash)
+        {
+            if (!hash.str || string_pool_get_from_hash(hash.value))
+                return;
+
+            hash_t runtime_hash{};
+            string_pool_intern(hash.str, &runtime_hash);
+            if (runtime_hash != hash.value)
+                throw engine_exception(
+                    fmt::format(strings::exceptions::g_string_pool_hash_mismatch, hash.str, hash.value, runtime_hash).c_str()
+                );
         }
 
         void string_pool_uncache(core::hash_t hash)
         {
             auto& state = g_string_pool_state;
-            auto pair = state.strings.find_as(hash);
+            string_pool__lock_all();
 
-            if (state.strings.end() == pair)
-                return;
+            // string memory is kept on arena, readers may still be holding it
+            auto* table = state.table.load(std::memory_order_acquire);
+            const auto* entry = string_pool__find_32(table, hash);
+            if (entry) {
+                string_pool__remove_slot(table->slots, table->capacity, entry->hash, entry);
+                string_pool__remove_slot(table->slots_32, table->capacity, entry->hash32, entry);
+                state.num_strings.fetch_sub(1, std::memory_order_relaxed);
+            }
 
-            core::alloc_free((ptr)pair->second);
-			state.strings.erase(pair);
-            --state.num_strings;
+            string_pool__unlock_all();
         }
-        
+
         void string_pool_clear()
         {
             auto& state = g_string_pool_state;
-            for (auto& pair : state.strings) {
-                auto str = (ptr)pair.second;
-                core::alloc_free(str);
+            string_pool__lock_all();
+
+            auto* table = state.table.load(std::memory_order_acquire);
+            if (table) {
+                string_pool__free_tables(table->prev);
+                table->prev = null;
+                for (u32 i = 0; i < table->capacity; ++i) {
+                    table->slots[i].store(null, std::memory_order_relaxed);
+                    table->slots_32[i].store(null, std::memory_order_relaxed);
+                }
+            }
+
+            for (u32 i = 0; i < CORE_STRING_POOL_STRIPES; ++i) {
+                auto* arena = state.stripes[i].arena;
+                if (!arena)
+                    continue;
+                arena->destroy_all_blocks();
+                arena->reset();
             }
-            state.strings.clear();
-            state.num_strings = 0;
+
+            state.num_strings.store(0, std::memory_order_relaxed);
+            state.num_used.store(0, std::memory_order_relaxed);
+            string_pool__unlock_all();
         }
-        
+
         size_t string_pool_num_stored_strings()
         {
-			return g_string_pool_state.num_strings;
+			return g_string_pool_state.num_strings.load(std::memory_order_relaxed);
         }
     }
 }
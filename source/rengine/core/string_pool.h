@@ -1,12 +1,27 @@
 #pragma once
 #include <rengine/api.h>
 #include <rengine/types.h>
+#include <rengine/core/static_hash.h>
 
 namespace rengine {
     namespace core {
+        /*
+        * Strings are stored on arena pages and never moves, returned pointers
+        * are valid until string_pool_clear, even if string is uncached.
+        * Lookups are lock free and can be called from any thread.
+        */
         R_EXPORT c_str string_pool_intern(const c_str str, core::hash_t* output_hash = null);
+        /*
+        * Intern a list of strings at once, missing strings are inserted
+        * grouped by write stripe, then each lock is taken once per batch.
+        * output_hashes is optional.
+        */
+        R_EXPORT void string_pool_intern_many(const c_str* strs, u32 count, c_str* output_strs, core::hash_t* output_hashes = null);
         R_EXPORT c_str string_pool_get_from_hash(core::hash_t hash);
+        // stores string of a compile time hash, then name can be retrieved from hash value
+        R_EXPORT void string_pool_register(const string_hash& hash);
 		R_EXPORT void string_pool_uncache(core::hash_t hash);
+        // release all strings, must not be called while other threads are using string pool
         R_EXPORT void string_pool_clear();
         R_EXPORT size_t string_pool_num_stored_strings();
     }
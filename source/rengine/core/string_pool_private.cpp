@@ -1,18 +1,235 @@
 #include "string_pool_private.h"
 #include "./allocator.h"
+#include "./hash.h"
 #include "./string_pool.h"
 
 namespace rengine {
 	namespace core {
 		string_pool_state g_string_pool_state = {};
-		
+		// marks slots of removed strings, probing must continue through them
+		static string_pool_entry g_string_pool_removed_entry = {};
+
 		void string_pool__init()
 		{
+			auto& state = g_string_pool_state;
+			for (u32 i = 0; i < CORE_STRING_POOL_STRIPES; ++i)
+				state.stripes[i].arena = arena_create_paged(CORE_STRING_POOL_PAGE_SIZE, alloc_tag::string_pool);
+			state.table.store(string_pool__alloc_table(CORE_STRING_POOL_INITIAL_CAPACITY), std::memory_order_release);
 		}
 
 		void string_pool__deinit()
 		{
+			auto& state = g_string_pool_state;
 			string_pool_clear();
+
+			string_pool__free_tables(state.table.exchange(null, std::memory_order_acq_rel));
+			for (u32 i = 0; i < CORE_STRING_POOL_STRIPES; ++i) {
+				arena_destroy(state.stripes[i].arena);
+				state.stripes[i].arena = null;
+			}
+		}
+
+		const string_pool_entry* string_pool__intern(c_str str, u32 length, hash64_t hash)
+		{
+			auto& state = g_string_pool_state;
+			// fast path, lock free lookup
+			const auto* entry = string_pool__find(state.table.load(std::memory_order_acquire), str, length, hash);
+			if (entry)
+				return entry;
+
+			auto& stripe = string_pool__get_stripe(hash);
+			while (true) {
+				string_pool__reserve(1);
+
+				std::lock_guard<std::mutex> lock(stripe.lock);
+				entry = string_pool__insert(stripe, str, length, hash);
+				if (entry)
+					return entry;
+			}
+		}
+
+		const string_pool_entry* string_pool__find(const string_pool_table* table, c_str str, u32 length, hash64_t hash)
+		{
+			const u32 mask = table->capacity - 1;
+			u32 idx = (u32)hash & mask;
+			while (true) {
+				const auto* entry = table->slots[idx].load(std::memory_order_acquire);
+				if (!entry)
+					return null;
+
+				// hash match is not enough, content is always compared
+				if (entry->hash == hash && entry->length == length && !string_pool__is_removed(entry) && memcmp(entry->str(), str, length) == 0)
+					return entry;
+				idx = (idx + 1) & mask;
+			}
+		}
+
+		const string_pool_entry* string_pool__find_32(const string_pool_table* table, hash_t hash)
+		{
+			const u32 mask = table->capacity - 1;
+			u32 idx = hash & mask;
+			while (true) {
+				const auto* entry = table->slots_32[idx].load(std::memory_order_acquire);
+				if (!entry)
+					return null;
+
+				if (!string_pool__is_removed(entry) && entry->hash32 == hash)
+					return entry;
+				idx = (idx + 1) & mask;
+			}
+		}
+
+		const string_pool_entry* string_pool__insert(string_pool_stripe& stripe, c_str str, u32 length, hash64_t hash)
+		{
+			auto& state = g_string_pool_state;
+			// table can't be replaced while a stripe lock is held
+			auto* table = state.table.load(std::memory_order_acquire);
+
+			// same string always goes to same stripe, then only this lookup is required
+			// to guarantee that string has not been inserted while we were waiting the lock
+			const auto* curr_entry = string_pool__find(table, str, length, hash);
+			if (curr_entry)
+				return curr_entry;
+
+			// slot is claimed before insertion, other stripes can be inserting at same time.
+			// if table is too loaded, caller must release the lock and grow table
+			const u32 num_used = state.num_used.fetch_add(1, std::memory_order_relaxed) + 1;
+			if (num_used * 4 > table->capacity * 3) {
+				state.num_used.fetch_sub(1, std::memory_order_relaxed);
+				return null;
+			}
+
+			auto* entry = (string_pool_entry*)stripe.arena->alloc_aligned(sizeof(string_pool_entry) + length + 1, alignof(string_pool_entry));
+			entry->hash = hash;
+			entry->hash32 = core::hash((const byte*)str, length);
+			entry->length = length;
+			char* entry_str = reinterpret_cast<char*>(entry + 1);
+			memcpy(entry_str, str, length);
+			entry_str[length] = '\0';
+
+			string_pool__insert_slot(table->slots, table->capacity, hash, entry);
+			string_pool__insert_slot(table->slots_32, table->capacity, entry->hash32, entry);
+			state.num_strings.fetch_add(1, std::memory_order_relaxed);
+			return entry;
+		}
+
+		void string_pool__insert_slot(std::atomic<string_pool_entry*>* slots, u32 capacity, u64 hash, string_pool_entry* entry)
+		{
+			const u32 mask = capacity - 1;
+			u32 idx = (u32)hash & mask;
+			while (true) {
+				string_pool_entry* expected = null;
+				if (slots[idx].compare_exchange_strong(expected, entry, std::memory_order_release, std::memory_order_relaxed))
+					return;
+				idx = (idx + 1) & mask;
+			}
+		}
+
+		void string_pool__remove_slot(std::atomic<string_pool_entry*>* slots, u32 capacity, u64 hash, const string_pool_entry* entry)
+		{
+			const u32 mask = capacity - 1;
+			u32 idx = (u32)hash & mask;
+			while (true) {
+				const auto* curr_entry = slots[idx].load(std::memory_order_relaxed);
+				if (!curr_entry)
+					return;
+				if (curr_entry == entry) {
+					slots[idx].store(string_pool__get_removed_entry(), std::memory_order_release);
+					return;
+				}
+				idx = (idx + 1) & mask;
+			}
+		}
+
+		string_pool_stripe& string_pool__get_stripe(hash64_t hash)
+		{
+			// high bits are used, low bits are already used by table index
+			return g_string_pool_state.stripes[(hash >> 32) & (CORE_STRING_POOL_STRIPES - 1)];
+		}
+
+		void string_pool__reserve(u32 count)
+		{
+			auto& state = g_string_pool_state;
+			// keep load under 1/2, concurrent writers may exceed it until 3/4
+			const auto needs_grow = [&state, count](const string_pool_table* table) {
+				return (state.num_used.load(std::memory_order_relaxed) + count) * 2 > table->capacity;
+			};
+
+			if (!needs_grow(state.table.load(std::memory_order_acquire)))
+				return;
+
+			string_pool__lock_all();
+			auto* table = state.table.load(std::memory_order_acquire);
+			if (!needs_grow(table)) {
+				string_pool__unlock_all();
+				return;
+			}
+
+			u32 capacity = table->capacity * 2;
+			while ((state.num_strings.load(std::memory_order_relaxed) + count) * 2 > capacity)
+				capacity *= 2;
+
+			// removed slots are dropped on rehash
+			auto* new_table = string_pool__alloc_table(capacity);
+			for (u32 i = 0; i < table->capacity; ++i) {
+				auto* entry = table->slots[i].load(std::memory_order_relaxed);
+				if (!entry || string_pool__is_removed(entry))
+					continue;
+				string_pool__insert_slot(new_table->slots, capacity, entry->hash, entry);
+				string_pool__insert_slot(new_table->slots_32, capacity, entry->hash32, entry);
+			}
+
+			new_table->prev = table;
+			state.num_used.store(state.num_strings.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			state.table.store(new_table, std::memory_order_release);
+			string_pool__unlock_all();
+		}
+
+		string_pool_table* string_pool__alloc_table(u32 capacity)
+		{
+			const size_t slots_size = sizeof(std::atomic<string_pool_entry*>) * capacity;
+			byte* data = (byte*)core::alloc(sizeof(string_pool_table) + slots_size * 2, alloc_tag::string_pool);
+
+			auto* table = new (data) string_pool_table();
+			table->capacity = capacity;
+			table->slots = reinterpret_cast<std::atomic<string_pool_entry*>*>(data + sizeof(string_pool_table));
+			table->slots_32 = table->slots + capacity;
+			for (u32 i = 0; i < capacity; ++i) {
+				new (&table->slots[i]) std::atomic<string_pool_entry*>(null);
+				new (&table->slots_32[i]) std::atomic<string_pool_entry*>(null);
+			}
+			return table;
+		}
+
+		void string_pool__free_tables(string_pool_table* table)
+		{
+			while (table) {
+				auto* prev = table->prev;
+				core::alloc_free(table);
+				table = prev;
+			}
+		}
+
+		void string_pool__lock_all()
+		{
+			for (u32 i = 0; i < CORE_STRING_POOL_STRIPES; ++i)
+				g_string_pool_state.stripes[i].lock.lock();
+		}
+
+		void string_pool__unlock_all()
+		{
+			for (u32 i = CORE_STRING_POOL_STRIPES; i > 0; --i)
+				g_string_pool_state.stripes[i - 1].lock.unlock();
+		}
+
+		bool string_pool__is_removed(const string_pool_entry* entry)
+		{
+			return entry == &g_string_pool_removed_entry;
+		}
+
+		string_pool_entry* string_pool__get_removed_entry()
+		{
+			return &g_string_pool_removed_entry;
 		}
 	}
-}
\ No newline at end of file
+}
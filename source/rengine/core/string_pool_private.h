@@ -1,15 +1,70 @@
 #pragma once
 #include "../base_private.h"
+#include "./arena.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace rengine {
 	namespace core {
+		// string content is stored right after entry on stripe arena
+		struct string_pool_entry {
+			hash64_t hash{ 0 };
+			hash_t hash32{ 0 };
+			u32 length{ 0 };
+
+			c_str str() const { return reinterpret_cast<c_str>(this + 1); }
+		};
+
+		/*
+		* Open addressing table with linear probing.
+		* Slots are indexed by 64-bit hash, slots_32 are indexed by
+		* runtime 32-bit hash to resolve string_pool_get_from_hash.
+		* Slots are never moved, table is replaced by a bigger one when grows.
+		*/
+		struct string_pool_table {
+			u32 capacity{ 0 };
+			std::atomic<string_pool_entry*>* slots{ null };
+			std::atomic<string_pool_entry*>* slots_32{ null };
+			// replaced tables are kept until clear, readers can still be probing them
+			string_pool_table* prev{ null };
+		};
+
+		struct string_pool_stripe {
+			alignas(CORE_CACHE_LINE_SIZE) std::mutex lock;
+			IFrameArena* arena{ null };
+		};
+
 		struct string_pool_state {
-			hash_map<core::hash_t, c_str> strings;
-			size_t num_strings;
+			std::atomic<string_pool_table*> table{ null };
+			string_pool_stripe stripes[CORE_STRING_POOL_STRIPES];
+			std::atomic<u32> num_strings{ 0 };
+			// strings + removed slots, used to compute table load
+			std::atomic<u32> num_used{ 0 };
 		};
 		extern string_pool_state g_string_pool_state;
 
 		void string_pool__init();
 		void string_pool__deinit();
+
+		const string_pool_entry* string_pool__intern(c_str str, u32 length, hash64_t hash);
+		const string_pool_entry* string_pool__find(const string_pool_table* table, c_str str, u32 length, hash64_t hash);
+		const string_pool_entry* string_pool__find_32(const string_pool_table* table, hash_t hash);
+		// stripe lock must be held by caller, returns null when table must grow before insertion
+		const string_pool_entry* string_pool__insert(string_pool_stripe& stripe, c_str str, u32 length, hash64_t hash);
+		void string_pool__insert_slot(std::atomic<string_pool_entry*>* slots, u32 capacity, u64 hash, string_pool_entry* entry);
+		// replace entry slot by removed marker, all stripe locks must be held by caller
+		void string_pool__remove_slot(std::atomic<string_pool_entry*>* slots, u32 capacity, u64 hash, const string_pool_entry* entry);
+		string_pool_stripe& string_pool__get_stripe(hash64_t hash);
+		// grows table if there's no room for more count items, must be called without any stripe lock
+		void string_pool__reserve(u32 count);
+
+		string_pool_table* string_pool__alloc_table(u32 capacity);
+		void string_pool__free_tables(string_pool_table* table);
+		void string_pool__lock_all();
+		void string_pool__unlock_all();
+
+		bool string_pool__is_removed(const string_pool_entry* entry);
+		string_pool_entry* string_pool__get_removed_entry();
 	}
-}
\ No newline at end of file
+}
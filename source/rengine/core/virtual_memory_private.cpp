@@ -0,0 +1,98 @@
+#include "./virtual_memory_private.h"
+#include "./allocator.h"
+
+#if PLATFORM_WINDOWS
+	#define WIN32_LEAN_AND_MEAN
+	#include <Windows.h>
+#elif PLATFORM_LINUX
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace rengine {
+	namespace core {
+		size_t virtual_memory__page_size()
+		{
+#if PLATFORM_WINDOWS
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			return info.dwPageSize;
+#elif PLATFORM_LINUX
+			return (size_t)sysconf(_SC_PAGESIZE);
+#else
+			return 4096;
+#endif
+		}
+
+		size_t virtual_memory__huge_page_size()
+		{
+			return 2 * 1024 * 1024;
+		}
+
+		ptr virtual_memory__reserve(const size_t size, const bool huge_pages)
+		{
+#if PLATFORM_WINDOWS
+			return VirtualAlloc(null, size, MEM_RESERVE, PAGE_NOACCESS);
+#elif PLATFORM_LINUX
+			if (!huge_pages) {
+				ptr mem = mmap(null, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				return mem == MAP_FAILED ? null : mem;
+			}
+
+			// mmap only guarantees page alignment, range is over reserved
+			// and unaligned head and tail are unmapped to get a huge page aligned base
+			const size_t alignment = virtual_memory__huge_page_size();
+			byte* mem = (byte*)mmap(null, size + alignment, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if ((ptr)mem == MAP_FAILED)
+				return null;
+
+			byte* base = (byte*)alloc_align_forward(mem, alignment);
+			const size_t head = base - mem;
+			const size_t tail = alignment - head;
+			if (head > 0)
+				munmap(mem, head);
+			if (tail > 0)
+				munmap(base + size, tail);
+	#ifdef MADV_HUGEPAGE
+			madvise(base, size, MADV_HUGEPAGE);
+	#endif
+			return base;
+#else
+			// platform without virtual memory support, memory is committed upfront
+			return alloc(size);
+#endif
+		}
+
+		bool virtual_memory__commit(ptr mem, const size_t size)
+		{
+#if PLATFORM_WINDOWS
+			return VirtualAlloc(mem, size, MEM_COMMIT, PAGE_READWRITE) != null;
+#elif PLATFORM_LINUX
+			return mprotect(mem, size, PROT_READ | PROT_WRITE) == 0;
+#else
+			return true;
+#endif
+		}
+
+		void virtual_memory__decommit(ptr mem, const size_t size)
+		{
+#if PLATFORM_WINDOWS
+			VirtualFree(mem, size, MEM_DECOMMIT);
+#elif PLATFORM_LINUX
+			madvise(mem, size, MADV_DONTNEED);
+			mprotect(mem, size, PROT_NONE);
+#endif
+		}
+
+		void virtual_memory__release(ptr mem, const size_t size)
+		{
+#if PLATFORM_WINDOWS
+			VirtualFree(mem, 0, MEM_RELEASE);
+#elif PLATFORM_LINUX
+			munmap(mem, size);
+#else
+			alloc_free(mem);
+#endif
+		}
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "../base_private.h"
+
+namespace rengine {
+	namespace core {
+		size_t virtual_memory__page_size();
+		size_t virtual_memory__huge_page_size();
+		// reserve address range without physical memory, returns null on failure
+		ptr virtual_memory__reserve(const size_t size, const bool huge_pages);
+		bool virtual_memory__commit(ptr mem, const size_t size);
+		// return physical pages to OS, address range is still reserved
+		void virtual_memory__decommit(ptr mem, const size_t size);
+		void virtual_memory__release(ptr mem, const size_t size);
+	}
+}
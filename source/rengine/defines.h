@@ -3,13 +3,44 @@
 
 #define CORE_ALLOC_DEFAULT_LIMIT 128 * 1000000 // default size is 128mb
 #define CORE_ALLOC_SCRATCH_BUFFER_SIZE 1000 * 64 // 64kb scratch buffer size
+#define CORE_ALLOC_DEFAULT_ALIGNMENT 8 // alignment guaranteed by core::alloc, use core::alloc_aligned for greater alignments
+#define CORE_CACHE_LINE_SIZE 64
+#define CORE_ALLOC_SLAB_MAX_SIZE 2048 // allocations greater than this size will bypass slabs
+#define CORE_ALLOC_SLAB_SPAN_SIZE 1024 * 64 // size of memory block requested to backend for each slab refill
+#define CORE_ALLOC_SLAB_BATCH_COUNT 32 // number of blocks moved between thread cache and central depot
 //#define HIGH_DEFINITION_PRECISION // enable high precision math types
 #define CORE_WINDOWS_MAX_ALLOWED 4
+#define CORE_ARENA_MAX_FRAMES_IN_FLIGHT 4
+#define CORE_ARENA_VIRTUAL_COMMIT_SIZE 1024 * 64 // min amount of memory committed by virtual arenas on each grow
 #define CORE_DEFAULT_HASH_SEED 0xFABDDFE
 #define CORE_HASH_PRIME 4094394974U
-#define CORE_MAX_PROFILER_ENTRIES 255 // Increate this number if you need more profiler entries
+#define CORE_HASH64_PRIME 0x9E3779B97F4A7C15ULL
+#define CORE_HASH64_STATE_SIZE 576 // size of XXH3 streaming state, checked against xxhash at compile time
+#define CORE_PROFILER_ZONE_PAGE_SIZE 256 // Number of zones of each page of profiler thread zone stack
+#define CORE_PROFILER_DELAYED_CHUNK_SIZE 1024 // Number of memory events of each chunk recorded before profiler starts
+#define CORE_PROFILER_DELAYED_MAX_CHUNKS 64 // Max chunks of memory events recorded before profiler starts, first chunk is static
+#define CORE_PROFILER_THREAD_NAME_SIZE 64 // Max size of profiler thread name, including null terminator
+#define CORE_PROFILER_TRACE_EVENTS 1024 * 64 // Number of events of each thread trace ring, must be power of two
+#define CORE_PROFILER_TRACE_MAGIC 0x43525452 // 'RTRC'
+#define CORE_PROFILER_TRACE_VERSION 1
+#define CORE_STRING_POOL_STRIPES 16 // Number of write locks of string pool, must be power of two
+#define CORE_STRING_POOL_PAGE_SIZE 1024 * 64 // size of first arena page of each string pool stripe
+#define CORE_STRING_POOL_INITIAL_CAPACITY 1024 // initial number of string pool table slots, must be power of two
+#define CORE_STRING_POOL_BATCH_SIZE 32 // Number of strings resolved at once by string_pool_intern_many
+#define CORE_JOB_SYSTEM_MAX_JOBS 4096 // Max number of in-flight jobs, must be power of two
+#define CORE_JOB_SYSTEM_MAX_WORKERS 64 // Max number of worker threads, including main thread
+#define CORE_JOB_SYSTEM_MAX_DEPENDENTS 16 // Max number of jobs that can wait for a single job
 
 #define IO_MAX_LOG_OBJECTS 0xFF
+#define IO_LOGGER_RING_SIZE 256 // Number of pending log records per thread, must be power of two
+#define IO_LOGGER_RECORD_TEXT_SIZE 256 // Bytes reserved for tag, message and string arguments of each log record
+#define IO_LOGGER_MAX_ARGS 8 // Max number of arguments captured by logger_log_fmt
+#define IO_LOGGER_BATCH_SIZE 64 // Max number of records popped from each thread ring at once
+#define IO_LOGGER_FLUSH_INTERVAL_MS 10 // Max time that logger thread sleeps before writing pending records
+#define IO_LOGGER_SITE_WINDOW_MS 1000 // Rate limit window of log_site
+#define IO_LOGGER_SITE_MAX_PER_WINDOW 4 // Max number of messages logged by each log_site per window
+
+#define EVENTS_MAX_POSTED_EVENTS 256 // Max number of events posted from other threads per bus until next dispatch, must be power of two
 
 // Max number of scissors allowed per render command
 #define GRAPHICS_MAX_SCISSORS 4
@@ -17,14 +48,13 @@
 #define GRAPHICS_MAX_RENDER_TARGETS 4
 #define GRAPHICS_MAX_VBUFFERS 2
 #define GRAPHICS_MAX_RENDER_COMMANDS 0xFF
-#define GRAPHICS_MAX_ALLOC_VBUFFERS 0xFF
-#define GRAPHICS_MAX_ALLOC_IBUFFERS 0xFF
-#define GRAPHICS_MAX_ALLOC_CBUFFERS 8
-#define GRAPHICS_MAX_ALLOC_RENDER_TARGETS 16
-#define GRAPHICS_MAX_ALLOC_TEX2D 0xFF
-#define GRAPHICS_MAX_ALLOC_TEX3D 1
-#define GRAPHICS_MAX_ALLOC_TEXCUBE 2
-#define GRAPHICS_MAX_ALLOC_TEXARRAY 1
+// resource pools grows by pages of this size, must be power of two
+#define GRAPHICS_BUFFER_POOL_PAGE_SIZE 64
+#define GRAPHICS_TEXTURE_POOL_PAGE_SIZE 64
+#define GRAPHICS_RENDER_TARGET_POOL_PAGE_SIZE 16
+
+#define GRAPHICS_FRAMES_IN_FLIGHT 3 // number of frames CPU can record ahead of GPU
+#define GRAPHICS_FRAME_STATS_HISTORY 120 // number of frames kept on frame stats history
 
 #define DRAWING_DEFAULT_TRIANGLE_COUNT 16
 #define DRAWING_DEFAULT_LINES_COUNT 10
@@ -47,6 +77,8 @@
 #else
 	#define MATH_EPSILON 1e-5f
 #endif
+#define MATH_BATCH_ALIGNMENT 64 // alignment of soa streams, enough for aligned loads of 16 floats
+#define MATH_BATCH_PADDING 8 // soa stream sizes are rounded to this count, then kernels can skip tail handling
 
 #ifdef PLATFORM_WINDOWS
 	#define GRAPHICS_BACKEND_DEFAULT rengine::graphics::backend::d3d11
@@ -67,15 +99,37 @@
 	#error "MAX_ALLOWED_WINDOWS must be less than 254"
 #endif
 
-#if GRAPHICS_MAX_ALLOC_VBUFFERS > 0xFF
-	#error "GRAPHICS_MAX_ALLOC_VBUFFERS must be less than 255, or you can increase vertex buffer size to u32"
+#if (MATH_BATCH_ALIGNMENT & (MATH_BATCH_ALIGNMENT - 1)) != 0 || MATH_BATCH_ALIGNMENT < 16
+	#error "MATH_BATCH_ALIGNMENT must be power of two and at least 16"
+#endif
+#if (MATH_BATCH_PADDING & (MATH_BATCH_PADDING - 1)) != 0 || MATH_BATCH_PADDING < 4
+	#error "MATH_BATCH_PADDING must be power of two and at least 4"
+#endif
+
+#if GRAPHICS_FRAMES_IN_FLIGHT > CORE_ARENA_MAX_FRAMES_IN_FLIGHT
+	#error "GRAPHICS_FRAMES_IN_FLIGHT must be less or equal than CORE_ARENA_MAX_FRAMES_IN_FLIGHT"
+#endif
+
+#if (CORE_JOB_SYSTEM_MAX_JOBS & (CORE_JOB_SYSTEM_MAX_JOBS - 1)) != 0
+	#error "CORE_JOB_SYSTEM_MAX_JOBS must be power of two"
 #endif
-#if GRAPHICS_MAX_ALLOC_IBUFFERS > 0xFF
-	#error "GRAPHICS_MAX_ALLOC_IBUFFERS must be less than 255, or you can increase index buffer size to u32"
+#if CORE_JOB_SYSTEM_MAX_JOBS > 0xFFFF
+	#error "CORE_JOB_SYSTEM_MAX_JOBS must be less than 65535, job handles stores index on 16 bits"
 #endif
-#if GRAPHICS_MAX_ALLOC_CBUFFERS > 0xFF
-	#error "GRAPHICS_MAX_ALLOC_CBUFFERS must be less than 255, or you can increase constant buffer size to u32"
-	#error "Do you really need more than 255 allocated constant buffers ?"
+#if ((CORE_PROFILER_TRACE_EVENTS) & ((CORE_PROFILER_TRACE_EVENTS) - 1)) != 0
+	#error "CORE_PROFILER_TRACE_EVENTS must be power of two"
+#endif
+#if (CORE_STRING_POOL_STRIPES & (CORE_STRING_POOL_STRIPES - 1)) != 0
+	#error "CORE_STRING_POOL_STRIPES must be power of two"
+#endif
+#if (CORE_STRING_POOL_INITIAL_CAPACITY & (CORE_STRING_POOL_INITIAL_CAPACITY - 1)) != 0
+	#error "CORE_STRING_POOL_INITIAL_CAPACITY must be power of two"
+#endif
+#if (IO_LOGGER_RING_SIZE & (IO_LOGGER_RING_SIZE - 1)) != 0
+	#error "IO_LOGGER_RING_SIZE must be power of two"
+#endif
+#if IO_LOGGER_RECORD_TEXT_SIZE > 0xFFFF
+	#error "IO_LOGGER_RECORD_TEXT_SIZE must be less than 65535, record offsets are stored on 16 bits"
 #endif
 
 #if _DEBUG
@@ -83,6 +137,14 @@
 #endif
 
 #define ENGINE_SSE 1
+// runtime selection of avx2 and avx512 math kernels by cpuid
+#define ENGINE_SIMD_DISPATCH 1
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define ENGINE_SIMD_X86 1
+#else
+	#define ENGINE_SIMD_X86 0
+#endif
 #define ENGINE_PROFILER 1
 
 #define nameof(name) (#name)
\ No newline at end of file
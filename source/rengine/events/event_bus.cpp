@@ -0,0 +1,42 @@
+#include "./event_bus.h"
+
+#include <mutex>
+
+namespace rengine {
+	namespace events {
+		// buses are usually registered by static initialization, then state must be constant initialized
+		static std::mutex g_event_bus_lock;
+		static event_bus_base* g_event_buses = null;
+
+		void event_bus_register(event_bus_base* bus)
+		{
+			std::lock_guard<std::mutex> lock(g_event_bus_lock);
+			bus->next_bus = g_event_buses;
+			g_event_buses = bus;
+		}
+
+		void event_bus_unregister(event_bus_base* bus)
+		{
+			std::lock_guard<std::mutex> lock(g_event_bus_lock);
+			event_bus_base** link = &g_event_buses;
+			while (*link) {
+				if (*link == bus) {
+					*link = bus->next_bus;
+					break;
+				}
+				link = &(*link)->next_bus;
+			}
+			bus->next_bus = null;
+		}
+
+		void event_bus_dispatch_all()
+		{
+			// buses are expected to be static, registering while main thread is dispatching is not supported
+			event_bus_base* bus = g_event_buses;
+			while (bus) {
+				bus->dispatch();
+				bus = bus->next_bus;
+			}
+		}
+	}
+}
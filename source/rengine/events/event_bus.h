@@ -0,0 +1,228 @@
+#pragma once
+#include <rengine/api.h>
+#include <rengine/types.h>
+#include <rengine/core/allocator.h>
+#include <rengine/core/ring_queue.h>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rengine {
+	namespace events {
+		typedef u32 event_handle_t;
+		static constexpr event_handle_t no_event_handle = 0;
+
+		class event_bus_base;
+
+		R_EXPORT void event_bus_register(event_bus_base* bus);
+		R_EXPORT void event_bus_unregister(event_bus_base* bus);
+		// dispatch enqueued and posted events of all buses, engine calls it at begin and end of each frame
+		R_EXPORT void event_bus_dispatch_all();
+
+		class event_bus_base {
+		public:
+			event_bus_base() { event_bus_register(this); }
+			virtual ~event_bus_base() { event_bus_unregister(this); }
+			event_bus_base(const event_bus_base&) = delete;
+			event_bus_base& operator=(const event_bus_base&) = delete;
+
+			virtual void dispatch() = 0;
+
+			event_bus_base* next_bus{ null };
+		};
+
+		// contiguous growable storage, grows by power of two
+		template<typename T>
+		class event_array {
+		public:
+			~event_array() { release(); }
+
+			void push_back(T&& value) {
+				if (size_ == capacity_)
+					grow();
+				new (data_ + size_) T(std::move(value));
+				++size_;
+			}
+
+			void erase(u32 idx) {
+				for (u32 i = idx + 1; i < size_; ++i)
+					data_[i - 1] = std::move(data_[i]);
+				data_[--size_].~T();
+			}
+
+			void clear() {
+				for (u32 i = 0; i < size_; ++i)
+					data_[i].~T();
+				size_ = 0;
+			}
+
+			void release() {
+				clear();
+				if (data_)
+					core::alloc_free(data_);
+				data_ = null;
+				capacity_ = 0;
+			}
+
+			void swap(event_array& other) {
+				std::swap(data_, other.data_);
+				std::swap(size_, other.size_);
+				std::swap(capacity_, other.capacity_);
+			}
+
+			T& operator[](u32 idx) { return data_[idx]; }
+			const T& operator[](u32 idx) const { return data_[idx]; }
+			u32 size() const { return size_; }
+		private:
+			void grow() {
+				const u32 capacity = capacity_ == 0 ? 8 : capacity_ * 2;
+				T* data = core::alloc_array_alloc<T>(capacity, core::alloc_tag::events);
+				for (u32 i = 0; i < size_; ++i) {
+					new (data + i) T(std::move(data_[i]));
+					data_[i].~T();
+				}
+				if (data_)
+					core::alloc_free(data_);
+				data_ = data;
+				capacity_ = capacity;
+			}
+
+			T* data_{ null };
+			u32 size_{ 0 };
+			u32 capacity_{ 0 };
+		};
+
+		template<typename Fn>
+		class event_bus;
+
+		/*
+		* Typed event bus, subscribers are walked on contiguous storage
+		* and identified by stable handles.
+		* emit dispatches on caller thread, enqueue records the event to be dispatched
+		* on next engine dispatch and post does the same from any thread through a lock-free queue.
+		* Except by post, all methods must be called from main thread.
+		*/
+		template<typename... Args>
+		class event_bus<void(*)(Args...)> : public event_bus_base {
+		public:
+			typedef void(*callback_fn)(Args...);
+			// references are copied when event is queued
+			typedef std::tuple<std::remove_cvref_t<Args>...> event_data;
+
+			event_handle_t subscribe(callback_fn callback) {
+				if (!callback)
+					return no_event_handle;
+
+				const event_handle_t handle = ++last_handle_;
+				subscribers_.push_back({ callback, handle });
+				return handle;
+			}
+
+			void unsubscribe(event_handle_t handle) {
+				for (u32 i = 0; i < subscribers_.size(); ++i) {
+					if (subscribers_[i].handle != handle || !subscribers_[i].callback)
+						continue;
+					remove_at(i);
+					return;
+				}
+			}
+
+			void unsubscribe(callback_fn callback) {
+				for (u32 i = 0; i < subscribers_.size(); ++i) {
+					if (subscribers_[i].callback != callback)
+						continue;
+					remove_at(i);
+					return;
+				}
+			}
+
+			void emit(Args... args) {
+				++emit_depth_;
+				// subscribers added while emitting only receive next events
+				const u32 count = subscribers_.size();
+				for (u32 i = 0; i < count; ++i) {
+					const callback_fn callback = subscribers_[i].callback;
+					if (callback)
+						callback(args...);
+				}
+				if (--emit_depth_ == 0 && num_removed_ > 0)
+					compact();
+			}
+
+			// compatibility with EVENT_EMIT_BEGIN body
+			template<typename Fn>
+			void for_each(Fn&& fn) {
+				++emit_depth_;
+				const u32 count = subscribers_.size();
+				for (u32 i = 0; i < count; ++i) {
+					const callback_fn callback = subscribers_[i].callback;
+					if (callback)
+						fn(callback);
+				}
+				if (--emit_depth_ == 0 && num_removed_ > 0)
+					compact();
+			}
+
+			void enqueue(Args... args) {
+				pending_.push_back(event_data(args...));
+			}
+
+			// any thread, returns false when posted queue is full
+			bool post(Args... args) {
+				return posted_.try_push(event_data(args...));
+			}
+
+			void dispatch() override {
+				event_data data;
+				while (posted_.try_pop(data))
+					pending_.push_back(std::move(data));
+
+				// events enqueued by subscribers are dispatched on next call
+				dispatching_.swap(pending_);
+				for (u32 i = 0; i < dispatching_.size(); ++i) {
+					std::apply([this](auto&... event_args) {
+						emit(event_args...);
+					}, dispatching_[i]);
+				}
+				dispatching_.clear();
+			}
+
+			u32 size() const { return subscribers_.size() - num_removed_; }
+		private:
+			struct subscriber {
+				callback_fn callback;
+				event_handle_t handle;
+			};
+
+			void remove_at(u32 idx) {
+				// emit loop is walking by index, then slot is only cleared
+				if (emit_depth_ > 0) {
+					subscribers_[idx].callback = null;
+					++num_removed_;
+					return;
+				}
+				subscribers_.erase(idx);
+			}
+
+			void compact() {
+				u32 count = 0;
+				for (u32 i = 0; i < subscribers_.size(); ++i) {
+					if (subscribers_[i].callback)
+						subscribers_[count++] = subscribers_[i];
+				}
+				while (subscribers_.size() > count)
+					subscribers_.erase(subscribers_.size() - 1);
+				num_removed_ = 0;
+			}
+
+			event_array<subscriber> subscribers_;
+			event_array<event_data> pending_;
+			event_array<event_data> dispatching_;
+			core::mpsc_queue<event_data, EVENTS_MAX_POSTED_EVENTS> posted_;
+			event_handle_t last_handle_{ no_event_handle };
+			u32 emit_depth_{ 0 };
+			u32 num_removed_{ 0 };
+		};
+	}
+}
@@ -27,6 +27,7 @@ namespace rengine {
 		ENGINE_DEFINE_EXCEPTION(window_exception);
 		ENGINE_DEFINE_EXCEPTION(pool_exception);
 		ENGINE_DEFINE_EXCEPTION(profiler_exception);
+		ENGINE_DEFINE_EXCEPTION(job_system_exception);
 	}
 
 	namespace io {
@@ -120,9 +120,7 @@ namespace rengine {
         {
             if (buffer_id == g_buffer_mgr_state.dynamic_vbuffer) {
                 const auto log = g_buffer_mgr_state.log;
-                log->warn(
-                    fmt::format(strings::logs::g_buffer_mgr_realloc_internal_dyn_buffer, nameof(buffer_mgr_vbuffer_realloc), buffer_id, new_size).c_str()
-                );
+                log->warn_fmt(strings::logs::g_buffer_mgr_realloc_internal_dyn_buffer, nameof(buffer_mgr_vbuffer_realloc), buffer_id, new_size);
             }
 			return buffer_mgr__realloc(buffer_type::vertex_buffer, buffer_id, new_size);
         }
@@ -131,9 +129,7 @@ namespace rengine {
         {
             if (buffer_id == g_buffer_mgr_state.dynamic_ibuffer) {
                 const auto log = g_buffer_mgr_state.log;
-                log->warn(
-                    fmt::format(strings::logs::g_buffer_mgr_realloc_internal_dyn_buffer, nameof(buffer_mgr_vbuffer_realloc), buffer_id, new_size).c_str()
-                );
+                log->warn_fmt(strings::logs::g_buffer_mgr_realloc_internal_dyn_buffer, nameof(buffer_mgr_vbuffer_realloc), buffer_id, new_size);
             }
 			return buffer_mgr__realloc(buffer_type::index_buffer, buffer_id, new_size);
         }
@@ -43,9 +43,9 @@ namespace rengine {
 		R_EXPORT void buffer_mgr_ibuffer_unmap(const index_buffer_t& id);
 		R_EXPORT void buffer_mgr_cbuffer_unmap(const constant_buffer_t& id);
 
-		R_EXPORT u16 buffer_mgr_vbuffer_realloc(const vertex_buffer_t& buffer_id, u32 new_size);
-		R_EXPORT u16 buffer_mgr_ibuffer_realloc(const index_buffer_t& id, u32 new_size);
-		R_EXPORT u16 buffer_mgr_cbuffer_realloc(const constant_buffer_t& id, u32 new_size);
+		R_EXPORT vertex_buffer_t buffer_mgr_vbuffer_realloc(const vertex_buffer_t& buffer_id, u32 new_size);
+		R_EXPORT index_buffer_t buffer_mgr_ibuffer_realloc(const index_buffer_t& id, u32 new_size);
+		R_EXPORT constant_buffer_t buffer_mgr_cbuffer_realloc(const constant_buffer_t& id, u32 new_size);
 
 		R_EXPORT void buffer_mgr_vbuffer_free(const vertex_buffer_t& id);
         R_EXPORT void buffer_mgr_ibuffer_free(const index_buffer_t& id);
@@ -1,5 +1,6 @@
 #include "./buffer_manager_private.h"
 #include "./graphics_private.h"
+#include "./frame_stats_private.h"
 
 #include "../exceptions.h"
 #include "../strings.h"
@@ -27,9 +28,9 @@ namespace rengine {
 				buffer_mgr__free_buffer(buffer.value);
 
 			state.dynamic_vbuffer = no_vertex_buffer;
-			state.vertex_buffers.clear();
-			state.index_buffers.clear();
-			state.constant_buffers.clear();
+			state.vertex_buffers.release();
+			state.index_buffers.release();
+			state.constant_buffers.release();
 			g_buffer_mgr_state = {};
 		}
 
@@ -41,20 +42,10 @@ namespace rengine {
 			entry.handler->Release();
 		}
 
-		u16 buffer_mgr__encode_id(u8 idx, u8 magic)
-		{
-			return (idx << 8u) | idx;
-		}
-
-		u8 buffer_mgr__decode_id(u16 value)
-		{
-			return value >> 8u;
-		}
-
-		u16 buffer_mgr__try_create(const buffer_type& type, const buffer_create_desc& desc)
+		u32 buffer_mgr__try_create(const buffer_type& type, const buffer_create_desc& desc)
 		{
 			auto& state = g_buffer_mgr_state;
-			u16 buffer_id = 0;
+			u32 buffer_id = 0;
 			buffer_entry new_entry = {
 				buffer_mgr__create(type, desc),
 				buffer_map_type::none
@@ -76,15 +67,13 @@ namespace rengine {
 			return buffer_id;
 		}
 
-		void buffer_mgr__free(const buffer_type& type, u16 buffer_id)
+		void buffer_mgr__free(const buffer_type& type, u32 buffer_id)
 		{
 			const auto& state = g_buffer_mgr_state;
 			const auto log = state.log;
 			if (!buffer_mgr__is_valid(type, buffer_id)) {
-				log->warn(
-					fmt::format(strings::logs::g_buffer_mgr_free_invalid_buffer,
-						buffer_id).c_str()
-				);
+				log->warn_fmt(strings::logs::g_buffer_mgr_free_invalid_buffer,
+					buffer_id);
 				return;
 			}
 
@@ -94,7 +83,7 @@ namespace rengine {
 			buffer_mgr__remove_entry(type, buffer_id);
 		}
 
-		u16 buffer_mgr__realloc(const buffer_type& type, u16 buffer_id, u32 new_size)
+		u32 buffer_mgr__realloc(const buffer_type& type, u32 buffer_id, u32 new_size)
 		{
 			auto& state = g_buffer_mgr_state;
 
@@ -139,7 +128,7 @@ namespace rengine {
 			return buffer_id;
 		}
 
-		void buffer_mgr__update(const buffer_type& type, u16 buffer_id, ptr data, u32 size, u32 offset)
+		void buffer_mgr__update(const buffer_type& type, u32 buffer_id, ptr data, u32 size, u32 offset)
 		{
 			const auto& state = g_buffer_mgr_state;
 			const auto log = state.log;
@@ -150,23 +139,20 @@ namespace rengine {
 
 			const auto& desc = entry.handler->GetDesc();
 			if (desc.Usage != Diligent::USAGE_DYNAMIC) {
-				log->error(
-					fmt::format(strings::logs::g_buffer_mgr_cant_update_non_dyn,
-						buffer_id,
-						desc.Name,
-						strings::g_buffer_names[(u8)type]).c_str());
+				log->error_fmt(strings::logs::g_buffer_mgr_cant_update_non_dyn,
+					buffer_id,
+					desc.Name,
+					strings::g_buffer_names[(u8)type]);
 				return;
 			}
 
 			if (size > desc.Size) {
-				log->warn(
-					fmt::format(strings::logs::g_buffer_mgr_update_data_size_is_greater_than_buffer,
-						size,
-						buffer_id,
-						desc.Name,
-						desc.Size,
-						strings::g_buffer_names[(u8)type]).c_str()
-				);
+				log->warn_fmt(strings::logs::g_buffer_mgr_update_data_size_is_greater_than_buffer,
+					size,
+					buffer_id,
+					desc.Name,
+					desc.Size,
+					strings::g_buffer_names[(u8)type]);
 				size = desc.Size;
 			}
 
@@ -175,7 +161,7 @@ namespace rengine {
 			buffer_mgr__unmap(type, buffer_id);
 		}
 
-		ptr buffer_mgr__map(const buffer_type& type, u16 buffer_id, const buffer_map_type& map_type)
+		ptr buffer_mgr__map(const buffer_type& type, u32 buffer_id, const buffer_map_type& map_type)
 		{
 			if (map_type == buffer_map_type::none)
 				return null;
@@ -196,6 +182,10 @@ namespace rengine {
 						strings::g_buffer_names[(u8)type]).c_str()
 				);
 
+			// maps are discarded, then whole buffer is uploaded
+			if (map_type != buffer_map_type::read)
+				g_frame_stats_state.curr.uploaded_bytes += entry.handler->GetDesc().Size;
+
 			entry.map_type = map_type;
 			switch (type)
 			{
@@ -213,7 +203,7 @@ namespace rengine {
 			return mapped_data;
 		}
 
-		void buffer_mgr__unmap(const buffer_type& type, u16 buffer_id)
+		void buffer_mgr__unmap(const buffer_type& type, u32 buffer_id)
 		{
 			auto& state = g_buffer_mgr_state;
 			const auto log = state.log;
@@ -223,11 +213,9 @@ namespace rengine {
 			buffer_mgr__get_entry(type, buffer_id, &entry);
 
 			if (entry.map_type == buffer_map_type::none) {
-				log->warn(
-					fmt::format(strings::logs::g_buffer_mgr_cant_unmap,
-						buffer_id,
-						strings::g_buffer_names[(u8)type]).c_str()
-				);
+				log->warn_fmt(strings::logs::g_buffer_mgr_cant_unmap,
+					buffer_id,
+					strings::g_buffer_names[(u8)type]);
 				return;
 			}
 
@@ -295,7 +283,7 @@ namespace rengine {
 			return buffer;
 		}
 
-		bool buffer_mgr__is_valid(const buffer_type& type, u16 buffer_id)
+		bool buffer_mgr__is_valid(const buffer_type& type, u32 buffer_id)
 		{
 			bool result = false;
 			switch (type)
@@ -314,7 +302,7 @@ namespace rengine {
 			return result;
 		}
 
-		void buffer_mgr__get_handle(const buffer_type& type, u16 buffer_id, Diligent::IBuffer** output)
+		void buffer_mgr__get_handle(const buffer_type& type, u32 buffer_id, Diligent::IBuffer** output)
 		{
 			if (!output)
 				return;
@@ -371,7 +359,7 @@ namespace rengine {
 			}
 		}
 
-		void buffer_mgr__get_available_buffers(const buffer_type& type, u32* count, u16* buffers)
+		void buffer_mgr__get_available_buffers(const buffer_type& type, u32* count, u32* buffers)
 		{
 			const auto& state = g_buffer_mgr_state;
 			u32 counters[] = {
@@ -384,32 +372,18 @@ namespace rengine {
 			if (buffers == null)
 				return;
 
-			const core::pool_entry<buffer_entry, u16>* buffer_data[] = {
-				state.vertex_buffers.data(),
-				state.index_buffers.data(),
-				state.constant_buffers.data()
+			const core::paged_pool<buffer_entry, GRAPHICS_BUFFER_POOL_PAGE_SIZE>* pools[] = {
+				&state.vertex_buffers,
+				&state.index_buffers,
+				&state.constant_buffers
 			};
 
-			for (u32 i = 0; i < *count; ++i)
-				buffers[i] = buffer_data[(u8)type][i].id;
+			u32 idx = 0;
+			for (const auto& entry : *pools[(u8)type])
+				buffers[idx++] = entry.id;
 		}
 		
-		u8 buffer_mgr__assert_id(const buffer_type& type, u16 id) {
-			if (buffer_mgr__is_valid(type, id))
-				return buffer_mgr__decode_id(id);
-
-			const u32 buffer_sizes[] = {
-				GRAPHICS_MAX_ALLOC_VBUFFERS,
-				GRAPHICS_MAX_ALLOC_IBUFFERS,
-				GRAPHICS_MAX_ALLOC_CBUFFERS
-			};
-			throw graphics_exception(
-				fmt::format(strings::exceptions::g_buffer_mgr_invalid_id,
-					buffer_sizes[(u8)type]).c_str()
-			);
-		}
-
-		void buffer_mgr__get_entry(const buffer_type& type, u16 id, buffer_entry* output)
+		void buffer_mgr__get_entry(const buffer_type& type, u32 id, buffer_entry* output)
 		{
 			switch (type)
 			{
@@ -434,7 +408,7 @@ namespace rengine {
 			}
 		}
 
-		void buffer_mgr__remove_entry(const buffer_type& type, u16 id)
+		void buffer_mgr__remove_entry(const buffer_type& type, u32 id)
 		{
 			auto& state = g_buffer_mgr_state;
 			switch (type)
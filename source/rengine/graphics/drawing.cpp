@@ -23,11 +23,7 @@ namespace rengine {
 			auto& state = g_drawing_state;
 			drawing__compute_transform();
 			
-			vertex_uv_data vertex;
-			vertex.point = math::matrix4x4::mul(state.current_transform.transform, point);
-			vertex.color = state.current_color;
-			vertex.uv = state.current_uv;
-			g_drawing_state.vertex_queue.push(vertex);
+			drawing__push_vertex(math::matrix4x4::mul(state.current_transform.transform, point));
 		}
 
 		void drawing_set_uv(const math::vec2& uv)
@@ -158,25 +154,11 @@ namespace rengine {
 
 		void drawing_draw_rect(const math::vec3& left_top, const math::vec3& right_top, const math::vec3& right_bottom, const math::vec3& left_bottom)
 		{
-			drawing_set_uv({ 0., 1. });
-			drawing_push_vertex(left_bottom);
-
-			drawing_set_uv({ 0., 0. });
-			drawing_push_vertex(left_top);
-
-			drawing_set_uv({ 1., 0. });
-			drawing_push_vertex(right_top);
-			drawing_draw_triangle();
-
-			drawing_set_uv({ 1., 0. });
-			drawing_push_vertex(right_top);
-
-			drawing_set_uv({ 1., 1. });
-			drawing_push_vertex(right_bottom);
+			drawing__compute_transform();
 
-			drawing_set_uv({ 0., 1.});
-			drawing_push_vertex(left_bottom);
-			drawing_draw_triangle();
+			math::vec3 corners[] = { left_top, right_top, right_bottom, left_bottom };
+			math::transform_points(g_drawing_state.current_transform.transform, corners, corners, _countof(corners));
+			drawing__draw_transformed_rect(corners);
 		}
 
 		void drawing_draw_quad_lines(const math::vec3& center, const math::vec2& size)
@@ -209,16 +191,20 @@ namespace rengine {
 				tmp_vertices.data(),
 				required_size * sizeof(vertex_data));
 
-			for (u32 i = 0; i < required_size; i += 4) {
-				vertex_data left_top = tmp_vertices[i + 0];
-				vertex_data right_top = tmp_vertices[i + 1];
-				vertex_data right_bottom = tmp_vertices[i + 2];
-				vertex_data left_bottom = tmp_vertices[i + 3];
+			// transform all glyph quads at once, then push already transformed corners
+			static vector<math::vec3> tmp_points;
+			tmp_points.resize(required_size);
+			for (u32 i = 0; i < required_size; ++i)
+				tmp_points[i] = tmp_vertices[i].point;
+
+			drawing__compute_transform();
+			math::transform_points(state.current_transform.transform, tmp_points.data(), tmp_points.data(), required_size);
 
-				drawing_draw_rect(left_top.point, right_top.point, right_bottom.point, left_bottom.point);
-			}
+			for (u32 i = 0; i + 3 < required_size; i += 4)
+				drawing__draw_transformed_rect(tmp_points.data() + i);
 
 			tmp_vertices.reset();
+			tmp_points.reset();
 		}
 
 		void renderer_add_cube(const cube& cube)
@@ -24,7 +24,7 @@ namespace rengine {
 
 		ptr DrawingAllocator::allocate(size_t size, size_t alignment, size_t offset, int flags) {
 			auto arena = g_drawing_state.arena;
-			return arena->alloc(size);
+			return arena->alloc_aligned(size, alignment);
 		}
 
 		void DrawingAllocator::deallocate(ptr p, size_t size) {
@@ -37,7 +37,7 @@ namespace rengine {
 			size += DRAWING_DEFAULT_POINTS_COUNT * sizeof(vertex_data);
 
 			g_drawing_state.log = io::logger_use(strings::logs::g_drawing_cmd_tag);
-			g_drawing_state.arena = core::arena_create_frame(size);
+			g_drawing_state.arena = core::arena_create_frame_ring(size, GRAPHICS_FRAMES_IN_FLIGHT, core::alloc_tag::drawing);
 
 			drawing__require_vbuffer_size(size);
 			drawing__compile_shaders();
@@ -279,14 +279,58 @@ namespace rengine {
 				math::vec3(state.current_transform.scale.x, state.current_transform.scale.y, 1));
 		}
 
+		void drawing__push_vertex(const math::vec3& point)
+		{
+			auto& state = g_drawing_state;
+			vertex_uv_data vertex;
+			vertex.point = point;
+			vertex.color = state.current_color;
+			vertex.uv = state.current_uv;
+			state.vertex_queue.push(vertex);
+		}
+
+		void drawing__draw_transformed_rect(const math::vec3* corners)
+		{
+			const auto& left_top = corners[0];
+			const auto& right_top = corners[1];
+			const auto& right_bottom = corners[2];
+			const auto& left_bottom = corners[3];
+
+			drawing_set_uv({ 0., 1. });
+			drawing__push_vertex(left_bottom);
+
+			drawing_set_uv({ 0., 0. });
+			drawing__push_vertex(left_top);
+
+			drawing_set_uv({ 1., 0. });
+			drawing__push_vertex(right_top);
+			drawing_draw_triangle();
+
+			drawing_set_uv({ 1., 0. });
+			drawing__push_vertex(right_top);
+
+			drawing_set_uv({ 1., 1. });
+			drawing__push_vertex(right_bottom);
+
+			drawing_set_uv({ 0., 1.});
+			drawing__push_vertex(left_bottom);
+			drawing_draw_triangle();
+		}
+
 		void drawing__begin_draw()
 		{
 			profile_begin_name(nameof(drawing));
 
 			auto& state = g_drawing_state;
 			state.vertex_queue.clear();
-			state.arena->reset();
-			state.arena->destroy_block();
+			// previous frames memory may still be in use by GPU,
+			// move to next frame arena once per engine frame
+			const auto curr_frame = g_engine_state.time.curr_frame;
+			if (state.arena_frame != curr_frame)
+				state.arena->next_frame();
+			else
+				state.arena->reset();
+			state.arena_frame = curr_frame;
 
 			auto prev_capacity = state.triangles.capacity();
 			state.triangles.reset_lose_memory();
@@ -61,7 +61,8 @@ namespace rengine {
 		struct drawing_state
 		{
 			io::ILog* log;
-			core::IFrameArena* arena;
+			core::IFrameRingArena* arena;
+			u64 arena_frame{ 0 };
 
 			core::fixed_queue<vertex_uv_data, 3, u8> vertex_queue;
 
@@ -96,6 +97,10 @@ namespace rengine {
 		void drawing__draw_lines();
 		void drawing__draw_points();
 		void drawing__compute_transform();
+		// point must be already transformed
+		void drawing__push_vertex(const math::vec3& point);
+		// corners are left top, right top, right bottom and left bottom, already transformed
+		void drawing__draw_transformed_rect(const math::vec3* corners);
 
 		void drawing__begin_draw();
 		void drawing__end_draw();
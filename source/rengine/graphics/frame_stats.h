@@ -0,0 +1,30 @@
+#pragma once
+#include <rengine/api.h>
+#include <rengine/types.h>
+
+namespace rengine {
+	namespace graphics {
+		struct frame_stats {
+			u32 num_draws{ 0 };
+			u64 num_primitives{ 0 };
+			u32 num_pipeline_binds{ 0 };
+			u32 num_srb_commits{ 0 };
+			u32 num_vbuffer_binds{ 0 };
+			// state sets skipped because same state was already bound
+			u32 num_redundant_sets{ 0 };
+			u64 uploaded_bytes{ 0 };
+			u32 num_pipelines_created{ 0 };
+			u32 num_srbs_created{ 0 };
+		};
+
+		// stats of last completed frame
+		R_EXPORT const frame_stats& get_frame_stats();
+		/*
+		* Rolling history of last GRAPHICS_FRAME_STATS_HISTORY frames,
+		* frames_ago = 0 is the last completed frame.
+		* Frames older than history size returns empty stats.
+		*/
+		R_EXPORT const frame_stats& get_frame_stats_history(u32 frames_ago);
+		R_EXPORT u32 get_frame_stats_history_size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "./frame_stats_private.h"
+#include "../core/profiler_private.h"
+
+namespace rengine {
+	namespace graphics {
+		frame_stats_state g_frame_stats_state = {};
+
+		void frame_stats__begin_frame()
+		{
+			auto& state = g_frame_stats_state;
+			const auto& stats = state.curr;
+
+			state.history_head = (state.history_head + 1) % GRAPHICS_FRAME_STATS_HISTORY;
+			state.history[state.history_head] = stats;
+			if (state.num_frames < GRAPHICS_FRAME_STATS_HISTORY)
+				++state.num_frames;
+
+			core::profiler__plot(strings::profiler::frame_draws, stats.num_draws);
+			core::profiler__plot(strings::profiler::frame_primitives, stats.num_primitives);
+			core::profiler__plot(strings::profiler::frame_pipeline_binds, stats.num_pipeline_binds);
+			core::profiler__plot(strings::profiler::frame_srb_commits, stats.num_srb_commits);
+			core::profiler__plot(strings::profiler::frame_vbuffer_binds, stats.num_vbuffer_binds);
+			core::profiler__plot(strings::profiler::frame_redundant_sets, stats.num_redundant_sets);
+			core::profiler__plot(strings::profiler::frame_uploaded_bytes, stats.uploaded_bytes);
+			core::profiler__plot(strings::profiler::frame_pipelines_created, stats.num_pipelines_created);
+			core::profiler__plot(strings::profiler::frame_srbs_created, stats.num_srbs_created);
+
+			state.curr = {};
+		}
+
+		u64 frame_stats__count_primitives(primitive_topology topology, u32 num_vertices, u32 num_instances)
+		{
+			u64 num_primitives = 0;
+			switch (topology)
+			{
+			case primitive_topology::triangle_list:
+				num_primitives = num_vertices / 3;
+				break;
+			case primitive_topology::triangle_strip:
+				num_primitives = num_vertices > 2 ? num_vertices - 2 : 0;
+				break;
+			case primitive_topology::point_list:
+				num_primitives = num_vertices;
+				break;
+			case primitive_topology::line_list:
+				num_primitives = num_vertices / 2;
+				break;
+			case primitive_topology::line_strip:
+				num_primitives = num_vertices > 1 ? num_vertices - 1 : 0;
+				break;
+			}
+			return num_primitives * num_instances;
+		}
+
+		const frame_stats& get_frame_stats()
+		{
+			return get_frame_stats_history(0);
+		}
+
+		const frame_stats& get_frame_stats_history(u32 frames_ago)
+		{
+			static const frame_stats empty_stats = {};
+			const auto& state = g_frame_stats_state;
+			if (frames_ago >= state.num_frames)
+				return empty_stats;
+
+			const u32 idx = (state.history_head + GRAPHICS_FRAME_STATS_HISTORY - frames_ago) % GRAPHICS_FRAME_STATS_HISTORY;
+			return state.history[idx];
+		}
+
+		u32 get_frame_stats_history_size()
+		{
+			return g_frame_stats_state.num_frames;
+		}
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "../base_private.h"
+#include "./frame_stats.h"
+
+namespace rengine {
+	namespace graphics {
+		// graphics calls are made only from main thread, counters doesn't need to be atomic
+		struct frame_stats_state {
+			frame_stats curr{};
+			frame_stats history[GRAPHICS_FRAME_STATS_HISTORY]{};
+			u32 history_head{ 0 };
+			u32 num_frames{ 0 };
+		};
+		extern frame_stats_state g_frame_stats_state;
+
+		// moves current frame stats to history and send them to profiler plots
+		void frame_stats__begin_frame();
+		u64 frame_stats__count_primitives(primitive_topology topology, u32 num_vertices, u32 num_instances);
+	}
+}
\ No newline at end of file
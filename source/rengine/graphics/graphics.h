@@ -8,6 +8,7 @@
 #include <rengine/graphics/render_target_manager.h>
 #include <rengine/graphics/texture_manager.h>
 #include <rengine/graphics/imgui_manager.h>
+#include <rengine/graphics/frame_stats.h>
 
 namespace rengine {
 	namespace graphics {
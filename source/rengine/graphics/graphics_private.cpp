@@ -12,6 +12,7 @@
 #include "./render_command_private.h"
 #include "./shader_manager_private.h"
 #include "./texture_manager_private.h"
+#include "./frame_stats_private.h"
 
 #include "./imgui_manager_private.h"
 
@@ -19,6 +20,7 @@
 #include "../core/window_graphics_private.h"
 #include "../core/window_private.h"
 #include "../core/profiler.h"
+#include "../core/arena.h"
 
 #include "../defines.h"
 #include "../exceptions.h"
@@ -56,7 +58,7 @@ namespace rengine {
 				size += dbg_file_name_len * sizeof(char);
 			}
 #endif
-			ptr raw_mem = core::alloc(size);
+			ptr raw_mem = core::alloc(size, core::alloc_tag::diligent);
 #if ENGINE_DEBUG
 			diligent_memory_header* header = static_cast<diligent_memory_header*>(raw_mem);
 			u8* target_mem = static_cast<u8*>(raw_mem) + sizeof(diligent_memory_header);
@@ -151,6 +153,7 @@ namespace rengine {
 			};
 			action_t init_calls[] = {
 				calculate_msaa_levels,
+				allocate_frame_fence,
 				pipeline_state_mgr__init,
 				buffer_mgr__init,
 				render_target_mgr__init,
@@ -186,6 +189,7 @@ namespace rengine {
 				shader_mgr__deinit,
 				srb_mgr__deinit,
 				pipeline_state_mgr__deinit,
+				release_frame_fence,
 			};
 
 			for (auto i = 0; i < _countof(deinit_calls); ++i)
@@ -199,6 +203,7 @@ namespace rengine {
 
 		void begin() {
 			profile_begin_name(strings::profiler::graphics_loop);
+			frame_stats__begin_frame();
 
 			const auto& window = g_engine_state.window_id;
 			if (window == core::no_window)
@@ -237,6 +242,7 @@ namespace rengine {
 
 			blit_2_swapchain(swapchain->GetCurrentBackBufferRTV()->GetTexture());
 			present_swapchain(swapchain);
+			signal_frame_fence();
 		}
 
 		void calculate_msaa_levels()
@@ -299,6 +305,57 @@ namespace rengine {
 				});
 		}
 
+		void allocate_frame_fence()
+		{
+			auto& state = g_graphics_state;
+			Diligent::FenceDesc desc = {};
+			desc.Name = strings::graphics::g_frame_fence_name;
+			desc.Type = Diligent::FENCE_TYPE_CPU_WAIT_ONLY;
+
+			state.device->CreateFence(desc, &state.frame_fence);
+			if (!state.frame_fence)
+				throw graphics_exception(strings::exceptions::g_graphics_fail_to_create_g_objects);
+
+			state.frame_fence_value = 0;
+			core::arena_set_frame_fence({
+				frame_fence__submitted,
+				frame_fence__completed,
+				frame_fence__wait,
+				null,
+			});
+		}
+
+		void release_frame_fence()
+		{
+			auto& state = g_graphics_state;
+			core::arena_set_frame_fence({});
+			if (state.frame_fence)
+				state.frame_fence->Release();
+			state.frame_fence = null;
+		}
+
+		void signal_frame_fence()
+		{
+			auto& state = g_graphics_state;
+			state.contexts[0]->EnqueueSignal(state.frame_fence, ++state.frame_fence_value);
+		}
+
+		u64 frame_fence__submitted(ptr user_data)
+		{
+			return g_graphics_state.frame_fence_value;
+		}
+
+		u64 frame_fence__completed(ptr user_data)
+		{
+			return g_graphics_state.frame_fence->GetCompletedValue();
+		}
+
+		void frame_fence__wait(u64 value, ptr user_data)
+		{
+			profile();
+			g_graphics_state.frame_fence->Wait(value);
+		}
+
 		void verify_graphics_resources()
 		{
 			profile();
@@ -8,6 +8,7 @@
 #include <RenderDevice.h>
 #include <GraphicsTypes.h>
 #include <MemoryAllocator.h>
+#include <Fence.h>
 
 #define GRAPHICS_VERSION Diligent::Version { 11, 0 }
 
@@ -48,6 +49,10 @@ namespace rengine {
 			backend backend;
 			graphics_buffers buffers;
 
+			// signaled at the end of each frame, used to recycle per-frame memory
+			Diligent::IFence* frame_fence{ null };
+			u64 frame_fence_value{ 0 };
+
 			bool vsync{ false };
 			graphics_msaa msaa{};
 		};
@@ -72,6 +77,12 @@ namespace rengine {
 		void calculate_msaa_levels();
 		void allocate_swapchain(const core::window_t& window_id);
 		void allocate_buffers();
+		void allocate_frame_fence();
+		void release_frame_fence();
+		void signal_frame_fence();
+		u64 frame_fence__submitted(ptr user_data);
+		u64 frame_fence__completed(ptr user_data);
+		void frame_fence__wait(u64 value, ptr user_data);
 		void verify_graphics_resources();
 		void prepare_viewport(const core::window_t& window_id);
 		void prepare_viewport_rt();
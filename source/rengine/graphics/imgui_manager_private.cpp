@@ -14,7 +14,7 @@ namespace rengine {
 
 		ptr imgui_manager__malloc(size_t size, ptr user_data)
 		{
-			ptr result = core::alloc(size);
+			ptr result = core::alloc(size, core::alloc_tag::imgui);
 			// TODO: fix ImVertData, unfortunately ImGui doesn't initialize ImVert struct
 			memset(result, 0, size);
 			return result;
@@ -386,7 +386,8 @@ namespace rengine {
 		{
 			ImEngineTextureData data;
 			data.value = tex_id;
-			auto tex_slot = strings::graphics::g_imgui_mgr_tex_slot;
+			// slot hash is resolved at compile time, this runs once per draw command
+			constexpr auto tex_slot = core::const_hash(strings::graphics::g_imgui_mgr_tex_slot);
 
 			switch (data.type)
 			{
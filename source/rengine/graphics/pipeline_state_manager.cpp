@@ -9,43 +9,61 @@ namespace rengine {
     namespace graphics {
         pipeline_state_t pipeline_state_mgr_create_graphics(const graphics_pipeline_state_create& create_info)
         {
-            auto& state = g_pipeline_state_mgr_state;
-            const auto pipeline_id = pipeline_state_mgr_graphics_hash_desc(create_info);
-            const auto& it = state.pipelines.find_as(pipeline_id);
-            if (it != state.pipelines.end())
+            const auto hash = pipeline_state_mgr_graphics_hash_desc(create_info);
+            const auto pipeline_id = pipeline_state_mgr__find(hash, create_info);
+            if (pipeline_id != no_pipeline_state)
                 return pipeline_id;
 
             const auto pipeline = pipeline_state_mgr__create_graphics(create_info);
             if (!pipeline)
                 throw graphics_exception(strings::exceptions::g_shader_mgr_fail_to_create_shader);
 
-            state.pipelines[pipeline_id] = pipeline;
-            ++state.pipeline_count;
-            return pipeline_id;
+            return pipeline_state_mgr__store(hash, create_info, pipeline);
         }
         
-        core::hash_t pipeline_state_mgr_graphics_hash_desc(const graphics_pipeline_state_create& create_info)
+        core::hash64_t pipeline_state_mgr_graphics_hash_desc(const graphics_pipeline_state_create& create_info)
         {
-            const u16* rt_formats = create_info.render_target_formats;
-            core::hash_t result = core::hash(create_info.name);
-            result = core::hash_combine(result, core::hash(rt_formats, (u32)create_info.num_render_targets));
-            result = core::hash_combine(result, create_info.depth_stencil_format);
-            result = core::hash_combine(result, create_info.num_render_targets);
-            result = core::hash_combine(result, (u32)create_info.topology);
-            result = core::hash_combine(result, (u32)create_info.cull);
-            result = core::hash_combine(result, (u32)create_info.blend_mode);
-            result = core::hash_combine(result, create_info.constant_depth_bias);
-            result = core::hash_combine(result, create_info.slope_scaled_depth_bias);
-            result = core::hash_combine(result, pipeline_state_mgr__hash_depth_desc(create_info.depth_desc));
-            result = core::hash_combine(result, create_info.color_write);
-            result = core::hash_combine(result, create_info.alpha_to_coverage);
-            result = core::hash_combine(result, create_info.wireframe);
-            result = core::hash_combine(result, create_info.num_immutable_samplers);
+            const auto& depth = create_info.depth_desc;
+            core::hash64_stream stream;
+            stream.update_str(create_info.name);
+            stream.update_value(create_info.num_render_targets);
+            stream.update(create_info.render_target_formats, sizeof(u16) * create_info.num_render_targets);
+            stream.update_value(create_info.depth_stencil_format);
+            stream.update_value(create_info.topology);
+            stream.update_value(create_info.cull);
+            stream.update_value(create_info.msaa_level);
+            stream.update_value(create_info.blend_mode);
+            stream.update_value(depth.depth_enabled);
+            stream.update_value(depth.depth_write);
+            stream.update_value(depth.stencil_test);
+            stream.update_value(depth.depth_cmp_func);
+            stream.update_value(depth.stencil_cmp_func);
+            stream.update_value(depth.stencil_on_passed);
+            stream.update_value(depth.stencil_on_stencil_failed);
+            stream.update_value(depth.stencil_on_fail);
+            stream.update_value(depth.stencil_cmp_mask);
+            stream.update_value(depth.stencil_write_mask);
+            stream.update_value(create_info.color_write);
+            stream.update_value(create_info.alpha_to_coverage);
+            stream.update_value(create_info.wireframe);
+            stream.update_value(create_info.scissors);
+            stream.update_value(create_info.constant_depth_bias);
+            stream.update_value(create_info.slope_scaled_depth_bias);
+            stream.update_value(create_info.shader_program);
+            stream.update_value(create_info.num_immutable_samplers);
 			for (u32 i = 0; i < create_info.num_immutable_samplers; ++i) {
 				const auto& sampler = create_info.immutable_samplers[i];
-                result = core::hash_combine(result, pipeline_state_mgr__hash_immutable_sampler(sampler));
+                stream.update_str(sampler.name);
+                stream.update_value(sampler.shader_type_flags);
+                stream.update_value(sampler.desc.filter);
+                stream.update_value(sampler.desc.address);
+                stream.update_value(sampler.desc.lod_bias);
+                stream.update_value(sampler.desc.min_lod);
+                stream.update_value(sampler.desc.max_lod);
+                stream.update_value(sampler.desc.max_anisotropy);
+                stream.update_value(sampler.desc.comparison);
 			}
-            return result;
+            return stream.digest();
         }
 
         ptr pipeline_state_mgr_get_internal_handle(pipeline_state_t id)
@@ -57,15 +75,19 @@ namespace rengine {
 
         u32 pipeline_state_mgr_get_cache_count()
         {
-            return g_pipeline_state_mgr_state.pipeline_count;
+            return (u32)g_pipeline_state_mgr_state.pipelines.size();
         }
 
         void pipeline_state_mgr_clear_cache()
         {
-            for (const auto& it : g_pipeline_state_mgr_state.pipelines)
-                it.second->Release();
+            auto& state = g_pipeline_state_mgr_state;
+            for (const auto& entry : state.pipelines)
+                entry.handle->Release();
 
-            g_pipeline_state_mgr_state.pipeline_count = 0;
+            // stale ids must not alias pipelines created after clear
+            state.first_id += (pipeline_state_t)state.pipelines.size();
+            state.pipelines.clear();
+            state.pipeline_tbl.clear();
         }
     }
 }
@@ -1,6 +1,7 @@
 #include "./pipeline_state_manager_private.h"
 #include "./shader_manager_private.h"
 #include "./graphics_private.h"
+#include "./frame_stats_private.h"
 #include "./buffer_manager_private.h"
 #include "./render_target_manager.h"
 
@@ -24,7 +25,8 @@ namespace rengine {
 
 		Diligent::IPipelineState* pipeline_state_mgr__create_graphics(const graphics_pipeline_state_create& create_info)
 		{
-			const auto arena = g_pipeline_state_mgr_state.arena;
+			// input layout, srv and immutable samplers are allocated from scratch
+			core::scratch_scope scratch(g_pipeline_state_mgr_state.arena);
 
 			using namespace Diligent;
 			const auto device = g_graphics_state.device;
@@ -58,18 +60,11 @@ namespace rengine {
 			IPipelineState* pipeline = null;
 			device->CreateGraphicsPipelineState(ci, &pipeline);
 
-			// free scratch memory
-			if (ci.GraphicsPipeline.InputLayout.NumElements > 0)
-				arena->free(sizeof(Diligent::LayoutElement) * VERTEX_ELEMENT_COUNT);
-			if (ci.PSODesc.ResourceLayout.NumVariables > 0)
-				arena->free(sizeof(Diligent::ShaderResourceVariableDesc) * GRAPHICS_MAX_BOUND_CBUFFERS);
-			if (ci.PSODesc.ResourceLayout.NumImmutableSamplers > 0)
-				arena->free(sizeof(Diligent::ImmutableSamplerDesc) * GRAPHICS_MAX_BOUND_TEXTURES);
-
 			if (!pipeline)
 				return null;
 
 			pipeline_state_mgr__bind_cbuffers(pipeline);
+			++g_frame_stats_state.curr.num_pipelines_created;
 			return pipeline;
 		}
 
@@ -314,10 +309,107 @@ namespace rengine {
 			if (!output)
 				return;
 
-			const auto& it = state.pipelines.find_as(id);
-			if (it == state.pipelines.end())
+			// ids from cleared pipelines are behind first id
+			if (id < state.first_id || id - state.first_id >= state.pipelines.size())
 				return;
-			*output = it->second;
+			*output = state.pipelines[id - state.first_id].handle;
+		}
+
+		pipeline_state_t pipeline_state_mgr__find(core::hash64_t hash, const graphics_pipeline_state_create& create_info)
+		{
+			auto& state = g_pipeline_state_mgr_state;
+			const auto& it = state.pipeline_tbl.find(hash);
+			if (it == state.pipeline_tbl.end()) {
+				core::hash__cache_miss(state.cache_stats);
+				return no_pipeline_state;
+			}
+
+			if (!pipeline_state_mgr__equals(state.pipelines[it->second - state.first_id], create_info)) {
+				core::hash__cache_collision(state.cache_stats);
+				return no_pipeline_state;
+			}
+
+			core::hash__cache_hit(state.cache_stats);
+			return it->second;
+		}
+
+		pipeline_state_t pipeline_state_mgr__store(core::hash64_t hash, const graphics_pipeline_state_create& create_info, Diligent::IPipelineState* pipeline)
+		{
+			auto& state = g_pipeline_state_mgr_state;
+			const pipeline_state_t id = state.first_id + (pipeline_state_t)state.pipelines.size();
+			auto& entry = state.pipelines.push_back();
+			entry.hash = hash;
+			entry.desc = create_info;
+			entry.name = create_info.name ? create_info.name : strings::g_empty;
+			// pointers from create info are not owned, key must keep its own copy
+			entry.desc.name = null;
+			entry.desc.immutable_samplers = null;
+			entry.samplers.resize(create_info.num_immutable_samplers);
+			for (u32 i = 0; i < create_info.num_immutable_samplers; ++i) {
+				const auto& sampler = create_info.immutable_samplers[i];
+				auto& sampler_key = entry.samplers[i];
+				sampler_key.name = sampler.name ? sampler.name : strings::g_empty;
+				sampler_key.shader_type_flags = sampler.shader_type_flags;
+				sampler_key.desc = sampler.desc;
+			}
+			entry.handle = pipeline;
+
+			// on collision, first entry remains on table and new one is reachable only by id
+			if (state.pipeline_tbl.find(hash) == state.pipeline_tbl.end())
+				state.pipeline_tbl[hash] = id;
+			return id;
+		}
+
+		bool pipeline_state_mgr__equals(const pipeline_state_entry& entry, const graphics_pipeline_state_create& create_info)
+		{
+			const auto& desc = entry.desc;
+			const auto& depth = desc.depth_desc;
+			const auto& other_depth = create_info.depth_desc;
+			if (desc.num_render_targets != create_info.num_render_targets
+				|| memcmp(desc.render_target_formats, create_info.render_target_formats, sizeof(u16) * desc.num_render_targets) != 0
+				|| desc.depth_stencil_format != create_info.depth_stencil_format
+				|| desc.topology != create_info.topology
+				|| desc.cull != create_info.cull
+				|| desc.msaa_level != create_info.msaa_level
+				|| desc.blend_mode != create_info.blend_mode
+				|| depth.depth_enabled != other_depth.depth_enabled
+				|| depth.depth_write != other_depth.depth_write
+				|| depth.stencil_test != other_depth.stencil_test
+				|| depth.depth_cmp_func != other_depth.depth_cmp_func
+				|| depth.stencil_cmp_func != other_depth.stencil_cmp_func
+				|| depth.stencil_on_passed != other_depth.stencil_on_passed
+				|| depth.stencil_on_stencil_failed != other_depth.stencil_on_stencil_failed
+				|| depth.stencil_on_fail != other_depth.stencil_on_fail
+				|| depth.stencil_cmp_mask != other_depth.stencil_cmp_mask
+				|| depth.stencil_write_mask != other_depth.stencil_write_mask
+				|| desc.color_write != create_info.color_write
+				|| desc.alpha_to_coverage != create_info.alpha_to_coverage
+				|| desc.wireframe != create_info.wireframe
+				|| desc.scissors != create_info.scissors
+				|| desc.constant_depth_bias != create_info.constant_depth_bias
+				|| desc.slope_scaled_depth_bias != create_info.slope_scaled_depth_bias
+				|| desc.shader_program != create_info.shader_program
+				|| desc.num_immutable_samplers != create_info.num_immutable_samplers)
+				return false;
+
+			if (!core::hash__str_equals(entry.name.c_str(), create_info.name ? create_info.name : strings::g_empty))
+				return false;
+
+			for (u32 i = 0; i < desc.num_immutable_samplers; ++i) {
+				const auto& key = entry.samplers[i];
+				const auto& sampler = create_info.immutable_samplers[i];
+				if (key.shader_type_flags != sampler.shader_type_flags
+					|| key.desc.filter != sampler.desc.filter
+					|| key.desc.address != sampler.desc.address
+					|| key.desc.lod_bias != sampler.desc.lod_bias
+					|| key.desc.min_lod != sampler.desc.min_lod
+					|| key.desc.max_lod != sampler.desc.max_lod
+					|| key.desc.max_anisotropy != sampler.desc.max_anisotropy
+					|| key.desc.comparison != sampler.desc.comparison
+					|| !core::hash__str_equals(key.name.c_str(), sampler.name ? sampler.name : strings::g_empty))
+					return false;
+			}
+			return true;
 		}
 
 		void pipeline_state_mgr__bind_cbuffers(Diligent::IPipelineState* pipeline)
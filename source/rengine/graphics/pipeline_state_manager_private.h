@@ -3,6 +3,7 @@
 #include "./pipeline_state_manager.h"
 
 #include "../core/arena.h"
+#include "../core/hash_private.h"
 
 #include <GraphicsTypes.h>
 #include <PipelineState.h>
@@ -127,10 +128,32 @@ namespace rengine {
 			Diligent::STENCIL_OP_DECR_WRAP,
 		};
 
+		struct pipeline_state_sampler_key {
+			string name{};
+			u32 shader_type_flags{ (u32)shader_type_flags::none };
+			sampler_desc desc{};
+		};
+
+		// full key is kept to verify cache lookups, 64-bit hash alone can still collide
+		struct pipeline_state_entry {
+			core::hash64_t hash{ 0 };
+			graphics_pipeline_state_create desc{};
+			string name{};
+			vector<pipeline_state_sampler_key> samplers{};
+			Diligent::IPipelineState* handle{ null };
+		};
+
 		struct pipeline_state_mgr_state {
 			core::IScratchArena* arena;
-			hash_map<pipeline_state_t, Diligent::IPipelineState*> pipelines;
-			u32 pipeline_count;
+			vector<pipeline_state_entry> pipelines;
+			hash_map<core::hash64_t, pipeline_state_t> pipeline_tbl;
+			core::hash_cache_stats cache_stats{
+				strings::profiler::pipeline_cache_hits,
+				strings::profiler::pipeline_cache_misses,
+				strings::profiler::pipeline_cache_collisions
+			};
+			// ids are never reused, pipelines[i] has id first_id + i and clear cache moves it forward
+			pipeline_state_t first_id{ 0 };
 		};
 
 		extern pipeline_state_mgr_state g_pipeline_state_mgr_state;
@@ -150,6 +173,10 @@ namespace rengine {
 		
 		void pipeline_state_mgr__get_internal_handle(const pipeline_state_t& id, Diligent::IPipelineState** output);
 
+		pipeline_state_t pipeline_state_mgr__find(core::hash64_t hash, const graphics_pipeline_state_create& create_info);
+		pipeline_state_t pipeline_state_mgr__store(core::hash64_t hash, const graphics_pipeline_state_create& create_info, Diligent::IPipelineState* pipeline);
+		bool pipeline_state_mgr__equals(const pipeline_state_entry& entry, const graphics_pipeline_state_create& create_info);
+
 		void pipeline_state_mgr__bind_cbuffers(Diligent::IPipelineState* pipeline);
 	
 		core::hash_t pipeline_state_mgr__hash_depth_desc(const depth_desc& desc);
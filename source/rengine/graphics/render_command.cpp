@@ -35,9 +35,9 @@ namespace rengine {
 
 			render_command__prepare(curr_cmd);
 
-			const auto& it = state.commands.find_as(curr_cmd.id);
-			if (it != state.commands.end())
-				return state.curr_cmd->id;
+			const auto cached_id = render_command__find(curr_cmd);
+			if (cached_id != no_render_command)
+				return cached_id;
 
 			if (state.num_commands == GRAPHICS_MAX_RENDER_COMMANDS)
 				throw graphics_exception(
@@ -46,9 +46,13 @@ namespace rengine {
 
 			render_command__build_internal_objects(curr_cmd);
 
-			auto cmd = shared_ptr<render_command_data>(core::alloc_new<render_command_data>());
+			auto cmd = shared_ptr<render_command_data>(core::alloc_new_tagged<render_command_data>(core::alloc_tag::render_command));
 			*cmd = curr_cmd;
+			cmd->id = render_command__alloc_id();
 			state.commands[cmd->id] = cmd;
+			// on collision, first command remains on table and new one is reachable only by id
+			if (state.command_tbl.find(cmd->hash) == state.command_tbl.end())
+				state.command_tbl[cmd->hash] = cmd->id;
 			++state.num_commands;
 			state.curr_cmd = null;
 			state.is_updating = false;
@@ -63,6 +67,10 @@ namespace rengine {
 			if (it == state.commands.end())
 				return;
 
+			const auto& tbl_it = state.command_tbl.find(it->second->hash);
+			if (tbl_it != state.command_tbl.end() && tbl_it->second == command)
+				state.command_tbl.erase(tbl_it);
+
 			state.commands.erase(it);
 			--state.num_commands;
 		}
@@ -130,36 +138,41 @@ namespace rengine {
 			render_command_set_texarray(slot_hash, tex_id);
 		}
 
-		void render_command_set_tex2d(core::hash_t slot, const texture2d_t& tex_id)
+		void render_command_set_tex2d(const core::string_hash& slot, const texture2d_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			ASSERT_RENDER_COMMAND_UPDATE();
 			auto& cmd = *g_render_command_state.curr_cmd;
 			render_command__set_tex2d(cmd, slot, tex_id);
 		}
 
-		void render_command_set_tex3d(core::hash_t slot, const texture_3d_t& tex_id)
+		void render_command_set_tex3d(const core::string_hash& slot, const texture_3d_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			ASSERT_RENDER_COMMAND_UPDATE();
 			auto& cmd = *g_render_command_state.curr_cmd;
 			render_command__set_tex3d(cmd, slot, tex_id);
 		}
 
-		void render_command_set_texcube(core::hash_t slot, const texture_cube_t& tex_id)
+		void render_command_set_texcube(const core::string_hash& slot, const texture_cube_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			ASSERT_RENDER_COMMAND_UPDATE();
 			auto& cmd = *g_render_command_state.curr_cmd;
 			render_command__set_texcube(cmd, slot, tex_id);
 		}
 
-		void render_command_set_texarray(core::hash_t slot, const texture_array_t& tex_id)
+		void render_command_set_texarray(const core::string_hash& slot, const texture_array_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			ASSERT_RENDER_COMMAND_UPDATE();
 			auto& cmd = *g_render_command_state.curr_cmd;
 			render_command__set_texarray(cmd, slot, tex_id);
 		}
 
-		void render_command_unset_tex(core::hash_t slot)
+		void render_command_unset_tex(const core::string_hash& slot)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			ASSERT_RENDER_COMMAND_UPDATE();
 			auto& cmd = *g_render_command_state.curr_cmd;
 			render_command__unset_tex(cmd, slot);
@@ -1,6 +1,7 @@
 #pragma once
 #include <rengine/api.h>
 #include <rengine/types.h>
+#include <rengine/core/static_hash.h>
 #include <rengine/math/math-types.h>
 #include <rengine/graphics/pipeline_state_manager.h>
 
@@ -20,11 +21,11 @@ namespace rengine {
 		void render_command_set_tex3d(c_str slot_name, const texture_3d_t& tex_id);
 		void render_command_set_texcube(c_str slot_name, const texture_cube_t& tex_id);
 		void render_command_set_texarray(c_str slot_name, const texture_array_t& tex_id);
-		void render_command_set_tex2d(core::hash_t slot, const texture2d_t& tex_id);
-		void render_command_set_tex3d(core::hash_t slot, const texture_3d_t& tex_id);
-		void render_command_set_texcube(core::hash_t slot, const texture_cube_t& tex_id);
-		void render_command_set_texarray(core::hash_t slot, const texture_array_t& tex_id);
-		void render_command_unset_tex(core::hash_t slot);
+		void render_command_set_tex2d(const core::string_hash& slot, const texture2d_t& tex_id);
+		void render_command_set_tex3d(const core::string_hash& slot, const texture_3d_t& tex_id);
+		void render_command_set_texcube(const core::string_hash& slot, const texture_cube_t& tex_id);
+		void render_command_set_texarray(const core::string_hash& slot, const texture_array_t& tex_id);
+		void render_command_unset_tex(const core::string_hash& slot);
         void render_command_set_viewport(const math::urect& rect);
         void render_command_set_scissor_rect(const math::rect& rect);
         void render_command_set_scissor_rects(const math::rect* rects, u8 num_rects);
@@ -47,10 +47,8 @@ namespace rengine {
 
 		void render_command__build_pipeline(render_command_data& data)
 		{
-			const auto arena = g_render_command_state.arena;
-			auto immutable_samplers = (immutable_sampler_desc*)arena->alloc(
-				sizeof(immutable_sampler_desc) * GRAPHICS_MAX_BOUND_TEXTURES
-			);
+			core::scratch_scope scratch(g_render_command_state.arena);
+			auto immutable_samplers = scratch.alloc_array<immutable_sampler_desc>(GRAPHICS_MAX_BOUND_TEXTURES);
 			const auto name = fmt::format("{0}::gpipeline", data.name);
 			graphics_pipeline_state_create pipeline_create;
 			pipeline_create.name = name.c_str();
@@ -95,22 +93,16 @@ namespace rengine {
 			}
 
 			data.pipeline_state = pipeline_state_mgr_create_graphics(pipeline_create);
-
-			arena->free(
-				sizeof(immutable_sampler_desc) * GRAPHICS_MAX_BOUND_TEXTURES
-			);
 		}
 
 		void render_command__build_srb(render_command_data& data)
 		{
-			const auto arena = g_render_command_state.arena;
+			core::scratch_scope scratch(g_render_command_state.arena);
 			// TODO: recycle SRB instead of create new ones
 			srb_mgr_create_desc srb_desc;
 			srb_desc.pipeline = data.pipeline_state;
 			srb_desc.num_resources = 0;
-			srb_desc.resources = (srb_mgr_resource_desc*)arena->alloc(
-				sizeof(srb_mgr_resource_desc) * data.resources.size()
-			);
+			srb_desc.resources = scratch.alloc_array<srb_mgr_resource_desc>(data.resources.size());
 
 			for (const auto& it : data.resources) {
 				const auto& res = it.second;
@@ -121,10 +113,6 @@ namespace rengine {
 				++srb_desc.num_resources;
 			}
 			data.srb = srb_mgr_create(srb_desc);
-
-			arena->free(
-				sizeof(srb_mgr_resource_desc) * data.resources.size()
-			);
 		}
 
 		void render_command__build_hash(render_command_data& data)
@@ -137,6 +125,7 @@ namespace rengine {
 			render_command__build_scissor_hash(data);
 			render_command__build_texture_hash(data);
 			// calculate graphics state hashes
+			hashes.graphics_state = 0;
 			hashes.graphics_state = core::hash_combine(hashes.graphics_state, (u32)data.topology);
 			hashes.graphics_state = core::hash_combine(hashes.graphics_state, (u32)data.cull);
 			hashes.graphics_state = core::hash_combine(hashes.graphics_state, (u32)data.wireframe);
@@ -150,13 +139,128 @@ namespace rengine {
 			hashes.graphics_state = core::hash_combine(hashes.graphics_state, core::hash(data.constant_depth_bias));
 			hashes.graphics_state = core::hash_combine(hashes.graphics_state, core::hash(data.slope_scaled_depth_bias));
 
-			data.id = core::hash_combine(hashes.render_targets, hashes.vertex_buffers);
-			data.id = core::hash_combine(data.id, hashes.vertex_buffer_offsets);
-			data.id = core::hash_combine(data.id, hashes.index_buffer);
-			data.id = core::hash_combine(data.id, hashes.textures);
-			data.id = core::hash_combine(data.id, hashes.viewport);
-			data.id = core::hash_combine(data.id, hashes.scissors);
-			data.id = core::hash_combine(data.id, hashes.graphics_state);
+			// partial hashes are used only to detect state changes,
+			// cache key is built from full state to not depend on 32-bit combines
+			data.hash = render_command__build_state_hash(data);
+		}
+
+		core::hash64_t render_command__build_state_hash(const render_command_data& cmd)
+		{
+			core::hash64_stream stream;
+			stream.update_value(cmd.num_render_targets);
+			stream.update(cmd.render_targets.data(), sizeof(render_target_t) * cmd.num_render_targets);
+			stream.update_value(cmd.depth_stencil);
+			stream.update_value(cmd.num_vertex_buffers);
+			stream.update(cmd.vertex_buffers.data(), sizeof(vertex_buffer_t) * cmd.num_vertex_buffers);
+			stream.update(cmd.vertex_offsets.data(), sizeof(u64) * cmd.num_vertex_buffers);
+			stream.update_value(cmd.index_buffer);
+			stream.update_value(cmd.index_offset);
+			stream.update_value(cmd.program);
+			stream.update_value(cmd.viewport);
+			stream.update_value(cmd.num_scissors);
+			stream.update(cmd.scissor_rects.data(), sizeof(math::rect) * cmd.num_scissors);
+			stream.update_value(cmd.topology);
+			stream.update_value(cmd.cull);
+			stream.update_value(cmd.blend_mode);
+			stream.update_value(cmd.color_write);
+			stream.update_value(cmd.alpha_to_coverage);
+			stream.update_value(cmd.wireframe);
+			stream.update_value(cmd.constant_depth_bias);
+			stream.update_value(cmd.slope_scaled_depth_bias);
+			stream.update_value(cmd.depth_desc);
+
+			// resources are stored on hash map, iteration order is not guaranteed
+			// then each resource is hashed individually and summed
+			core::hash64_t resources_hash = 0;
+			for (const auto& it : cmd.resources) {
+				const auto& res = it.second;
+				core::hash64_stream res_stream;
+				res_stream.update_value(res.resource.id);
+				res_stream.update_value(res.tex_id);
+				res_stream.update_value(res.type);
+				resources_hash += res_stream.digest();
+			}
+			stream.update_value((u32)cmd.resources.size());
+			stream.update_value(resources_hash);
+			return stream.digest();
+		}
+
+		render_command_t render_command__find(const render_command_data& cmd)
+		{
+			auto& state = g_render_command_state;
+			const auto& tbl_it = state.command_tbl.find(cmd.hash);
+			if (tbl_it == state.command_tbl.end()) {
+				core::hash__cache_miss(state.cache_stats);
+				return no_render_command;
+			}
+
+			const auto& it = state.commands.find(tbl_it->second);
+			if (it == state.commands.end() || !render_command__equals(*it->second, cmd)) {
+				core::hash__cache_collision(state.cache_stats);
+				return no_render_command;
+			}
+
+			core::hash__cache_hit(state.cache_stats);
+			return tbl_it->second;
+		}
+
+		render_command_t render_command__alloc_id()
+		{
+			auto& state = g_render_command_state;
+			auto id = state.next_id++;
+			if (id == no_render_command)
+				id = state.next_id++;
+			return id;
+		}
+
+		bool render_command__equals(const render_command_data& a, const render_command_data& b)
+		{
+			if (a.num_render_targets != b.num_render_targets
+				|| a.num_vertex_buffers != b.num_vertex_buffers
+				|| a.num_scissors != b.num_scissors
+				|| a.depth_stencil != b.depth_stencil
+				|| a.index_buffer != b.index_buffer
+				|| a.index_offset != b.index_offset
+				|| a.program != b.program
+				|| !a.viewport.equal(b.viewport)
+				|| a.topology != b.topology
+				|| a.cull != b.cull
+				|| a.blend_mode != b.blend_mode
+				|| a.color_write != b.color_write
+				|| a.alpha_to_coverage != b.alpha_to_coverage
+				|| a.wireframe != b.wireframe
+				|| a.constant_depth_bias != b.constant_depth_bias
+				|| a.slope_scaled_depth_bias != b.slope_scaled_depth_bias
+				|| memcmp(&a.depth_desc, &b.depth_desc, sizeof(depth_desc)) != 0
+				|| a.resources.size() != b.resources.size())
+				return false;
+
+			for (u8 i = 0; i < a.num_render_targets; ++i) {
+				if (a.render_targets[i] != b.render_targets[i])
+					return false;
+			}
+
+			for (u8 i = 0; i < a.num_vertex_buffers; ++i) {
+				if (a.vertex_buffers[i] != b.vertex_buffers[i] || a.vertex_offsets[i] != b.vertex_offsets[i])
+					return false;
+			}
+
+			for (u8 i = 0; i < a.num_scissors; ++i) {
+				if (!a.scissor_rects[i].equal(b.scissor_rects[i]))
+					return false;
+			}
+
+			for (const auto& it : a.resources) {
+				const auto& b_it = b.resources.find(it.first);
+				if (b_it == b.resources.end())
+					return false;
+
+				const auto& a_res = it.second;
+				const auto& b_res = b_it->second;
+				if (a_res.type != b_res.type || a_res.tex_id != b_res.tex_id || a_res.resource.id != b_res.resource.id)
+					return false;
+			}
+			return true;
 		}
 
 		void render_command__build_vbuffer_hash(render_command_data& cmd)
@@ -279,10 +383,9 @@ namespace rengine {
 			if (num_buffers > GRAPHICS_MAX_VBUFFERS) {
 				num_buffers = GRAPHICS_MAX_VBUFFERS;
 
-				log->warn(fmt::format(strings::logs::g_render_cmd_isnt_allowed_to_set_buffer_grt_than_max,
+				log_warn_limited(log, strings::logs::g_render_cmd_isnt_allowed_to_set_buffer_grt_than_max,
 					num_buffers,
-					GRAPHICS_MAX_VBUFFERS).c_str()
-				);
+					GRAPHICS_MAX_VBUFFERS);
 			}
 
 			memcpy(cmd.vertex_buffers.data(), buffers, sizeof(vertex_buffer_t) * num_buffers);
@@ -304,11 +407,9 @@ namespace rengine {
 			if (num_rts > GRAPHICS_MAX_RENDER_TARGETS) {
 				num_rts = GRAPHICS_MAX_RENDER_TARGETS;
 
-				log->warn(
-					fmt::format(strings::logs::g_render_isnt_allowed_to_set_rt_grt_than_max,
-						num_rts,
-						GRAPHICS_MAX_RENDER_TARGETS).c_str()
-				);
+				log_warn_limited(log, strings::logs::g_render_isnt_allowed_to_set_rt_grt_than_max,
+					num_rts,
+					GRAPHICS_MAX_RENDER_TARGETS);
 			}
 
 			for (u8 i = 0; i < num_rts; ++i) {
@@ -414,9 +515,9 @@ namespace rengine {
 
 			if (num_rects > GRAPHICS_MAX_SCISSORS) {
 				num_rects = GRAPHICS_MAX_SCISSORS;
-				log->warn(fmt::format(strings::logs::g_render_isnt_allowed_to_set_scissor_grt_than_max,
+				log_warn_limited(log, strings::logs::g_render_isnt_allowed_to_set_scissor_grt_than_max,
 					num_rects,
-					GRAPHICS_MAX_SCISSORS).c_str());
+					GRAPHICS_MAX_SCISSORS);
 			}
 
 			memcpy(cmd.scissor_rects.data(), rects, sizeof(math::rect) * num_rects);
@@ -506,7 +607,7 @@ namespace rengine {
 				return true;
 			}
 
-			log->warn(fmt::format(strings::logs::g_render_cmd_not_found_command, cmd_id).c_str());
+			log_warn_limited(log, strings::logs::g_render_cmd_not_found_command, cmd_id);
 			return false;
 		}
 	}
@@ -7,6 +7,8 @@
 #include "../math/math-types.h"
 #include "../io/logger.h"
 #include "../core/arena.h"
+#include "../core/hash_private.h"
+#include "../core/string_pool.h"
 
 namespace rengine {
 	namespace graphics {
@@ -60,6 +62,8 @@ namespace rengine {
 			pipeline_state_t pipeline_state{ no_pipeline_state };
 			srb_t srb{ no_srb };
 			render_command_hashes hashes{};
+			// hash of full command state, used as cache key
+			core::hash64_t hash{ 0 };
 		};
 		typedef hash_map<render_command_t, shared_ptr<render_command_data>> command_list;
 
@@ -68,7 +72,14 @@ namespace rengine {
 			core::IScratchArena* arena { null };
 
 			command_list commands;
+			hash_map<core::hash64_t, render_command_t> command_tbl;
+			render_command_t next_id{ 1 };
 			u32 num_commands{ 0 };
+			core::hash_cache_stats cache_stats{
+				strings::profiler::render_cmd_cache_hits,
+				strings::profiler::render_cmd_cache_misses,
+				strings::profiler::render_cmd_cache_collisions
+			};
 			render_command_data* curr_cmd{ null };
 			bool is_updating{ false };
 			render_command_data tmp_cmd_data{};
@@ -91,6 +102,11 @@ namespace rengine {
         void render_command__build_viewport_hash(render_command_data& cmd);
         void render_command__build_scissor_hash(render_command_data& cmd);
         void render_command__build_texture_hash(render_command_data& cmd);
+		core::hash64_t render_command__build_state_hash(const render_command_data& cmd);
+
+		render_command_t render_command__find(const render_command_data& cmd);
+		render_command_t render_command__alloc_id();
+		bool render_command__equals(const render_command_data& a, const render_command_data& b);
 
 		void render_command__prepare_textures(render_command_data& cmd);
 
@@ -125,4 +141,11 @@ namespace rengine {
     #define ASSERT_RENDER_COMMAND_UPDATE() render_command__assert_update()
 #else
     #define ASSERT_RENDER_COMMAND_UPDATE()
+#endif
+
+// registers compile time slot names, then they can be displayed by its hash
+#if ENGINE_DEBUG
+    #define REGISTER_RENDER_COMMAND_SLOT(slot) core::string_pool_register(slot)
+#else
+    #define REGISTER_RENDER_COMMAND_SLOT(slot)
 #endif
\ No newline at end of file
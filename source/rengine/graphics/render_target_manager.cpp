@@ -40,7 +40,7 @@ namespace rengine {
 			render_target_mgr__get_internal_handles(id, (Diligent::ITexture**)backbuffer, (Diligent::ITexture**)depthbuffer);
 		}
 
-		u8 render_target_mgr_get_count()
+		u32 render_target_mgr_get_count()
 		{
 			return render_target_mgr__get_count();
 		}
@@ -50,7 +50,7 @@ namespace rengine {
 			render_target_mgr__clear_cache();
 		}
 		
-		void render_target_mgr_get_available_rts(u8* count, render_target_t* output_ids)
+		void render_target_mgr_get_available_rts(u32* count, render_target_t* output_ids)
 		{
 			return render_target_mgr__get_available_rts(count, output_ids);
 		}
@@ -38,9 +38,9 @@ namespace rengine {
 		R_EXPORT render_target_type render_target_mgr_get_type(const render_target_t& id);
 		R_EXPORT bool render_target_mgr_has_depthbuffer(const render_target_t& id);
 		R_EXPORT void render_target_mgr_get_handlers(const render_target_t& id, ptr* backbuffer, ptr* depthbuffer);
-		R_EXPORT u8 render_target_mgr_get_count();
+		R_EXPORT u32 render_target_mgr_get_count();
 		R_EXPORT void render_target_mgr_clear_cache();
-		R_EXPORT void render_target_mgr_get_available_rts(u8* count, render_target_t* output_ids);
+		R_EXPORT void render_target_mgr_get_available_rts(u32* count, render_target_t* output_ids);
 		R_EXPORT bool render_target_mgr_is_valid(const render_target_t& id);
 		R_EXPORT render_target_t render_target_mgr_find_from_size(const math::uvec2& size, render_target_type expected_type = render_target_type::normal);
 	}
@@ -19,15 +19,7 @@ namespace rengine {
 		void render_target_mgr__deinit()
 		{
 			render_target_mgr__clear_cache();
-			//g_rt_mgr_state.magic = 0;
-		}
-
-		render_target_t render_target_mgr__encode_id(u8 idx, u8 magic) {
-			return idx << 8u | magic;
-		}
-		
-		u8 render_target_mgr__decode_id(u16 value) {
-			return value >> 8u;
+			g_rt_mgr_state.render_targets.release();
 		}
 
 		render_target_t render_target_mgr__create(const render_target_create_info& create_desc) {
@@ -201,12 +193,12 @@ namespace rengine {
 			g_rt_mgr_state.render_targets.clear();
 		}
 
-		u8 render_target_mgr__get_count()
+		u32 render_target_mgr__get_count()
 		{
 			return g_rt_mgr_state.render_targets.count();
 		}
 
-		void render_target_mgr__get_available_rts(u8* count, render_target_t* output_ids)
+		void render_target_mgr__get_available_rts(u32* count, render_target_t* output_ids)
 		{
 			if (!count)
 				return;
@@ -216,7 +208,7 @@ namespace rengine {
 			if (!output_ids)
 				return;
 
-			u8 idx = 0;
+			u32 idx = 0;
 			for (const auto& entry : g_rt_mgr_state.render_targets) {
 				output_ids[idx] = entry.id;
 				++idx;
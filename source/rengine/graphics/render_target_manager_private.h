@@ -19,9 +19,7 @@ namespace rengine {
 
 		struct render_target_mgr_state {
 			io::ILog* log;
-			core::array_pool<render_target_entry, GRAPHICS_MAX_ALLOC_RENDER_TARGETS> render_targets;
-			/*u8 count{ 0 };
-			u8 magic{ 0 };*/
+			core::paged_pool<render_target_entry, GRAPHICS_RENDER_TARGET_POOL_PAGE_SIZE> render_targets;
 		};
 
 		extern render_target_mgr_state g_rt_mgr_state;
@@ -29,9 +27,6 @@ namespace rengine {
 		void render_target_mgr__init();
 		void render_target_mgr__deinit();
 
-		render_target_t render_target_mgr__encode_id(u8 idx, u8 magic);
-		u8 render_target_mgr__decode_id(u16 value);
-
 		render_target_t render_target_mgr__create(const render_target_create_info& create_desc);
 		void render_target_mgr__destroy(const render_target_t& id);
 		render_target_t render_target_mgr__resize(const render_target_t& id, const math::uvec2& size);
@@ -47,7 +42,7 @@ namespace rengine {
 		bool render_target_mgr__is_valid(const render_target_t& id);
 
 		void render_target_mgr__clear_cache();
-		u8 render_target_mgr__get_count();
-		void render_target_mgr__get_available_rts(u8* count, render_target_t* output_ids);
+		u32 render_target_mgr__get_count();
+		void render_target_mgr__get_available_rts(u32* count, render_target_t* output_ids);
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "./graphics_private.h"
 #include "./render_target_manager_private.h"
 #include "./render_command_private.h"
+#include "./frame_stats_private.h"
 
 #include "../core/allocator.h"
 #include "../core/window_private.h"
@@ -162,26 +163,30 @@ namespace rengine {
 			render_command__set_texarray(cmd, slot_hash, tex_id);
 		}
 
-		void renderer_set_texture_2d(core::hash_t slot, const texture2d_t& tex_id)
+		void renderer_set_texture_2d(const core::string_hash& slot, const texture2d_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			auto& cmd = g_renderer_state.default_cmd;
 			render_command__set_tex2d(cmd, slot, tex_id);
 		}
 
-		void renderer_set_texture_3d(core::hash_t slot, const texture_3d_t& tex_id)
+		void renderer_set_texture_3d(const core::string_hash& slot, const texture_3d_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			auto& cmd = g_renderer_state.default_cmd;
 			render_command__set_tex3d(cmd, slot, tex_id);
 		}
 
-		void renderer_set_texture_cube(core::hash_t slot, const texture_cube_t& tex_id)
+		void renderer_set_texture_cube(const core::string_hash& slot, const texture_cube_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			auto& cmd = g_renderer_state.default_cmd;
 			render_command__set_texcube(cmd, slot, tex_id);
 		}
 
-		void renderer_set_texture_array(core::hash_t slot, const texture_array_t& tex_id)
+		void renderer_set_texture_array(const core::string_hash& slot, const texture_array_t& tex_id)
 		{
+			REGISTER_RENDER_COMMAND_SLOT(slot);
 			auto& cmd = g_renderer_state.default_cmd;
 			render_command__set_texarray(cmd, slot, tex_id);
 		}
@@ -279,13 +284,15 @@ namespace rengine {
 		{
 			profile();
 			auto& cmd = g_renderer_state.default_cmd;
-			auto prev_cmd_hash = cmd.id;
+			auto prev_cmd_hash = cmd.hash;
 
 			render_command__prepare(cmd);
 
-			if (cmd.id == prev_cmd_hash && cmd.pipeline_state != no_pipeline_state)
+			if (cmd.hash == prev_cmd_hash && cmd.pipeline_state != no_pipeline_state)
 				return;
 
+			// state has diverged from the last used command
+			cmd.id = no_render_command;
 			render_command__build_internal_objects(cmd);
 			renderer__submit_render_state();
 		}
@@ -308,6 +315,10 @@ namespace rengine {
 			draw_attr.NumVertices = desc.num_vertices;
 
 			ctx->Draw(draw_attr);
+
+			auto& stats = g_frame_stats_state.curr;
+			++stats.num_draws;
+			stats.num_primitives += frame_stats__count_primitives(g_renderer_state.default_cmd.topology, desc.num_vertices, desc.num_instances);
 		}
 
 		void renderer_draw_indexed(const draw_indexed_desc& desc)
@@ -331,6 +342,10 @@ namespace rengine {
 			draw_attr.FirstInstanceLocation = desc.start_instance_idx;
 
 			ctx->DrawIndexed(draw_attr);
+
+			auto& stats = g_frame_stats_state.curr;
+			++stats.num_draws;
+			stats.num_primitives += frame_stats__count_primitives(g_renderer_state.default_cmd.topology, desc.num_indices, desc.num_instances);
 		}
 
 		void renderer_blit(const render_target_t& src, const render_target_t& dst)
@@ -1,6 +1,7 @@
 #pragma once
 #include <rengine/api.h>
 #include <rengine/types.h>
+#include <rengine/core/static_hash.h>
 #include <rengine/graphics/pipeline_state_manager.h>
 #include <rengine/math/math-types.h>
 
@@ -45,10 +46,10 @@ namespace rengine {
 		R_EXPORT void renderer_set_texture_3d(c_str slot_name, const texture_3d_t& tex_id);
 		R_EXPORT void renderer_set_texture_cube(c_str slot_name, const texture_cube_t& tex_id);
 		R_EXPORT void renderer_set_texture_array(c_str slot_name, const texture_array_t& tex_id);
-		R_EXPORT void renderer_set_texture_2d(core::hash_t slot, const texture2d_t& tex_id);
-		R_EXPORT void renderer_set_texture_3d(core::hash_t slot, const texture_3d_t& tex_id);
-		R_EXPORT void renderer_set_texture_cube(core::hash_t slot, const texture_cube_t& tex_id);
-		R_EXPORT void renderer_set_texture_array(core::hash_t slot, const texture_array_t& tex_id);
+		R_EXPORT void renderer_set_texture_2d(const core::string_hash& slot, const texture2d_t& tex_id);
+		R_EXPORT void renderer_set_texture_3d(const core::string_hash& slot, const texture_3d_t& tex_id);
+		R_EXPORT void renderer_set_texture_cube(const core::string_hash& slot, const texture_cube_t& tex_id);
+		R_EXPORT void renderer_set_texture_array(const core::string_hash& slot, const texture_array_t& tex_id);
 
 		R_EXPORT void renderer_set_viewport(const math::urect& rect);
 		R_EXPORT void renderer_set_scissor_rect(const math::rect& rect);
@@ -4,6 +4,7 @@
 #include "./pipeline_state_manager_private.h"
 #include "./buffer_manager_private.h"
 #include "./srb_manager_private.h"
+#include "./frame_stats_private.h"
 
 #include "../exceptions.h"
 #include "../strings.h"
@@ -29,7 +30,8 @@ namespace rengine {
 			auto& cmd = g_renderer_state.default_cmd;
 			auto viewport_size = g_graphics_state.viewport_size;
 			cmd.name = strings::graphics::g_default_cmd_name;
-			cmd.id = 0;
+			cmd.id = no_render_command;
+			cmd.hash = 0;
             cmd.hashes = {};
             cmd.viewport = { {0, 0}, viewport_size };
             cmd.scissor_rects.fill({});
@@ -104,9 +106,12 @@ namespace rengine {
 			const auto changed_offsets = ctx_state.prev_vbuffer_offsets_hash != cmd.hashes.vertex_buffer_offsets;
 			const auto changed_buffers = ctx_state.prev_vbuffer_hash != cmd.hashes.vertex_buffers;
 			const auto touched_buffers = changed_buffers || changed_offsets;
+			auto& stats = g_frame_stats_state.curr;
 
-			if (!touched_buffers)
+			if (!touched_buffers) {
+				++stats.num_redundant_sets;
 				return;
+			}
 
 			Diligent::IBuffer* vertex_buffers[GRAPHICS_MAX_VBUFFERS] = {};
 			for (u8 i = 0; i < cmd.num_vertex_buffers; ++i)
@@ -122,6 +127,7 @@ namespace rengine {
 
 			ctx_state.prev_vbuffer_hash = cmd.hashes.vertex_buffers;
 			ctx_state.prev_vbuffer_offsets_hash = cmd.hashes.vertex_buffer_offsets;
+			++stats.num_vbuffer_binds;
 		}
 
 		void renderer__set_ibuffer()
@@ -201,14 +207,19 @@ namespace rengine {
 			const auto ctx = g_graphics_state.contexts[0];
 			auto& ctx_state = g_renderer_state.context_state;
 
-			if (ctx_state.prev_pipeline_id == cmd.pipeline_state)
+			auto& stats = g_frame_stats_state.curr;
+
+			if (ctx_state.prev_pipeline_id == cmd.pipeline_state) {
+				++stats.num_redundant_sets;
 				return;
+			}
 
 			Diligent::IPipelineState* pipeline = null;
 			pipeline_state_mgr__get_internal_handle(cmd.pipeline_state, &pipeline);
 
 			ctx->SetPipelineState(pipeline);
 			ctx_state.prev_pipeline_id = cmd.pipeline_state;
+			++stats.num_pipeline_binds;
 		}
 
 		void renderer__set_srb()
@@ -217,14 +228,19 @@ namespace rengine {
 			const auto ctx = g_graphics_state.contexts[0];
 			auto& ctx_state = g_renderer_state.context_state;
 
-			if (ctx_state.prev_srb == cmd.srb)
+			auto& stats = g_frame_stats_state.curr;
+
+			if (ctx_state.prev_srb == cmd.srb) {
+				++stats.num_redundant_sets;
 				return;
+			}
 
 			Diligent::IShaderResourceBinding* srb = null;
 			srb_mgr__get_handle(cmd.srb, &srb);
 
 			ctx->CommitShaderResources(srb, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 			ctx_state.prev_srb = cmd.srb;
+			++stats.num_srb_commits;
 		}
 
 		void renderer__submit_render_state()
@@ -103,6 +103,10 @@ namespace rengine {
 			if (it == state.programs.end())
 				return;
 
+			const auto tbl_it = state.program_tbl.find(it->second.hash);
+			if (tbl_it != state.program_tbl.end() && tbl_it->second == program_id)
+				state.program_tbl.erase(tbl_it);
+
 			state.programs.erase(it);
 			--state.programs_count;
 		}
@@ -111,6 +115,7 @@ namespace rengine {
 		{
 			auto& state = g_shader_mgr_state;
 			state.programs.clear();
+			state.program_tbl.clear();
 			state.programs_count = 0;
 		}
 
@@ -70,16 +70,17 @@ namespace rengine {
 		{
 			auto& state = g_shader_mgr_state;
 			const auto hash = shader_mgr__hash_program_desc(desc.desc);
-			const auto it = state.programs.find_as(hash);
+			const auto cached_program = shader_mgr__find_program(hash, desc.desc);
 
-			if (it != state.programs.end())
-				return hash;
+			if (cached_program != no_shader_program)
+				return cached_program;
 			// TODO: make validation of what kind of shaders are used
 			shader_entry* entries[(u8)shader_type::max] = {};
 			shader_mgr__get_entries_batch(reinterpret_cast<const shader_t*>(&desc.desc), entries);
 
 			shader_program program;
 			program.desc = desc.desc;
+			program.hash = hash;
 
 			// collect shader resources and insert into program
 			for (u8 i = 0; i < (u8)shader_type::max; ++i) {
@@ -102,9 +103,42 @@ namespace rengine {
 			}
 
 			// finally, insert program
-			state.programs[hash] = program;
+			const auto program_id = shader_mgr__alloc_program_id();
+			state.programs[program_id] = program;
 			state.programs_count++;
-			return hash;
+
+			// on collision, first program remains on table and new one is reachable only by id
+			if (state.program_tbl.find(hash) == state.program_tbl.end())
+				state.program_tbl[hash] = program_id;
+			return program_id;
+		}
+
+		shader_program_t shader_mgr__find_program(core::hash64_t hash, const shader_program_desc& desc)
+		{
+			auto& state = g_shader_mgr_state;
+			const auto tbl_it = state.program_tbl.find(hash);
+			if (tbl_it == state.program_tbl.end()) {
+				core::hash__cache_miss(state.program_cache_stats);
+				return no_shader_program;
+			}
+
+			const auto& program = state.programs[tbl_it->second];
+			if (program.desc.vertex_shader != desc.vertex_shader || program.desc.pixel_shader != desc.pixel_shader) {
+				core::hash__cache_collision(state.program_cache_stats);
+				return no_shader_program;
+			}
+
+			core::hash__cache_hit(state.program_cache_stats);
+			return tbl_it->second;
+		}
+
+		shader_program_t shader_mgr__alloc_program_id()
+		{
+			auto& state = g_shader_mgr_state;
+			auto id = state.next_program_id++;
+			if (id == no_shader_program)
+				id = state.next_program_id++;
+			return id;
 		}
 
 		void shader_mgr__free(const shader_entry& entry)
@@ -116,18 +150,28 @@ namespace rengine {
 		void shader_mgr__collect_resources(Diligent::IShader* shader, shader_resource* resources, u32 shader_type_flag)
 		{
 			const auto resource_count = shader->GetResourceCount();
-			for (u32 i = 0; i < resource_count; ++i) {
-				Diligent::ShaderResourceDesc resource_desc;
-				shader->GetResourceDesc(i, resource_desc);
-
-				core::hash_t resource_hash = 0;
-				c_str resource_name = core::string_pool_intern(resource_desc.Name, &resource_hash);
-				resources[i] = {
-					resource_hash,
-					shader_mgr__get_resource_type(&resource_desc),
-					resource_name,
-					shader_type_flag
-				};
+			Diligent::ShaderResourceDesc resource_descs[CORE_STRING_POOL_BATCH_SIZE];
+			c_str names[CORE_STRING_POOL_BATCH_SIZE];
+			c_str resource_names[CORE_STRING_POOL_BATCH_SIZE];
+			core::hash_t resource_hashes[CORE_STRING_POOL_BATCH_SIZE];
+
+			// names are interned by batch, string pool locks are taken only for new names
+			for (u32 offset = 0; offset < resource_count; offset += CORE_STRING_POOL_BATCH_SIZE) {
+				const u32 count = resource_count - offset < CORE_STRING_POOL_BATCH_SIZE ? resource_count - offset : CORE_STRING_POOL_BATCH_SIZE;
+				for (u32 i = 0; i < count; ++i) {
+					shader->GetResourceDesc(offset + i, resource_descs[i]);
+					names[i] = resource_descs[i].Name;
+				}
+
+				core::string_pool_intern_many(names, count, resource_names, resource_hashes);
+				for (u32 i = 0; i < count; ++i) {
+					resources[offset + i] = {
+						resource_hashes[i],
+						shader_mgr__get_resource_type(&resource_descs[i]),
+						resource_names[i],
+						shader_type_flag
+					};
+				}
 			}
 		}
 
@@ -214,9 +258,12 @@ namespace rengine {
 			return result;
 		}
 
-		core::hash_t shader_mgr__hash_program_desc(const shader_program_desc& desc)
+		core::hash64_t shader_mgr__hash_program_desc(const shader_program_desc& desc)
 		{
-			return core::hash_combine(desc.vertex_shader, desc.pixel_shader);
+			core::hash64_stream stream;
+			stream.update_value(desc.vertex_shader);
+			stream.update_value(desc.pixel_shader);
+			return stream.digest();
 		}
 	}
 }
\ No newline at end of file
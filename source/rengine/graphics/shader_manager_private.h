@@ -2,6 +2,8 @@
 #include "../base_private.h"
 #include "./shader_manager.h"
 
+#include "../core/hash_private.h"
+
 #include <Shader.h>
 
 namespace rengine {
@@ -9,7 +11,9 @@ namespace rengine {
 		struct shader_program {
 			hash_map<core::hash_t, shader_resource> resources{};
 			u32 num_resources{ 0 };
+			// desc is the full key, it is compared on cache lookups
 			shader_program_desc desc{};
+			core::hash64_t hash{ 0 };
 		};
 
 		struct shader_entry {
@@ -24,8 +28,15 @@ namespace rengine {
 			hash_map<shader_t, shader_entry> shaders{};
 			u32 shaders_count{};
 
-			hash_map<shader_t, shader_program> programs{};
+			hash_map<shader_program_t, shader_program> programs{};
+			hash_map<core::hash64_t, shader_program_t> program_tbl{};
+			shader_program_t next_program_id{ 0 };
 			u32 programs_count{};
+			core::hash_cache_stats program_cache_stats{
+				strings::profiler::program_cache_hits,
+				strings::profiler::program_cache_misses,
+				strings::profiler::program_cache_collisions
+			};
 		};
 
 		extern shader_state g_shader_mgr_state;
@@ -67,6 +78,8 @@ namespace rengine {
 		const shader_program* shader_mgr__get_program(const shader_program_t& program_id);
 
 		shader_program_t shader_mgr__create_program(const shader_program_create_desc& desc);
+		shader_program_t shader_mgr__find_program(core::hash64_t hash, const shader_program_desc& desc);
+		shader_program_t shader_mgr__alloc_program_id();
 
 		void shader_mgr__free(const shader_entry& entry);
 		void shader_mgr__collect_resources(Diligent::IShader* shader, shader_resource* resources, u32 shader_type_flag);
@@ -77,6 +90,6 @@ namespace rengine {
 		void shader_mgr__get_entries_batch(const shader_t* shaders, shader_entry** entries_output);
 
 		core::hash_t shader_mgr__hash_desc(const shader_create_desc& desc);
-		core::hash_t shader_mgr__hash_program_desc(const shader_program_desc& desc);
+		core::hash64_t shader_mgr__hash_program_desc(const shader_program_desc& desc);
 	}
 }
\ No newline at end of file
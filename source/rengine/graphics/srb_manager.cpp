@@ -11,11 +11,11 @@ namespace rengine {
 		srb_t srb_mgr_create(const srb_mgr_create_desc& desc)
 		{
 			auto& state = g_srb_mgr_state;
-			const auto& hash = srb_mgr__build_hash(desc.pipeline, desc.resources, desc.num_resources);
-			const auto& it = g_srb_mgr_state.srb_tbl.find_as(hash);
+			const auto hash = srb_mgr__build_hash(desc.pipeline, desc.resources, desc.num_resources);
+			const auto cached_srb = srb_mgr__find(hash, desc.pipeline, desc.resources, desc.num_resources);
 
-			if (it != g_srb_mgr_state.srb_tbl.end())
-				return it->second;
+			if (cached_srb != no_srb)
+				return cached_srb;
 
 			Diligent::IPipelineState* pipeline = null;
 			pipeline_state_mgr__get_internal_handle(desc.pipeline, &pipeline);
@@ -26,13 +26,15 @@ namespace rengine {
 				);
 
 			auto srb = srb_mgr__create(pipeline, desc);
-			const auto result = g_srb_mgr_state.entries.size();
-			state.entries.push_back({
-				hash,
-				srb,
-				desc.pipeline
-			});
-			state.srb_tbl[hash] = result;
+			const srb_t result = state.entries.size();
+			auto& entry = state.entries.push_back();
+			entry.handle = srb;
+			entry.pipeline = desc.pipeline;
+			srb_mgr__set_key(entry, hash, desc.resources, desc.num_resources);
+
+			// on collision, first entry remains on table and new one is reachable only by id
+			if (state.srb_tbl.find(hash) == state.srb_tbl.end())
+				state.srb_tbl[hash] = result;
 
 			return result;
 		}
@@ -43,18 +45,22 @@ namespace rengine {
 			if (!srb_mgr__assert_id(desc.id))
 				return;
 
-			const auto& entry = state.entries[desc.id];
+			auto& entry = state.entries[desc.id];
 			const auto hash = srb_mgr__build_hash(entry.pipeline, desc.resources, desc.num_resources);
 
-			// if hash is same, there's no reason to update SRB
-			if (hash == entry.id)
+			// if key is same, there's no reason to update SRB
+			if (hash == entry.hash && srb_mgr__equals(entry, entry.pipeline, desc.resources, desc.num_resources))
 				return;
 
-			state.srb_tbl.erase(state.srb_tbl.find_as(desc.id));
+			const auto& it = state.srb_tbl.find(entry.hash);
+			if (it != state.srb_tbl.end() && it->second == desc.id)
+				state.srb_tbl.erase(it);
 
 			srb_mgr__set_resources(entry.handle, desc.resources, desc.num_resources);
+			srb_mgr__set_key(entry, hash, desc.resources, desc.num_resources);
 
-			state.srb_tbl[hash] = desc.id;
+			if (state.srb_tbl.find(hash) == state.srb_tbl.end())
+				state.srb_tbl[hash] = desc.id;
 		}
 
 		void srb_mgr_clear_cache()
@@ -2,6 +2,7 @@
 #include "./render_target_manager.h"
 #include "./buffer_manager_private.h"
 #include "./texture_manager_private.h"
+#include "./frame_stats_private.h"
 
 #include "../core/hash.h"
 #include "../exceptions.h"
@@ -24,9 +25,7 @@ namespace rengine {
 		{
 			bool result;
 			if(!(result = id < g_srb_mgr_state.entries.size()))
-				g_srb_mgr_state.log->warn(
-					fmt::format(strings::logs::g_srb_mgr_invalid_id, id).c_str()
-				);
+				log_warn_limited(g_srb_mgr_state.log, strings::logs::g_srb_mgr_invalid_id, id);
 
 			return result;
 		}
@@ -40,22 +39,71 @@ namespace rengine {
 				return null;
 
 			srb->AddRef();
+			++g_frame_stats_state.curr.num_srbs_created;
 
 			srb_mgr__set_resources(srb, desc.resources, desc.num_resources);
 			return srb;
 		}
 
-		core::hash_t srb_mgr__build_hash(const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources)
+		core::hash64_t srb_mgr__build_hash(const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources)
 		{
-			auto hash = (core::hash_t)pipeline_id;
+			core::hash64_stream stream;
+			stream.update_value(pipeline_id);
+			stream.update_value(num_resources);
 			for (u8 i = 0; i < num_resources; ++i) {
 				const auto& resource = resources[i];
-				hash = core::hash_combine(hash, core::hash(resource.name));
-				hash = core::hash_combine(hash, resource.id);
-				hash = core::hash_combine(hash, (u32)resource.type);
+				stream.update_str(resource.name);
+				stream.update_value(resource.id);
+				stream.update_value(resource.type);
 			}
 
-			return hash;
+			return stream.digest();
+		}
+
+		srb_t srb_mgr__find(core::hash64_t hash, const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources)
+		{
+			auto& state = g_srb_mgr_state;
+			const auto& it = state.srb_tbl.find(hash);
+			if (it == state.srb_tbl.end()) {
+				core::hash__cache_miss(state.cache_stats);
+				return no_srb;
+			}
+
+			if (!srb_mgr__equals(state.entries[it->second], pipeline_id, resources, num_resources)) {
+				core::hash__cache_collision(state.cache_stats);
+				return no_srb;
+			}
+
+			core::hash__cache_hit(state.cache_stats);
+			return it->second;
+		}
+
+		bool srb_mgr__equals(const srb_mgr_entry& entry, const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources)
+		{
+			if (entry.pipeline != pipeline_id || entry.resources.size() != num_resources)
+				return false;
+
+			for (u8 i = 0; i < num_resources; ++i) {
+				const auto& key = entry.resources[i];
+				const auto& resource = resources[i];
+				if (key.id != resource.id
+					|| key.type != resource.type
+					|| !core::hash__str_equals(key.name.c_str(), resource.name ? resource.name : strings::g_empty))
+					return false;
+			}
+			return true;
+		}
+
+		void srb_mgr__set_key(srb_mgr_entry& entry, core::hash64_t hash, const srb_mgr_resource_desc* resources, const u8 num_resources)
+		{
+			entry.hash = hash;
+			entry.resources.resize(num_resources);
+			for (u8 i = 0; i < num_resources; ++i) {
+				auto& key = entry.resources[i];
+				key.name = resources[i].name ? resources[i].name : strings::g_empty;
+				key.id = resources[i].id;
+				key.type = resources[i].type;
+			}
 		}
 
 		void srb_mgr__get_handle(const srb_t& id, Diligent::IShaderResourceBinding** output)
@@ -3,23 +3,37 @@
 #include "./srb_manager.h"
 
 #include "../io/logger.h"
+#include "../core/hash_private.h"
 
 #include <ShaderResourceBinding.h>
 #include <PipelineState.h>
 
 namespace rengine {
 	namespace graphics {
+		struct srb_mgr_resource_key {
+			string name{};
+			entity id{};
+			resource_type type{ resource_type::unknow };
+		};
+
 		struct srb_mgr_entry {
-			core::hash_t id;
-			Diligent::IShaderResourceBinding* handle;
-			pipeline_state_t pipeline;
+			core::hash64_t hash{ 0 };
+			Diligent::IShaderResourceBinding* handle{ null };
+			pipeline_state_t pipeline{ no_pipeline_state };
+			// full key is kept to verify cache lookups
+			vector<srb_mgr_resource_key> resources{};
 		};
 		
-		typedef hash_map<srb_t, u32> srb_mgr_tbl;
+		typedef hash_map<core::hash64_t, srb_t> srb_mgr_tbl;
 
 		struct srb_mgr_state {
 			vector<srb_mgr_entry> entries;
 			srb_mgr_tbl srb_tbl;
+			core::hash_cache_stats cache_stats{
+				strings::profiler::srb_cache_hits,
+				strings::profiler::srb_cache_misses,
+				strings::profiler::srb_cache_collisions
+			};
 			io::ILog* log;
 		};
 		extern srb_mgr_state g_srb_mgr_state;
@@ -30,7 +44,10 @@ namespace rengine {
 		bool srb_mgr__assert_id(srb_t id);
 
 		Diligent::IShaderResourceBinding* srb_mgr__create(Diligent::IPipelineState* pipeline, const srb_mgr_create_desc& desc);
-		core::hash_t srb_mgr__build_hash(const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources);
+		core::hash64_t srb_mgr__build_hash(const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources);
+		srb_t srb_mgr__find(core::hash64_t hash, const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources);
+		bool srb_mgr__equals(const srb_mgr_entry& entry, const pipeline_state_t pipeline_id, const srb_mgr_resource_desc* resources, const u8 num_resources);
+		void srb_mgr__set_key(srb_mgr_entry& entry, core::hash64_t hash, const srb_mgr_resource_desc* resources, const u8 num_resources);
 		void srb_mgr__get_handle(const srb_t& id, Diligent::IShaderResourceBinding** output);
 
 		Diligent::IDeviceObject* srb_mgr__get_device_obj(const srb_mgr_resource_desc& resource);
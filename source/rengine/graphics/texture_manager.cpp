@@ -2,6 +2,7 @@
 #include "./texture_manager_private.h"
 #include "./buffer_manager_private.h"
 #include "./graphics_private.h"
+#include "./frame_stats_private.h"
 
 namespace rengine {
 	namespace graphics {
@@ -160,6 +161,7 @@ namespace rengine {
 				data, 
 				Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, 
 				Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+			g_frame_stats_state.curr.uploaded_bytes += (u64)desc.stride * desc.box.size.y;
 		}
 		void texture_mgr_tex3d_update(texture_3d_t id, const texture3d_update_desc& desc)
 		{
@@ -14,14 +14,22 @@ namespace rengine {
 		}
 
 		void texture_mgr__deinit() {
-			for (auto& entry : g_texture_mgr_state.textures_2d)
-				texture_mgr_destroy_tex2d(entry.id);
-			for (auto& entry : g_texture_mgr_state.textures_3d)
-				texture_mgr_destroy_tex3d(entry.id);
-			for (auto& entry : g_texture_mgr_state.textures_cube)
-				texture_mgr_destroy_texcube(entry.id);
-			for (auto& entry : g_texture_mgr_state.textures_array)
-				texture_mgr_destroy_texarray(entry.id);
+			auto& state = g_texture_mgr_state;
+			// destroy erases from pool, then we can't iterate over it
+			while (!state.textures_2d.empty())
+				texture_mgr_destroy_tex2d(state.textures_2d.begin()->id);
+			while (!state.textures_3d.empty())
+				texture_mgr_destroy_tex3d(state.textures_3d.begin()->id);
+			while (!state.textures_cube.empty())
+				texture_mgr_destroy_texcube(state.textures_cube.begin()->id);
+			while (!state.textures_array.empty())
+				texture_mgr_destroy_texarray(state.textures_array.begin()->id);
+
+			state.textures_2d.release();
+			state.textures_3d.release();
+			state.textures_cube.release();
+			state.textures_array.release();
+			state.white_dummy_tex2d = no_texture_2d;
 		}
 
 		void texture_mgr__init_dummy_white_tex2d()
@@ -124,7 +132,7 @@ namespace rengine {
 			return texture;
 		}
 
-		void texture_mgr__get_internal_handle(texture_type type, u16 id, Diligent::ITexture** output)
+		void texture_mgr__get_internal_handle(texture_type type, u32 id, Diligent::ITexture** output)
 		{
 			if (!output)
 				return;
@@ -13,10 +13,10 @@ namespace rengine {
 		};
 
 		struct texture_manager_state {
-			core::array_pool<texture_entry, GRAPHICS_MAX_ALLOC_TEX2D> textures_2d{};
-			core::array_pool<texture_entry, GRAPHICS_MAX_ALLOC_TEX3D> textures_3d{};
-			core::array_pool<texture_entry, GRAPHICS_MAX_ALLOC_TEXCUBE> textures_cube{};
-			core::array_pool<texture_entry, GRAPHICS_MAX_ALLOC_TEXARRAY> textures_array{};
+			core::paged_pool<texture_entry, GRAPHICS_TEXTURE_POOL_PAGE_SIZE> textures_2d{};
+			core::paged_pool<texture_entry, GRAPHICS_TEXTURE_POOL_PAGE_SIZE> textures_3d{};
+			core::paged_pool<texture_entry, GRAPHICS_TEXTURE_POOL_PAGE_SIZE> textures_cube{};
+			core::paged_pool<texture_entry, GRAPHICS_TEXTURE_POOL_PAGE_SIZE> textures_array{};
 
 			texture2d_t white_dummy_tex2d{ no_texture_2d };
 			io::ILog* log{ null };
@@ -56,6 +56,6 @@ namespace rengine {
 
                 Diligent::ITexture* texture_mgr__create(Diligent::TextureDesc& desc, Diligent::TextureData& data, bool gen_mipmap);
 
-                void texture_mgr__get_internal_handle(texture_type type, u16 id, Diligent::ITexture** output);
+                void texture_mgr__get_internal_handle(texture_type type, u32 id, Diligent::ITexture** output);
         }
 }
\ No newline at end of file
@@ -1,29 +1,34 @@
 #include "./logger.h"
 #include "./logger_private.h"
+#include "./logger_async_private.h"
 
 #include "../exceptions.h"
 
+#include <EASTL/algorithm.h>
+
 namespace rengine {
 	namespace io {
 
 		void logger_info(c_str tag, c_str msg) {
-			logger__assert_logger();
-			g_logger_state.current_logger->onLogInfo(tag, msg);
+			logger__log(log_level::info, tag, msg);
 		}
 	
 		void logger_warn(c_str tag, c_str msg) {
-			logger__assert_logger();
-			g_logger_state.current_logger->onLogWarn(tag, msg);
+			logger__log(log_level::warn, tag, msg);
 		}
 		
 		void logger_error(c_str tag, c_str msg) {
-			logger__assert_logger();
-			g_logger_state.current_logger->onLogError(tag, msg);
+			logger__log(log_level::error, tag, msg);
 		}
 
 		void logger_fatal(c_str tag, c_str msg) {
+			logger__log(log_level::fatal, tag, msg);
+		}
+
+		void logger_log_args(log_level level, c_str tag, c_str format, const log_arg* args, u32 num_args) {
 			logger__assert_logger();
-			g_logger_state.current_logger->onLogFatal(tag, msg);
+			if (logger__is_enabled(level, tag))
+				logger_async__push_fmt(level, tag, format, args, num_args);
 		}
 
 		ILog* logger_use(c_str tag) {
@@ -38,5 +43,56 @@ namespace rengine {
 		ILogger* logger_get() {
 			return g_logger_state.current_logger;
 		}
+
+		bool logger_site_acquire(log_site& site, log_level level, c_str tag) {
+			return logger__site_acquire(site, level, tag);
+		}
+
+		void logger_set_level(log_level level) {
+			g_logger_state.min_level.store((u8)level, std::memory_order_relaxed);
+		}
+
+		log_level logger_get_level() {
+			return (log_level)g_logger_state.min_level.load(std::memory_order_relaxed);
+		}
+
+		void logger_set_tag_level(c_str tag, log_level level) {
+			if (!tag)
+				return;
+
+			auto& state = g_logger_state;
+			std::lock_guard<std::mutex> lock(state.tag_lock);
+			auto it = eastl::find_if(state.tag_levels.begin(), state.tag_levels.end(), [tag](const logger_tag_level& entry) {
+				return entry.tag == tag;
+			});
+			if (it != state.tag_levels.end())
+				it->level = level;
+			else
+				state.tag_levels.push_back({ string(tag), level });
+
+			state.num_tag_levels.store((u32)state.tag_levels.size(), std::memory_order_release);
+			logger__update_logs_level();
+		}
+
+		log_level logger_get_tag_level(c_str tag) {
+			if (!tag)
+				return log_level::info;
+
+			std::lock_guard<std::mutex> lock(g_logger_state.tag_lock);
+			return logger__find_tag_level(tag);
+		}
+
+		void logger_flush() {
+			logger__flush_sites(true);
+			logger_async__flush();
+		}
+
+		void logger_set_flush_on_error(bool enabled) {
+			g_logger_async_state.flush_on_error.store(enabled, std::memory_order_relaxed);
+		}
+
+		bool logger_get_flush_on_error() {
+			return g_logger_async_state.flush_on_error.load(std::memory_order_relaxed);
+		}
 	}
 }
\ No newline at end of file
@@ -2,14 +2,134 @@
 #include <rengine/api.h>
 #include <rengine/types.h>
 
+#include <atomic>
+#include <concepts>
+#include <type_traits>
+
 namespace rengine {
 	namespace io {
+		enum class log_level : u8 {
+			info = 0,
+			warn,
+			error,
+			fatal
+		};
+
+		/*
+		* Argument captured by logger_log_fmt.
+		* Values are copied at call site, strings are copied into log record
+		* then formatting is deferred to logger thread.
+		*/
+		struct log_arg {
+			enum class kind : u8 {
+				none = 0,
+				i64,
+				u64,
+				f64,
+				boolean,
+				str,
+				ptr,
+			};
+
+			kind type{ kind::none };
+			union {
+				i64 i;
+				u64 u;
+				double d;
+				bool b;
+				c_str s;
+				const void* p;
+			};
+
+			log_arg() : u(0) {}
+			log_arg(bool value) : type(kind::boolean), b(value) {}
+			log_arg(char value) : type(kind::i64), i(value) {}
+			log_arg(float value) : type(kind::f64), d(value) {}
+			log_arg(double value) : type(kind::f64), d(value) {}
+			log_arg(c_str value) : type(kind::str), s(value) {}
+			log_arg(char* value) : type(kind::str), s(value) {}
+			log_arg(const void* value) : type(kind::ptr), p(value) {}
+
+			template<typename T> requires (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+			log_arg(T value) {
+				if constexpr (std::is_signed_v<T>) {
+					type = kind::i64;
+					i = (i64)value;
+				}
+				else {
+					type = kind::u64;
+					u = (u64)value;
+				}
+			}
+
+			template<typename T> requires std::is_enum_v<T>
+			log_arg(T value) : type(kind::i64), i((i64)value) {}
+
+			// any string type, like eastl::string or std::string
+			template<typename T> requires requires(const T& value) { { value.c_str() } -> std::convertible_to<c_str>; }
+			log_arg(const T& value) : type(kind::str), s(value.c_str()) {}
+		};
+
+		R_EXPORT void logger_log_args(log_level level, c_str tag, c_str format, const log_arg* args, u32 num_args);
+
+		// format must be a static string, it's only resolved by logger thread
+		template<typename... Args>
+		void logger_log_fmt(log_level level, c_str tag, c_str format, const Args&... args) {
+			static_assert(sizeof...(Args) <= IO_LOGGER_MAX_ARGS, "Too many log arguments. Increase IO_LOGGER_MAX_ARGS");
+			const log_arg log_args[] = { log_arg(args)..., log_arg() };
+			logger_log_args(level, tag, format, log_args, sizeof...(Args));
+		}
+
+		/*
+		* Rate limit state of a single call site, must have static storage.
+		* Each site logs at most IO_LOGGER_SITE_MAX_PER_WINDOW messages per window,
+		* remaining ones are counted and reported as a single message when window expires
+		* or logger is flushed. Tag must outlive logger, as tags of ILog does.
+		*/
+		struct log_site {
+			std::atomic<u64> window{ 0 };
+			std::atomic<u32> num_logged{ 0 };
+			std::atomic<u32> num_suppressed{ 0 };
+			// set on first suppression, site is then tracked by logger to report its count
+			std::atomic<bool> tracked{ false };
+			log_level level{ log_level::info };
+			c_str tag{ null };
+		};
+
+		// returns false if message must be skipped, also logs suppressed count of previous window
+		R_EXPORT bool logger_site_acquire(log_site& site, log_level level, c_str tag);
+		// global minimum level, applied to all tags
+		R_EXPORT void logger_set_level(log_level level);
+		R_EXPORT log_level logger_get_level();
+		// minimum level of tag and its sub tags
+		R_EXPORT void logger_set_tag_level(c_str tag, log_level level);
+		R_EXPORT log_level logger_get_tag_level(c_str tag);
+
 		class ILogger {
 		public:
 			virtual void onLogInfo(c_str tag, c_str msg) = 0;
 			virtual void onLogWarn(c_str tag, c_str msg) = 0;
 			virtual void onLogError(c_str tag, c_str msg) = 0;
 			virtual void onLogFatal(c_str tag, c_str msg) = 0;
+			// called from logger thread, timestamp is system clock nanoseconds when message was logged
+			virtual void onLog(log_level level, u64 timestamp, c_str tag, c_str msg) {
+				switch (level) {
+				case log_level::info:
+					onLogInfo(tag, msg);
+					break;
+				case log_level::warn:
+					onLogWarn(tag, msg);
+					break;
+				case log_level::error:
+					onLogError(tag, msg);
+					break;
+				case log_level::fatal:
+					onLogFatal(tag, msg);
+					break;
+				}
+			}
+			// called after each batch of messages has been delivered
+			virtual void onFlush() {}
 		};
 
 		class ILog {
@@ -19,6 +139,36 @@ namespace rengine {
 			virtual void error(c_str msg) = 0;
 			virtual void fatal(c_str msg) = 0;
 			virtual ILog* use(c_str sub_tag) = 0;
+			virtual c_str get_tag() const { return null; }
+			// checked before arguments are captured
+			virtual bool enabled(log_level level) const { return true; }
+
+			template<typename... Args>
+			void log_fmt(log_level level, c_str format, const Args&... args) {
+				if (enabled(level))
+					logger_log_fmt(level, get_tag(), format, args...);
+			}
+			template<typename... Args>
+			void site_fmt(log_site& site, log_level level, c_str format, const Args&... args) {
+				if (enabled(level) && logger_site_acquire(site, level, get_tag()))
+					logger_log_fmt(level, get_tag(), format, args...);
+			}
+			template<typename... Args>
+			void info_fmt(c_str format, const Args&... args) {
+				log_fmt(log_level::info, format, args...);
+			}
+			template<typename... Args>
+			void warn_fmt(c_str format, const Args&... args) {
+				log_fmt(log_level::warn, format, args...);
+			}
+			template<typename... Args>
+			void error_fmt(c_str format, const Args&... args) {
+				log_fmt(log_level::error, format, args...);
+			}
+			template<typename... Args>
+			void fatal_fmt(c_str format, const Args&... args) {
+				log_fmt(log_level::fatal, format, args...);
+			}
 		};
 
 		typedef void (*__logger_call)(c_str tag, c_str msg);
@@ -31,5 +181,24 @@ namespace rengine {
 		R_EXPORT ILog* logger_use(c_str tag);
 		R_EXPORT void logger_set(ILogger* logger);
 		R_EXPORT ILogger* logger_get();
+		// blocks until all pending messages has been written
+		R_EXPORT void logger_flush();
+		// when enabled, error and fatal messages blocks caller until they're written
+		R_EXPORT void logger_set_flush_on_error(bool enabled);
+		R_EXPORT bool logger_get_flush_on_error();
 	}
-}
\ No newline at end of file
+}
+
+#define logger__concat_indirect(x, y) x##y
+#define logger__concat(x, y) logger__concat_indirect(x, y)
+#define logger__site_def(line) logger__concat(___logger_site, line)
+// first argument of variadic list is the format string
+#define logger__log_limited(log, level, ...) \
+	do { \
+		static rengine::io::log_site logger__site_def(__LINE__); \
+		(log)->site_fmt(logger__site_def(__LINE__), rengine::io::log_level::level, __VA_ARGS__); \
+	} while(0)
+
+#define log_info_limited(log, ...) logger__log_limited(log, info, __VA_ARGS__)
+#define log_warn_limited(log, ...) logger__log_limited(log, warn, __VA_ARGS__)
+#define log_error_limited(log, ...) logger__log_limited(log, error, __VA_ARGS__)
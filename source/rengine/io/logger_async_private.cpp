@@ -0,0 +1,464 @@
+#include "./logger_async_private.h"
+#include "./logger_private.h"
+
+#include "../core/allocator.h"
+#include "../core/profiler.h"
+#include "../strings.h"
+
+#include <EASTL/sort.h>
+#include <fmt/args.h>
+
+#include <chrono>
+#include <string.h>
+
+namespace rengine {
+	namespace io {
+		logger_async_state g_logger_async_state = {};
+		thread_local logger_thread g_logger_thread = {};
+		// trivially destructible, then it can be checked while other thread locals are being destroyed
+		static thread_local bool g_logger_thread_destroyed = false;
+		// logger thread writes synchronously, it can't wait for itself
+		static thread_local bool g_logger_thread_is_worker = false;
+
+		logger_thread::~logger_thread()
+		{
+			// pending records are still written, ring is released by logger thread
+			g_logger_thread_destroyed = true;
+			if (ring)
+				ring->exited.store(true, std::memory_order_release);
+			ring = null;
+		}
+
+		void logger_async__init()
+		{
+			auto& state = g_logger_async_state;
+			state.running.store(true, std::memory_order_release);
+			state.worker = std::thread(logger_async__worker_main);
+		}
+
+		void logger_async__stop()
+		{
+			auto& state = g_logger_async_state;
+			if (!state.running.exchange(false, std::memory_order_acq_rel))
+				return;
+
+			logger_async__wake();
+			state.worker.join();
+		}
+
+		void logger_async__deinit()
+		{
+			auto& state = g_logger_async_state;
+			logger_async__stop();
+
+			std::lock_guard<std::mutex> lock(state.lock);
+			auto* ring = state.rings;
+			while (ring) {
+				auto* next = ring->next;
+				ring->~logger_ring();
+				core::alloc_free(ring);
+				ring = next;
+			}
+			state.rings = null;
+			g_logger_thread.ring = null;
+
+			state.batch.clear();
+			state.batch.shrink_to_fit();
+			state.batch_rings.clear();
+			state.batch_rings.shrink_to_fit();
+			state.batch_order.clear();
+			state.batch_order.shrink_to_fit();
+		}
+
+		void logger_async__push(log_level level, c_str tag, c_str msg)
+		{
+			logger_record record;
+			record.format = null;
+			record.text_size = 0;
+			record.num_args = 0;
+			record.level = level;
+			if (level >= log_level::error && logger_async__text_size(tag, msg, null, 0) > IO_LOGGER_RECORD_TEXT_SIZE) {
+				logger_async__write_oversized(level, tag, msg, null, null, 0);
+				return;
+			}
+			logger_async__copy_text(record, tag);
+			record.msg_offset = logger_async__copy_text(record, msg);
+			logger_async__submit(record);
+		}
+
+		void logger_async__push_fmt(log_level level, c_str tag, c_str format, const log_arg* args, u32 num_args)
+		{
+			logger_record record;
+			record.format = format;
+			record.text_size = 0;
+			record.msg_offset = 0;
+			record.num_args = (u8)(num_args < IO_LOGGER_MAX_ARGS ? num_args : IO_LOGGER_MAX_ARGS);
+			record.level = level;
+			if (level >= log_level::error && logger_async__text_size(tag, null, args, record.num_args) > IO_LOGGER_RECORD_TEXT_SIZE) {
+				logger_async__write_oversized(level, tag, null, format, args, record.num_args);
+				return;
+			}
+			logger_async__copy_text(record, tag);
+
+			// strings may be temporary, they're copied and referenced by offset
+			for (u8 i = 0; i < record.num_args; ++i) {
+				record.args[i] = args[i];
+				if (args[i].type == log_arg::kind::str)
+					record.args[i].u = logger_async__copy_text(record, args[i].s);
+			}
+			logger_async__submit(record);
+		}
+
+		void logger_async__flush()
+		{
+			auto& state = g_logger_async_state;
+			if (!state.running.load(std::memory_order_acquire) || g_logger_thread_is_worker)
+				return;
+
+			std::unique_lock<std::mutex> lock(state.wake_lock);
+			const u64 target = ++state.num_flush_requests;
+			state.wake_pending = true;
+			state.wake_cond.notify_one();
+			state.written_cond.wait(lock, [&state, target]() {
+				return state.num_flushes >= target || !state.running.load(std::memory_order_acquire);
+			});
+		}
+
+		void logger_async__worker_main()
+		{
+			auto& state = g_logger_async_state;
+			g_logger_thread_is_worker = true;
+			core::profiler_set_thread_name(strings::profiler::logger_thread);
+
+			while (true) {
+				u64 flush_requests;
+				{
+					std::unique_lock<std::mutex> lock(state.wake_lock);
+					state.wake_cond.wait_for(lock, std::chrono::milliseconds(IO_LOGGER_FLUSH_INTERVAL_MS), [&state]() {
+						return state.wake_pending || !state.running.load(std::memory_order_acquire);
+					});
+					state.wake_pending = false;
+					flush_requests = state.num_flush_requests;
+				}
+
+				// records pushed before stop request are still written
+				const bool stop = !state.running.load(std::memory_order_acquire);
+				// expired windows are reported even if their sites doesn't fire again
+				logger__flush_sites(false);
+				while (logger_async__drain() > 0);
+				logger_async__free_exited_rings();
+
+				{
+					std::lock_guard<std::mutex> lock(state.wake_lock);
+					state.num_flushes = flush_requests;
+				}
+				state.written_cond.notify_all();
+
+				if (stop)
+					break;
+			}
+		}
+
+		logger_ring* logger_async__get_ring()
+		{
+			auto& thread = g_logger_thread;
+			if (thread.ring)
+				return thread.ring;
+			if (g_logger_thread_destroyed || g_logger_thread_is_worker)
+				return null;
+
+			auto* ring = new (core::alloc(sizeof(logger_ring), core::alloc_tag::logger)) logger_ring();
+			auto& state = g_logger_async_state;
+			{
+				std::lock_guard<std::mutex> lock(state.lock);
+				ring->next = state.rings;
+				state.rings = ring;
+			}
+			thread.ring = ring;
+			return ring;
+		}
+
+		void logger_async__submit(logger_record& record)
+		{
+			auto& state = g_logger_async_state;
+			record.time = logger_async__get_time();
+
+			logger_ring* ring = state.running.load(std::memory_order_acquire) ? logger_async__get_ring() : null;
+			if (!ring) {
+				logger_async__write_sync(record);
+				return;
+			}
+
+			const bool is_error = record.level >= log_level::error;
+			while (!ring->queue.try_push(record)) {
+				logger_async__wake();
+				if (!is_error) {
+					state.num_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				// errors are never dropped, wait for logger thread
+				std::this_thread::yield();
+			}
+
+			const u64 num_pushed = ++ring->num_pushed;
+			if (is_error) {
+				logger_async__wake();
+				if (state.flush_on_error.load(std::memory_order_relaxed))
+					logger_async__wait_written(ring, num_pushed);
+			}
+			else if (ring->queue.size_approx() >= IO_LOGGER_RING_SIZE / 2) {
+				logger_async__wake();
+			}
+		}
+
+		void logger_async__write_sync(const logger_record& record)
+		{
+			auto& state = g_logger_async_state;
+			fmt::memory_buffer buffer;
+
+			std::lock_guard<std::mutex> lock(state.sink_lock);
+			auto* logger = g_logger_state.current_logger;
+			if (!logger)
+				return;
+			logger_async__write_record(logger, record, buffer);
+			logger->onFlush();
+		}
+
+		void logger_async__write_oversized(log_level level, c_str tag, c_str msg, c_str format, const log_arg* args, u32 num_args)
+		{
+			auto& state = g_logger_async_state;
+			// records queued before this one are written first to keep order
+			logger_async__flush();
+
+			fmt::memory_buffer buffer;
+			if (format) {
+				logger_async__format(buffer, format, args, num_args, null);
+				msg = buffer.data();
+			}
+
+			std::lock_guard<std::mutex> lock(state.sink_lock);
+			auto* logger = g_logger_state.current_logger;
+			if (!logger)
+				return;
+			logger->onLog(level, logger_async__get_time(), tag, msg ? msg : "");
+			logger->onFlush();
+		}
+
+		void logger_async__wake()
+		{
+			auto& state = g_logger_async_state;
+			{
+				std::lock_guard<std::mutex> lock(state.wake_lock);
+				if (state.wake_pending)
+					return;
+				state.wake_pending = true;
+			}
+			state.wake_cond.notify_one();
+		}
+
+		void logger_async__wait_written(logger_ring* ring, u64 num_pushed)
+		{
+			auto& state = g_logger_async_state;
+			std::unique_lock<std::mutex> lock(state.wake_lock);
+			state.written_cond.wait(lock, [&state, ring, num_pushed]() {
+				return ring->num_written.load(std::memory_order_acquire) >= num_pushed
+					|| !state.running.load(std::memory_order_acquire);
+			});
+		}
+
+		u32 logger_async__drain()
+		{
+			auto& state = g_logger_async_state;
+			u32 count = 0;
+			{
+				std::lock_guard<std::mutex> lock(state.lock);
+				u32 num_rings = 0;
+				for (auto* ring = state.rings; ring; ring = ring->next)
+					++num_rings;
+
+				// each ring gives at most one batch, a noisy thread can't starve the others
+				const u32 capacity = num_rings * IO_LOGGER_BATCH_SIZE;
+				if (state.batch.size() < capacity) {
+					state.batch.resize(capacity);
+					state.batch_rings.resize(capacity);
+					state.batch_order.resize(capacity);
+				}
+
+				for (auto* ring = state.rings; ring; ring = ring->next) {
+					const u32 num_items = ring->queue.try_pop_batch(state.batch.data() + count, IO_LOGGER_BATCH_SIZE);
+					for (u32 i = 0; i < num_items; ++i)
+						state.batch_rings[count + i] = ring;
+					count += num_items;
+				}
+			}
+
+			const u64 num_dropped = state.num_dropped.exchange(0, std::memory_order_relaxed);
+			if (count == 0 && num_dropped == 0)
+				return 0;
+
+			// rings are merged by time, records of same thread keeps their order
+			for (u32 i = 0; i < count; ++i)
+				state.batch_order[i] = i;
+			eastl::sort(state.batch_order.begin(), state.batch_order.begin() + count, [&state](u32 a, u32 b) {
+				const u64 a_time = state.batch[a].time;
+				const u64 b_time = state.batch[b].time;
+				return a_time == b_time ? a < b : a_time < b_time;
+			});
+
+			{
+				std::lock_guard<std::mutex> lock(state.sink_lock);
+				auto* logger = g_logger_state.current_logger;
+				if (logger) {
+					for (u32 i = 0; i < count; ++i)
+						logger_async__write_record(logger, state.batch[state.batch_order[i]], state.buffer);
+
+					if (num_dropped > 0) {
+						state.buffer.clear();
+						fmt::format_to(fmt::appender(state.buffer), strings::logs::g_logger_dropped_records, num_dropped, IO_LOGGER_RING_SIZE);
+						state.buffer.push_back('\0');
+						logger->onLog(log_level::warn, logger_async__get_time(), strings::logs::g_logger_tag, state.buffer.data());
+					}
+					logger->onFlush();
+				}
+			}
+
+			// records of same ring are contiguous on batch
+			u32 i = 0;
+			while (i < count) {
+				auto* ring = state.batch_rings[i];
+				u32 num_items = 0;
+				while (i < count && state.batch_rings[i] == ring) {
+					++num_items;
+					++i;
+				}
+				ring->num_written.store(ring->num_written.load(std::memory_order_relaxed) + num_items, std::memory_order_release);
+			}
+
+			// lock is required to not lose the notification of a thread that is about to wait
+			{
+				std::lock_guard<std::mutex> lock(state.wake_lock);
+			}
+			state.written_cond.notify_all();
+			return count;
+		}
+
+		void logger_async__free_exited_rings()
+		{
+			auto& state = g_logger_async_state;
+			std::lock_guard<std::mutex> lock(state.lock);
+
+			logger_ring** link = &state.rings;
+			while (*link) {
+				auto* ring = *link;
+				if (!ring->exited.load(std::memory_order_acquire) || !ring->queue.empty()) {
+					link = &ring->next;
+					continue;
+				}
+
+				*link = ring->next;
+				ring->~logger_ring();
+				core::alloc_free(ring);
+			}
+		}
+
+		void logger_async__write_record(ILogger* logger, const logger_record& record, fmt::memory_buffer& buffer)
+		{
+			c_str tag = record.text;
+			if (!record.format) {
+				logger->onLog(record.level, record.time, tag, record.text + record.msg_offset);
+				return;
+			}
+
+			logger_async__format(buffer, record.format, record.args, record.num_args, record.text);
+			logger->onLog(record.level, record.time, tag, buffer.data());
+		}
+
+		void logger_async__format(fmt::memory_buffer& buffer, c_str format, const log_arg* args, u32 num_args, c_str text)
+		{
+			fmt::dynamic_format_arg_store<fmt::format_context> store;
+			store.reserve(num_args, 0);
+			for (u32 i = 0; i < num_args; ++i) {
+				const auto& arg = args[i];
+				switch (arg.type) {
+				case log_arg::kind::i64:
+					store.push_back(arg.i);
+					break;
+				case log_arg::kind::u64:
+					store.push_back(arg.u);
+					break;
+				case log_arg::kind::f64:
+					store.push_back(arg.d);
+					break;
+				case log_arg::kind::boolean:
+					store.push_back(arg.b);
+					break;
+				case log_arg::kind::str:
+					store.push_back(fmt::string_view(text ? text + arg.u : (arg.s ? arg.s : "")));
+					break;
+				case log_arg::kind::ptr:
+					store.push_back(arg.p);
+					break;
+				default:
+					store.push_back(fmt::string_view());
+					break;
+				}
+			}
+
+			buffer.clear();
+			try {
+				fmt::vformat_to(fmt::appender(buffer), format, store);
+			}
+			catch (const fmt::format_error&) {
+				// invalid format is written as is, logger thread must never throw
+				buffer.clear();
+				buffer.append(fmt::string_view(format));
+			}
+			buffer.push_back('\0');
+		}
+
+		u16 logger_async__copy_text(logger_record& record, c_str str)
+		{
+			// last byte is always a terminator, truncated strings points to it
+			if (record.text_size >= IO_LOGGER_RECORD_TEXT_SIZE) {
+				record.text[IO_LOGGER_RECORD_TEXT_SIZE - 1] = '\0';
+				return IO_LOGGER_RECORD_TEXT_SIZE - 1;
+			}
+
+			const u16 offset = record.text_size;
+			const size_t room = IO_LOGGER_RECORD_TEXT_SIZE - offset - 1;
+			size_t length = str ? strlen(str) : 0;
+			const bool truncated = length > room;
+			length = truncated ? room : length;
+
+			if (length > 0)
+				memcpy(record.text + offset, str, length);
+			// truncated strings ends with a mark, then reader knows text is incomplete
+			const size_t mark_length = strlen(strings::logs::g_logger_truncated_mark);
+			if (truncated && length >= mark_length)
+				memcpy(record.text + offset + length - mark_length, strings::logs::g_logger_truncated_mark, mark_length);
+			record.text[offset + length] = '\0';
+			record.text_size = (u16)(offset + length + 1);
+			return offset;
+		}
+
+		size_t logger_async__text_size(c_str tag, c_str msg, const log_arg* args, u32 num_args)
+		{
+			// each string is stored with its terminator
+			size_t result = (tag ? strlen(tag) : 0) + 1;
+			if (msg)
+				result += strlen(msg) + 1;
+			for (u32 i = 0; i < num_args; ++i) {
+				if (args[i].type == log_arg::kind::str)
+					result += (args[i].s ? strlen(args[i].s) : 0) + 1;
+			}
+			return result;
+		}
+
+		u64 logger_async__get_time()
+		{
+			return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()
+			).count();
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "../base_private.h"
+#include "../core/ring_queue.h"
+#include "./logger.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <fmt/format.h>
+
+namespace rengine {
+	namespace io {
+		/*
+		* Fixed size log record, nothing is formatted at call site.
+		* Text stores tag followed by message, when format is set
+		* text stores string arguments and args.u is the offset of string on text.
+		*/
+		struct logger_record {
+			u64 time;
+			c_str format;
+			log_arg args[IO_LOGGER_MAX_ARGS];
+			u16 text_size;
+			u16 msg_offset;
+			u8 num_args;
+			log_level level;
+			char text[IO_LOGGER_RECORD_TEXT_SIZE];
+		};
+
+		// each thread owns a ring, logger thread is the single consumer of all rings
+		struct logger_ring {
+			logger_ring* next{ null };
+			// owner thread only
+			u64 num_pushed{ 0 };
+			// logger thread only writes it, owner waits for it when flush on error is enabled
+			std::atomic<u64> num_written{ 0 };
+			std::atomic<bool> exited{ false };
+			core::spsc_queue<logger_record, IO_LOGGER_RING_SIZE> queue;
+		};
+
+		struct logger_thread {
+			logger_ring* ring{ null };
+
+			~logger_thread();
+		};
+
+		struct logger_async_state {
+			std::thread worker;
+			std::atomic<bool> running{ false };
+			std::atomic<bool> flush_on_error{ true };
+			std::atomic<u64> num_dropped{ 0 };
+
+			// guards rings list
+			std::mutex lock;
+			logger_ring* rings{ null };
+
+			// guards current logger while logger thread is writing
+			std::mutex sink_lock;
+
+			std::mutex wake_lock;
+			std::condition_variable wake_cond;
+			std::condition_variable written_cond;
+			bool wake_pending{ false };
+			u64 num_flush_requests{ 0 };
+			u64 num_flushes{ 0 };
+
+			// logger thread only
+			vector<logger_record> batch;
+			vector<logger_ring*> batch_rings;
+			vector<u32> batch_order;
+			fmt::memory_buffer buffer;
+		};
+		extern logger_async_state g_logger_async_state;
+		extern thread_local logger_thread g_logger_thread;
+
+		void logger_async__init();
+		void logger_async__deinit();
+		// writes pending records and joins logger thread, next records are written synchronously
+		void logger_async__stop();
+
+		void logger_async__push(log_level level, c_str tag, c_str msg);
+		void logger_async__push_fmt(log_level level, c_str tag, c_str format, const log_arg* args, u32 num_args);
+		void logger_async__flush();
+
+		void logger_async__worker_main();
+		logger_ring* logger_async__get_ring();
+		void logger_async__submit(logger_record& record);
+		void logger_async__write_sync(const logger_record& record);
+		// error records that doesn't fit on record text are written synchronously, without truncation
+		void logger_async__write_oversized(log_level level, c_str tag, c_str msg, c_str format, const log_arg* args, u32 num_args);
+		void logger_async__wake();
+		void logger_async__wait_written(logger_ring* ring, u64 num_pushed);
+		// pops and writes records until all rings are empty, returns written count
+		u32 logger_async__drain();
+		void logger_async__free_exited_rings();
+		void logger_async__write_record(ILogger* logger, const logger_record& record, fmt::memory_buffer& buffer);
+		// formats args into buffer with a terminator, string args are read from text at arg.u when text is set
+		void logger_async__format(fmt::memory_buffer& buffer, c_str format, const log_arg* args, u32 num_args, c_str text);
+		u16 logger_async__copy_text(logger_record& record, c_str str);
+		// bytes required on record text to store tag, message and string args
+		size_t logger_async__text_size(c_str tag, c_str msg, const log_arg* args, u32 num_args);
+		u64 logger_async__get_time();
+	}
+}
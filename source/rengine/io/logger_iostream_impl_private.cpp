@@ -2,44 +2,70 @@
 #include "../strings.h"
 
 #include <iostream>
-#include <ctime>
-#include <fmt/format.h>
+#include <chrono>
 
 namespace rengine {
 	namespace io {
 		void IOStreamLogger::onLogInfo(c_str tag, c_str msg) {
-			onLog(log_type::info, tag, msg);
+			onLog(log_level::info, 0, tag, msg);
+			onFlush();
 		}
 
 		void IOStreamLogger::onLogWarn(c_str tag, c_str msg) {
-			onLog(log_type::warn, tag, msg);
+			onLog(log_level::warn, 0, tag, msg);
+			onFlush();
 		}
 
 		void IOStreamLogger::onLogError(c_str tag, c_str msg) {
-			onLog(log_type::err, tag, msg);
+			onLog(log_level::error, 0, tag, msg);
+			onFlush();
 		}
 
 		void IOStreamLogger::onLogFatal(c_str tag, c_str msg) {
-			onLog(log_type::fatal, tag, msg);
+			onLog(log_level::fatal, 0, tag, msg);
+			onFlush();
 		}
 
-		void IOStreamLogger::onLog(log_type type, c_str tag, c_str msg) {
-			auto t = time(null);
-			tm* time = localtime(&t);
+		void IOStreamLogger::onLog(log_level level, u64 timestamp, c_str tag, c_str msg) {
+			const tm& time = getTime(timestamp);
 
-			std::cout << fmt::format(strings::logs::g_logger_fmt,
-				time->tm_mday,
-				time->tm_mon,
-				time->tm_year,
+			fmt::format_to(fmt::appender(buffer_), strings::logs::g_logger_fmt,
+				time.tm_mday,
+				time.tm_mon + 1,
+				time.tm_year + 1900,
 
-				time->tm_hour,
-				time->tm_min,
-				time->tm_sec,
+				time.tm_hour,
+				time.tm_min,
+				time.tm_sec,
 
-				g_log_type_entries[(u8)type],
+				g_log_level_entries[(u8)level],
 				tag,
 				msg
-			) << std::endl;
+			);
+			buffer_.push_back('\n');
+		}
+
+		void IOStreamLogger::onFlush() {
+			std::cout.write(buffer_.data(), buffer_.size());
+			std::cout.flush();
+			buffer_.clear();
+		}
+
+		const tm& IOStreamLogger::getTime(u64 timestamp) {
+			// direct calls has no timestamp
+			const time_t t = timestamp != 0
+				? (time_t)(timestamp / 1000000000ull)
+				: std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+			if (t == last_time_)
+				return last_tm_;
+
+			last_time_ = t;
+#if PLATFORM_WINDOWS
+			localtime_s(&last_tm_, &t);
+#else
+			localtime_r(&t, &last_tm_);
+#endif
+			return last_tm_;
 		}
 	}
-}
\ No newline at end of file
+}
@@ -2,22 +2,22 @@
 #include "../base_private.h"
 #include "./logger.h"
 
+#include <ctime>
+#include <fmt/format.h>
+
 namespace rengine {
 	namespace io {
-		enum class log_type {
-			info = 0,
-			warn,
-			err,
-			fatal
-		};
-
-		constexpr static c_str g_log_type_entries[] = {
+		constexpr static c_str g_log_level_entries[] = {
 			"info",
 			"warn",
 			"error",
 			"fatal"
 		};
 
+		/*
+		* Messages are appended to a buffer and written to stdout
+		* once per batch, then stream is flushed only on onFlush.
+		*/
 		class IOStreamLogger : public ILogger {
 		public:
 			IOStreamLogger() {}
@@ -25,8 +25,15 @@ namespace rengine {
 			void onLogWarn(c_str tag, c_str msg) override;
 			void onLogError(c_str tag, c_str msg) override;
 			void onLogFatal(c_str tag, c_str msg) override;
+			void onLog(log_level level, u64 timestamp, c_str tag, c_str msg) override;
+			void onFlush() override;
 		private:
-			void onLog(log_type type, c_str tag, c_str msg);
+			const tm& getTime(u64 timestamp);
+
+			fmt::memory_buffer buffer_;
+			// localtime is resolved once per second
+			time_t last_time_{ -1 };
+			tm last_tm_{};
 		};
 	}
-}
\ No newline at end of file
+}
@@ -1,11 +1,15 @@
 #include "./logger_private.h"
 #include "./logger_iostream_impl_private.h"
+#include "./logger_async_private.h"
 
 #include "../core/allocator.h"
 #include "../strings.h"
 #include "../exceptions.h"
 
 #include <fmt/format.h>
+#include <EASTL/algorithm.h>
+
+#include <chrono>
 
 namespace rengine {
 	namespace io {
@@ -13,34 +17,61 @@ namespace rengine {
 
 		class InternalLog : public ILog {
 		public:
-			InternalLog(const string& tag) : tag_(tag) {}
+			InternalLog(const string& tag, log_level level) : tag_(tag), level_((u8)level) {}
 			void info(c_str msg) override {
-				logger_info(tag_.c_str(), msg);
+				log(log_level::info, msg);
 			}
 			void warn(c_str msg) override {
-				logger_warn(tag_.c_str(), msg);
+				log(log_level::warn, msg);
 			}
 			void error(c_str msg) override {
-				logger_error(tag_.c_str(), msg);
+				log(log_level::error, msg);
 			}
 			void fatal(c_str msg) override {
-				logger_fatal(tag_.c_str(), msg);
+				log(log_level::fatal, msg);
+			}
+			c_str get_tag() const override {
+				return tag_.c_str();
+			}
+			bool enabled(log_level level) const override {
+				return (u8)level >= level_.load(std::memory_order_relaxed)
+					&& (u8)level >= g_logger_state.min_level.load(std::memory_order_relaxed);
 			}
 			ILog* use(c_str sub_tag) override {
 				if (sub_tag == null)
 					return this;
 				return logger__alloc_log(string(fmt::format("{0}::{1}", tag_, sub_tag).c_str()));
 			}
+			void log(log_level level, c_str msg) {
+				if (!enabled(level))
+					return;
+				logger__assert_logger();
+				logger_async__push(level, tag_.c_str(), msg);
+			}
+
 			string tag_;
+			// resolved from tag levels, updated when a tag level changes
+			std::atomic<u8> level_;
 		};
 
 		void logger__init() {
-			g_logger_state.current_logger = core::alloc_new<IOStreamLogger>();
+			g_logger_state.current_logger = core::alloc_new_tagged<IOStreamLogger>(core::alloc_tag::logger);
+			logger_async__init();
+		}
+
+		void logger__stop()
+		{
+			logger__flush_sites(true);
+			logger_async__stop();
 		}
 
 		void logger__deinit()
 		{
 			auto& state = g_logger_state;
+			// suppressed counts are still reported, site tags are released with logs
+			logger__flush_sites(true);
+			// pending records are written before loggers are released
+			logger_async__deinit();
 
 			if(state.current_logger != null)
 				core::alloc_free(state.current_logger);
@@ -51,7 +82,17 @@ namespace rengine {
 				state.logs.pop();
 			}
 
-			g_logger_state = {};
+			state.current_logger = null;
+			state.num_logs = 0;
+			state.min_level.store((u8)log_level::info, std::memory_order_relaxed);
+			state.tag_levels.clear();
+			state.num_tag_levels.store(0, std::memory_order_relaxed);
+
+			std::lock_guard<std::mutex> lock(state.site_lock);
+			for (auto* site : state.sites)
+				site->tracked.store(false, std::memory_order_relaxed);
+			state.sites.clear();
+			state.num_sites.store(0, std::memory_order_relaxed);
 		}
 
 		void logger__assert_logger() {
@@ -64,6 +105,10 @@ namespace rengine {
 
 		void logger__change_default_logger(ILogger* logger)
 		{
+			// pending records belongs to previous logger
+			logger_async__flush();
+
+			std::lock_guard<std::mutex> lock(g_logger_async_state.sink_lock);
 			if (g_logger_state.current_logger)
 				core::alloc_free(g_logger_state.current_logger);
 			g_logger_state.current_logger = logger;
@@ -76,10 +121,138 @@ namespace rengine {
 					fmt::format(strings::exceptions::g_logger_reached_max_log_objects).c_str()
 				);
 
-			ILog* log_obj = core::alloc_new<InternalLog>(tag);
+			std::lock_guard<std::mutex> lock(g_logger_state.tag_lock);
+			ILog* log_obj = core::alloc_new_tagged<InternalLog>(core::alloc_tag::logger, tag, logger__find_tag_level(tag.c_str()));
 			g_logger_state.logs.push(log_obj);
 			++g_logger_state.num_logs;
 			return log_obj;
 		}
+
+		void logger__log(log_level level, c_str tag, c_str msg)
+		{
+			logger__assert_logger();
+			if (logger__is_enabled(level, tag))
+				logger_async__push(level, tag, msg);
+		}
+
+		bool logger__is_enabled(log_level level, c_str tag)
+		{
+			auto& state = g_logger_state;
+			if ((u8)level < state.min_level.load(std::memory_order_relaxed))
+				return false;
+			if (state.num_tag_levels.load(std::memory_order_acquire) == 0 || !tag)
+				return true;
+
+			std::lock_guard<std::mutex> lock(state.tag_lock);
+			return level >= logger__find_tag_level(tag);
+		}
+
+		bool logger__site_acquire(log_site& site, log_level level, c_str tag)
+		{
+			const u64 window = logger__site_window();
+
+			// only one thread wins window change, it reports what has been suppressed until now
+			u32 num_suppressed = 0;
+			u64 curr_window = site.window.load(std::memory_order_relaxed);
+			if (curr_window != window && site.window.compare_exchange_strong(curr_window, window, std::memory_order_relaxed)) {
+				site.num_logged.store(0, std::memory_order_relaxed);
+				num_suppressed = site.num_suppressed.exchange(0, std::memory_order_relaxed);
+			}
+
+			if (site.num_logged.fetch_add(1, std::memory_order_relaxed) >= IO_LOGGER_SITE_MAX_PER_WINDOW) {
+				site.num_suppressed.fetch_add(1, std::memory_order_relaxed);
+				if (!site.tracked.load(std::memory_order_relaxed))
+					logger__site_track(site, level, tag);
+				return false;
+			}
+
+			if (num_suppressed > 0)
+				logger_log_fmt(level, tag, strings::logs::g_logger_site_suppressed, num_suppressed, IO_LOGGER_SITE_MAX_PER_WINDOW, IO_LOGGER_SITE_WINDOW_MS);
+			return true;
+		}
+
+		u64 logger__site_window()
+		{
+			return (u64)std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()
+			).count() / IO_LOGGER_SITE_WINDOW_MS;
+		}
+
+		void logger__site_track(log_site& site, log_level level, c_str tag)
+		{
+			auto& state = g_logger_state;
+			std::lock_guard<std::mutex> lock(state.site_lock);
+			if (site.tracked.load(std::memory_order_relaxed))
+				return;
+
+			site.level = level;
+			site.tag = tag;
+			site.tracked.store(true, std::memory_order_relaxed);
+			state.sites.push_back(&site);
+			state.num_sites.store((u32)state.sites.size(), std::memory_order_release);
+		}
+
+		void logger__flush_sites(bool force)
+		{
+			auto& state = g_logger_state;
+			if (state.num_sites.load(std::memory_order_acquire) == 0)
+				return;
+
+			// counts are taken by exchange, then a count is reported once even if site fires concurrently
+			struct site_report {
+				log_level level;
+				c_str tag;
+				u32 num_suppressed;
+			};
+			vector<site_report> reports;
+			const u64 window = logger__site_window();
+			{
+				std::lock_guard<std::mutex> lock(state.site_lock);
+				for (auto* site : state.sites) {
+					if (!force && site->window.load(std::memory_order_relaxed) == window)
+						continue;
+
+					const u32 num_suppressed = site->num_suppressed.exchange(0, std::memory_order_relaxed);
+					if (num_suppressed > 0)
+						reports.push_back({ site->level, site->tag, num_suppressed });
+				}
+			}
+
+			// errors waits for logger thread, which also flushes sites, then lock can't be held while logging
+			for (const auto& report : reports)
+				logger_log_fmt(report.level, report.tag, strings::logs::g_logger_site_suppressed, report.num_suppressed, IO_LOGGER_SITE_MAX_PER_WINDOW, IO_LOGGER_SITE_WINDOW_MS);
+		}
+
+		log_level logger__find_tag_level(c_str tag)
+		{
+			// most specific tag wins, tag level also applies to sub tags "tag::sub_tag"
+			const auto& tag_levels = g_logger_state.tag_levels;
+			const size_t tag_len = strlen(tag);
+			log_level result = log_level::info;
+			size_t result_len = 0;
+
+			for (const auto& entry : tag_levels) {
+				const size_t entry_len = entry.tag.size();
+				if (entry_len > tag_len || entry_len < result_len)
+					continue;
+				if (memcmp(entry.tag.c_str(), tag, entry_len) != 0)
+					continue;
+				if (entry_len != tag_len && (tag[entry_len] != ':' || tag[entry_len + 1] != ':'))
+					continue;
+
+				result = entry.level;
+				result_len = entry_len;
+			}
+			return result;
+		}
+
+		void logger__update_logs_level()
+		{
+			auto& logs = g_logger_state.logs.get_container();
+			for (auto* log : logs) {
+				auto* internal_log = static_cast<InternalLog*>(log);
+				internal_log->level_.store((u8)logger__find_tag_level(internal_log->tag_.c_str()), std::memory_order_relaxed);
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -2,19 +2,51 @@
 #include "../base_private.h"
 #include "./logger.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace rengine {
 	namespace io {
+		struct logger_tag_level {
+			string tag;
+			log_level level;
+		};
+
 		struct logger_state {
 			ILogger* current_logger{ null };
 			queue<ILog*> logs;
 			u32 num_logs;
+
+			std::atomic<u8> min_level{ (u8)log_level::info };
+			// guards tag levels and logs levels updates
+			std::mutex tag_lock;
+			vector<logger_tag_level> tag_levels;
+			// lets free log functions skip tag lookup when there's no tag level
+			std::atomic<u32> num_tag_levels{ 0 };
+
+			// sites that suppressed messages, guarded by site lock
+			std::mutex site_lock;
+			vector<log_site*> sites;
+			std::atomic<u32> num_sites{ 0 };
 		};
 		extern logger_state g_logger_state;
 
 		void logger__init();
 		void logger__deinit();
+		// joins logger thread, logs are still written synchronously until deinit
+		void logger__stop();
 		void logger__assert_logger();
 		void logger__change_default_logger(ILogger* logger);
 		ILog* logger__alloc_log(const string& tag);
+		void logger__log(log_level level, c_str tag, c_str msg);
+		bool logger__is_enabled(log_level level, c_str tag);
+		bool logger__site_acquire(log_site& site, log_level level, c_str tag);
+		u64 logger__site_window();
+		void logger__site_track(log_site& site, log_level level, c_str tag);
+		// reports suppressed counts of expired windows, or of all sites when forced
+		void logger__flush_sites(bool force);
+		// tag lock must be held by caller
+		log_level logger__find_tag_level(c_str tag);
+		void logger__update_logs_level();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "./batch.h"
+#include "./matrix4x4.h"
+#include "./simd_private.h"
+
+#include "../core/allocator.h"
+
+namespace rengine {
+	namespace math {
+		static_assert(sizeof(vec3) == sizeof(number_t) * 3, "vec3 must be tightly packed to be loaded by batch kernels");
+		static_assert(sizeof(vec4) == sizeof(number_t) * 4, "vec4 must be tightly packed to be loaded by batch kernels");
+
+		// returns element count that can be processed by simd kernels
+		static size_t batch__simd_count(const vec3_soa& in, const vec3_soa& out, size_t count)
+		{
+			// padding elements are computed too when both streams have room for them
+			const size_t padded_count = (count + 3) & ~(size_t)3;
+			if (padded_count <= in.capacity && padded_count <= out.capacity)
+				return padded_count;
+			return count & ~(size_t)3;
+		}
+
+		static vec3_soa batch__offset(const vec3_soa& soa, size_t offset)
+		{
+			return { soa.x + offset, soa.y + offset, soa.z + offset, soa.capacity - offset };
+		}
+
+		vec3_soa vec3_soa_alloc(size_t count)
+		{
+			vec3_soa result;
+			if (count == 0)
+				return result;
+
+			const size_t capacity = (count + MATH_BATCH_PADDING - 1) & ~(size_t)(MATH_BATCH_PADDING - 1);
+			// components are stored on a single block, capacity keeps each stream aligned
+			const size_t stream_size = capacity * sizeof(number_t);
+			number_t* data = static_cast<number_t*>(
+				core::alloc_aligned(stream_size * 3, MATH_BATCH_ALIGNMENT)
+			);
+			memset(data, 0, stream_size * 3);
+
+			result.x = data;
+			result.y = data + capacity;
+			result.z = data + capacity * 2;
+			result.capacity = capacity;
+			return result;
+		}
+
+		void vec3_soa_free(vec3_soa& soa)
+		{
+			if (soa.x)
+				core::alloc_free_aligned(soa.x);
+			soa = {};
+		}
+
+		void vec3_soa_from_aos(const vec3* data, vec3_soa& soa, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i) {
+				soa.x[i] = data[i].x;
+				soa.y[i] = data[i].y;
+				soa.z[i] = data[i].z;
+			}
+		}
+
+		void vec3_soa_to_aos(const vec3_soa& soa, vec3* data, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+				data[i] = vec3(soa.x[i], soa.y[i], soa.z[i]);
+		}
+
+		void transform_points(const matrix4x4& m, const vec3* in, vec3* out, size_t count)
+		{
+			const size_t simd_count = count & ~(size_t)3;
+			g_simd_state.kernels.transform_points(&m.m[0][0], reinterpret_cast<const number_t*>(in), reinterpret_cast<number_t*>(out), simd_count);
+			simd__transform_points_scalar(&m.m[0][0], reinterpret_cast<const number_t*>(in + simd_count), reinterpret_cast<number_t*>(out + simd_count), count - simd_count);
+		}
+
+		void transform_directions(const matrix4x4& m, const vec3* in, vec3* out, size_t count)
+		{
+			const size_t simd_count = count & ~(size_t)3;
+			g_simd_state.kernels.transform_directions(&m.m[0][0], reinterpret_cast<const number_t*>(in), reinterpret_cast<number_t*>(out), simd_count);
+			simd__transform_directions_scalar(&m.m[0][0], reinterpret_cast<const number_t*>(in + simd_count), reinterpret_cast<number_t*>(out + simd_count), count - simd_count);
+		}
+
+		void transform_vectors(const matrix4x4& m, const vec4* in, vec4* out, size_t count)
+		{
+			const size_t simd_count = count & ~(size_t)3;
+			g_simd_state.kernels.transform_vectors(&m.m[0][0], reinterpret_cast<const number_t*>(in), reinterpret_cast<number_t*>(out), simd_count);
+			simd__transform_vectors_scalar(&m.m[0][0], reinterpret_cast<const number_t*>(in + simd_count), reinterpret_cast<number_t*>(out + simd_count), count - simd_count);
+		}
+
+		void transform_points(const matrix4x4& m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			const size_t simd_count = batch__simd_count(in, out, count);
+			g_simd_state.kernels.transform_points_soa(&m.m[0][0], in, out, simd_count);
+			if (simd_count >= count)
+				return;
+
+			vec3_soa tail = batch__offset(out, simd_count);
+			simd__transform_points_soa_scalar(&m.m[0][0], batch__offset(in, simd_count), tail, count - simd_count);
+		}
+
+		void transform_directions(const matrix4x4& m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			const size_t simd_count = batch__simd_count(in, out, count);
+			g_simd_state.kernels.transform_directions_soa(&m.m[0][0], in, out, simd_count);
+			if (simd_count >= count)
+				return;
+
+			vec3_soa tail = batch__offset(out, simd_count);
+			simd__transform_directions_soa_scalar(&m.m[0][0], batch__offset(in, simd_count), tail, count - simd_count);
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <rengine/api.h>
+#include <rengine/types.h>
+#include <rengine/math/math-types.h>
+#include <rengine/math/vec3.h>
+
+namespace rengine {
+	namespace math {
+		struct matrix4x4;
+
+		/*
+		* Structure of arrays stream of vec3, each component is stored on its own array.
+		* Streams allocated by vec3_soa_alloc are aligned to MATH_BATCH_ALIGNMENT
+		* and capacity is rounded to MATH_BATCH_PADDING, then kernels can
+		* process padding elements instead of doing a scalar tail.
+		* Streams can also point to user memory, capacity must be set to the real array size.
+		*/
+		struct vec3_soa {
+			number_t* x{ null };
+			number_t* y{ null };
+			number_t* z{ null };
+			size_t capacity{ 0 };
+		};
+
+		R_EXPORT vec3_soa vec3_soa_alloc(size_t count);
+		R_EXPORT void vec3_soa_free(vec3_soa& soa);
+		R_EXPORT void vec3_soa_from_aos(const vec3* data, vec3_soa& soa, size_t count);
+		R_EXPORT void vec3_soa_to_aos(const vec3_soa& soa, vec3* data, size_t count);
+
+		// same as matrix4x4::mul(m, point) for each point, in and out can be the same array
+		R_EXPORT void transform_points(const matrix4x4& m, const vec3* in, vec3* out, size_t count);
+		// translation and w divide are skipped, useful for directions and normals
+		R_EXPORT void transform_directions(const matrix4x4& m, const vec3* in, vec3* out, size_t count);
+		R_EXPORT void transform_vectors(const matrix4x4& m, const vec4* in, vec4* out, size_t count);
+		R_EXPORT void transform_points(const matrix4x4& m, const vec3_soa& in, vec3_soa& out, size_t count);
+		R_EXPORT void transform_directions(const matrix4x4& m, const vec3_soa& in, vec3_soa& out, size_t count);
+	}
+}
@@ -0,0 +1,121 @@
+#include "./frustum.h"
+#include "./matrix4x4.h"
+#include "./simd_private.h"
+
+#include <bit>
+#include <string.h>
+
+namespace rengine {
+	namespace math {
+		static_assert(sizeof(plane) == sizeof(number_t) * 4, "plane must be tightly packed to be loaded by cull kernels");
+
+		number_t plane::distance(const vec3& point) const
+		{
+			return vec3::dot(normal, point) + d;
+		}
+
+		plane plane::normalized() const
+		{
+			const number_t inv_len = 1. / vec3::length(normal);
+			plane ret;
+			ret.normal = normal * inv_len;
+			ret.d = d * inv_len;
+			return ret;
+		}
+
+		vec3 aabb::center() const
+		{
+			return (min + max) * (number_t).5;
+		}
+
+		vec3 aabb::extents() const
+		{
+			return (max - min) * (number_t).5;
+		}
+
+		bool frustum::contains(const vec3& point) const
+		{
+			for (const auto& plane : planes) {
+				if (plane.distance(point) < 0)
+					return false;
+			}
+			return true;
+		}
+
+		bool frustum::intersects(const aabb& box) const
+		{
+			const vec3 center = box.center();
+			const vec3 extents = box.extents();
+			for (const auto& plane : planes) {
+				if (plane.distance(center) + vec3::dot_abs(plane.normal, extents) < 0)
+					return false;
+			}
+			return true;
+		}
+
+		bool frustum::intersects(const sphere& value) const
+		{
+			for (const auto& plane : planes) {
+				if (plane.distance(value.center) + value.radius < 0)
+					return false;
+			}
+			return true;
+		}
+
+		frustum frustum::from_matrix(const matrix4x4& view_proj, bool homogeneous_depth)
+		{
+			// reference: Gribb & Hartmann, Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix
+			const auto r0 = sse_load_number(&view_proj.m[0][0]);
+			const auto r1 = sse_load_number(&view_proj.m[1][0]);
+			const auto r2 = sse_load_number(&view_proj.m[2][0]);
+			const auto r3 = sse_load_number(&view_proj.m[3][0]);
+
+			frustum ret;
+			sse_store_number(&ret.planes[(u8)frustum_plane::left].normal.x, sse_add_number(r3, r0));
+			sse_store_number(&ret.planes[(u8)frustum_plane::right].normal.x, sse_sub_number(r3, r0));
+			sse_store_number(&ret.planes[(u8)frustum_plane::bottom].normal.x, sse_add_number(r3, r1));
+			sse_store_number(&ret.planes[(u8)frustum_plane::top].normal.x, sse_sub_number(r3, r1));
+			sse_store_number(&ret.planes[(u8)frustum_plane::znear].normal.x, homogeneous_depth ? sse_add_number(r3, r2) : r2);
+			sse_store_number(&ret.planes[(u8)frustum_plane::zfar].normal.x, sse_sub_number(r3, r2));
+
+			for (auto& plane : ret.planes)
+				plane = plane.normalized();
+			return ret;
+		}
+
+		void cull_boxes(const frustum& view_frustum, const vec3_soa& centers, const vec3_soa& extents, size_t count, u32* visible_mask)
+		{
+			memset(visible_mask, 0, cull_mask_size(count) * sizeof(u32));
+
+			const number_t* planes = &view_frustum.planes[0].normal.x;
+			const size_t simd_count = count & ~(size_t)3;
+			g_simd_state.kernels.cull_boxes(planes, centers, extents, 0, simd_count, visible_mask);
+			simd__cull_boxes_scalar(planes, centers, extents, simd_count, count, visible_mask);
+		}
+
+		void cull_spheres(const frustum& view_frustum, const vec3_soa& centers, const number_t* radius, size_t count, u32* visible_mask)
+		{
+			memset(visible_mask, 0, cull_mask_size(count) * sizeof(u32));
+
+			const number_t* planes = &view_frustum.planes[0].normal.x;
+			const size_t simd_count = count & ~(size_t)3;
+			g_simd_state.kernels.cull_spheres(planes, centers, radius, 0, simd_count, visible_mask);
+			simd__cull_spheres_scalar(planes, centers, radius, simd_count, count, visible_mask);
+		}
+
+		size_t cull_mask_to_indices(const u32* visible_mask, size_t count, u32* indices)
+		{
+			size_t result = 0;
+			const size_t words = cull_mask_size(count);
+			for (size_t word = 0; word < words; ++word) {
+				u32 bits = visible_mask[word];
+				// visits set bits only, lowest bit is cleared on each step
+				while (bits != 0) {
+					indices[result++] = (u32)(word * 32 + std::countr_zero(bits));
+					bits &= bits - 1;
+				}
+			}
+			return result;
+		}
+	}
+}
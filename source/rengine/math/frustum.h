@@ -0,0 +1,76 @@
+#pragma once
+#include <rengine/api.h>
+#include <rengine/types.h>
+#include <rengine/math/math-types.h>
+#include <rengine/math/vec3.h>
+#include <rengine/math/batch.h>
+
+namespace rengine {
+	namespace math {
+		struct matrix4x4;
+
+		// points where dot(normal, point) + d >= 0 are on positive side
+		struct R_EXPORT plane {
+			vec3 normal;
+			number_t d{ 0 };
+
+			number_t distance(const vec3& point) const;
+			plane normalized() const;
+		};
+
+		struct R_EXPORT aabb {
+			vec3 min;
+			vec3 max;
+
+			vec3 center() const;
+			vec3 extents() const;
+		};
+
+		struct R_EXPORT sphere {
+			vec3 center;
+			number_t radius{ 0 };
+		};
+
+		enum class frustum_plane : u8 {
+			left = 0,
+			right,
+			bottom,
+			top,
+			// near and far are reserved by windows headers
+			znear,
+			zfar,
+			count
+		};
+
+		struct R_EXPORT frustum {
+			// normals points to inside of frustum and are normalized
+			plane planes[(u8)frustum_plane::count];
+
+			bool contains(const vec3& point) const;
+			bool intersects(const aabb& box) const;
+			bool intersects(const sphere& value) const;
+
+			/*
+			* Extract planes from a view projection matrix.
+			* homogeneous_depth must be true when clip space depth goes from -1 to 1 (OpenGL),
+			* otherwise depth goes from 0 to 1 (D3D, Vulkan and Metal).
+			*/
+			static frustum from_matrix(const matrix4x4& view_proj, bool homogeneous_depth = false);
+		};
+
+		// visibility masks holds one bit per element, bit i % 32 of word i / 32
+		constexpr size_t cull_mask_size(size_t count) {
+			return (count + 31) / 32;
+		}
+
+		/*
+		* Batch frustum tests, boxes are given by center and extents (half size) streams.
+		* visible_mask must hold cull_mask_size(count) words and is fully overwritten.
+		* Elements intersecting a plane are considered visible.
+		*/
+		R_EXPORT void cull_boxes(const frustum& view_frustum, const vec3_soa& centers, const vec3_soa& extents, size_t count, u32* visible_mask);
+		R_EXPORT void cull_spheres(const frustum& view_frustum, const vec3_soa& centers, const number_t* radius, size_t count, u32* visible_mask);
+		// writes indices of visible elements and returns how many were written, indices must hold count elements
+		R_EXPORT size_t cull_mask_to_indices(const u32* visible_mask, size_t count, u32* indices);
+	}
+}
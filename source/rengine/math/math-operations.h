@@ -37,6 +37,11 @@ namespace rengine {
 		template <> inline float cos(float x) { return ::cosf(x); }
 		template <> inline double cos(double x) { return ::cos(x); }
 
+		template <typename T>
+		inline T acos(T x);
+		template <> inline float acos(float x) { return ::acosf(x); }
+		template <> inline double acos(double x) { return ::acos(x); }
+
 		template <typename T>
 		inline bool equals(T a, T b);
 
@@ -1,8 +1,11 @@
 #pragma once
 #include <rengine/math/math-operations.h>
+#include <rengine/math/batch.h>
+#include <rengine/math/frustum.h>
 #include <rengine/math/math-types.h>
 #include <rengine/math/matrix2x2.h>
 #include <rengine/math/matrix3x3.h>
 #include <rengine/math/matrix4x4.h>
 #include <rengine/math/quaternion.h>
+#include <rengine/math/simd.h>
 #include <rengine/math/vec3.h>
\ No newline at end of file
@@ -2,6 +2,18 @@
 
 namespace rengine {
 	namespace math {
+		static void matrix3x3__store_rows(matrix3x3& matrix, sse_m128_t r0, sse_m128_t r1, sse_m128_t r2)
+		{
+			// w lane of each row is overwritten by next store, last row is stored on a temporary
+			number_t last_row[4];
+			sse_store_number(&matrix.m[0][0], r0);
+			sse_store_number(&matrix.m[1][0], r1);
+			sse_store_number(last_row, r2);
+			matrix.m[2][0] = last_row[0];
+			matrix.m[2][1] = last_row[1];
+			matrix.m[2][2] = last_row[2];
+		}
+
 		bool matrix3x3::equals(const matrix3x3& rhs) const
 		{
 			for (int i = 0; i < 3; ++i) {
@@ -40,17 +52,22 @@ namespace rengine {
 
 		matrix3x3 matrix3x3::mul(const matrix3x3& rhs) const
 		{
-			return matrix3x3(
-				m[0][0] * rhs.m[0][0] + m[0][1] * rhs.m[1][0] + m[0][2] * rhs.m[2][0],
-				m[0][0] * rhs.m[0][1] + m[0][1] * rhs.m[1][1] + m[0][2] * rhs.m[2][1],
-				m[0][0] * rhs.m[0][2] + m[0][1] * rhs.m[1][2] + m[0][2] * rhs.m[2][2],
-				m[1][0] * rhs.m[0][0] + m[1][1] * rhs.m[1][0] + m[1][2] * rhs.m[2][0],
-				m[1][0] * rhs.m[0][1] + m[1][1] * rhs.m[1][1] + m[1][2] * rhs.m[2][1],
-				m[1][0] * rhs.m[0][2] + m[1][1] * rhs.m[1][2] + m[1][2] * rhs.m[2][2],
-				m[2][0] * rhs.m[0][0] + m[2][1] * rhs.m[1][0] + m[2][2] * rhs.m[2][0],
-				m[2][0] * rhs.m[0][1] + m[2][1] * rhs.m[1][1] + m[2][2] * rhs.m[2][1],
-				m[2][0] * rhs.m[0][2] + m[2][1] * rhs.m[1][2] + m[2][2] * rhs.m[2][2]
-			);
+			// last row can't be loaded with 4 lanes, otherwise it reads past matrix.
+			// w lane of first rows holds first element of next row and is discarded
+			const auto r0 = sse_load_number(&rhs.m[0][0]);
+			const auto r1 = sse_load_number(&rhs.m[1][0]);
+			const auto r2 = sse_set_number(0, rhs.m[2][2], rhs.m[2][1], rhs.m[2][0]);
+
+			sse_m128_t rows[3];
+			for (u8 i = 0; i < 3; ++i) {
+				auto row = sse_mul_number(sse_set_single_number(m[i][0]), r0);
+				row = sse_add_number(row, sse_mul_number(sse_set_single_number(m[i][1]), r1));
+				rows[i] = sse_add_number(row, sse_mul_number(sse_set_single_number(m[i][2]), r2));
+			}
+
+			matrix3x3 ret;
+			matrix3x3__store_rows(ret, rows[0], rows[1], rows[2]);
+			return ret;
 		}
 
 		matrix3x3 matrix3x3::add(const matrix3x3& rhs) const
@@ -133,24 +150,29 @@ namespace rengine {
 
 		matrix3x3 matrix3x3::inverse() const
 		{
-			number_t det = m[0][0] * m[1][1] * m[2][2] +
-							m[1][0] * m[2][1] * m[0][2] +
-							m[2][0] * m[0][1] * m[1][2] -
-							m[2][0] * m[1][1] * m[0][2] -
-							m[1][0] * m[0][1] * m[2][2] -
-							m[0][0] * m[2][1] * m[1][2];
-			number_t inv_det = 1. / det;
-			return matrix3x3(
-				(m[1][1] * m[2][2] - m[2][1] * m[1][2]) * inv_det,
-				-(m[0][1] * m[2][2] - m[2][1] * m[0][2]) * inv_det,
-				(m[0][1] * m[1][2] - m[1][1] * m[0][2]) * inv_det,
-				-(m[1][0] * m[2][2] - m[2][0] * m[1][2]) * inv_det,
-				(m[0][0] * m[2][2] - m[2][0] * m[0][2]) * inv_det,
-				-(m[0][0] * m[1][2] - m[1][0] * m[0][2]) * inv_det,
-				(m[1][0] * m[2][1] - m[2][0] * m[1][1]) * inv_det,
-				-(m[0][0] * m[2][1] - m[2][0] * m[0][1]) * inv_det,
-				(m[0][0] * m[1][1] - m[1][0] * m[0][1]) * inv_det
-			);
+			// w lane of first rows holds next row element, cross products always zero it
+			const auto r0 = sse_load_number(&m[0][0]);
+			const auto r1 = sse_load_number(&m[1][0]);
+			const auto r2 = sse_set_number(0, m[2][2], m[2][1], m[2][0]);
+
+			// columns of inverse are cross products of rows divided by determinant
+			auto c0 = sse_cross_number(r1, r2);
+			auto c1 = sse_cross_number(r2, r0);
+			auto c2 = sse_cross_number(r0, r1);
+
+			auto det = sse_mul_number(r0, c0);
+			sse_hsum_number(det);
+			const auto inv_det = sse_div_number(sse_set_single_number(1.), det);
+			c0 = sse_mul_number(c0, inv_det);
+			c1 = sse_mul_number(c1, inv_det);
+			c2 = sse_mul_number(c2, inv_det);
+
+			auto c3 = sse_set_single_number(0);
+			sse_transpose_number(c0, c1, c2, c3);
+
+			matrix3x3 ret;
+			matrix3x3__store_rows(ret, c0, c1, c2);
+			return ret;
 		}
 
 		void matrix3x3::set_scale(const vec3& scale)
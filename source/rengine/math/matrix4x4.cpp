@@ -1,6 +1,7 @@
 #include "./matrix4x4.h"
 #include "./matrix3x3.h"
 #include "./quaternion.h"
+#include "./simd_private.h"
 
 #include "../exceptions.h"
 
@@ -92,25 +93,8 @@ namespace rengine {
 		}
 
 		matrix4x4 matrix4x4::mul(const matrix4x4& m, const matrix4x4& rhs) {
-			// reference: https://github.com/u3d-community/U3D/blob/383b74222188a8d301aaf93061e26c9d8efdc825/Source/Urho3D/Math/Matrix4.h#L417
 			matrix4x4 ret;
-
-			auto r0 = sse_load_number(&rhs.m[0][0]);
-			auto r1 = sse_load_number(&rhs.m[1][0]);
-			auto r2 = sse_load_number(&rhs.m[2][0]);
-			auto r3 = sse_load_number(&rhs.m[3][0]);
-
-			sse_m128_t l, t0, t1, t2, t3;
-
-			for (u8 i = 0; i < 4; ++i) {
-				l = sse_load_number(&m.m[i][0]);
-				t0 = sse_mul_number(sse_shuffle_number(l, l, sse_shuffle(0, 0, 0, 0)), r0);
-				t1 = sse_mul_number(sse_shuffle_number(l, l, sse_shuffle(1, 1, 1, 1)), r1);
-				t2 = sse_mul_number(sse_shuffle_number(l, l, sse_shuffle(2, 2, 2, 2)), r2);
-				t3 = sse_mul_number(sse_shuffle_number(l, l, sse_shuffle(3, 3, 3, 3)), r3);
-				sse_store_number(&ret.m[i][0], sse_add_number(sse_add_number(t0, t1), sse_add_number(t2, t3)));
-			}
-
+			g_simd_state.kernels.mul_matrix(&m.m[0][0], &rhs.m[0][0], &ret.m[0][0]);
 			return ret;
 		}
 	
@@ -178,11 +162,8 @@ namespace rengine {
 
 		matrix3x3 matrix4x4::rotation_matrix() const
 		{
-			vec3 inv_scale = {
-				1.f / math::sqrt(m[0][0] * m[0][0] + m[1][0] * m[1][0] + m[2][0] * m[2][0]),
-				1.f / math::sqrt(m[0][1] * m[0][1] + m[1][1] * m[1][1] + m[2][1] * m[2][1]),
-				1.f / math::sqrt(m[0][2] * m[0][2] + m[1][2] * m[1][2] + m[2][2] * m[2][2])
-			};
+			const vec3 value = scale();
+			const vec3 inv_scale(1. / value.x, 1. / value.y, 1. / value.z);
 			return to_matrix3x3().scaled(inv_scale);
 		}
 
@@ -198,11 +179,17 @@ namespace rengine {
 
 		vec3 matrix4x4::scale() const
 		{
-			return vec3(
-				math::sqrt(m[0][0] * m[0][0] + m[1][0] * m[1][0] + m[2][0] * m[2][0]),
-				math::sqrt(m[0][1] * m[0][1] + m[1][1] * m[1][1] + m[2][1] * m[2][1]),
-				math::sqrt(m[0][2] * m[0][2] + m[1][2] * m[1][2] + m[2][2] * m[2][2])
-			);
+			// squared length of each column is computed on a single pass, w lane is discarded
+			const auto r0 = sse_load_number(&m[0][0]);
+			const auto r1 = sse_load_number(&m[1][0]);
+			const auto r2 = sse_load_number(&m[2][0]);
+			auto len_sq = sse_mul_number(r0, r0);
+			len_sq = sse_add_number(len_sq, sse_mul_number(r1, r1));
+			len_sq = sse_add_number(len_sq, sse_mul_number(r2, r2));
+
+			number_t data[4];
+			sse_store_number(data, len_sq);
+			return vec3(math::sqrt(data[0]), math::sqrt(data[1]), math::sqrt(data[2]));
 		}
 
 		vec3 matrix4x4::signed_scale(const matrix3x3& rotation) const
@@ -236,9 +223,7 @@ namespace rengine {
 			translation.y = m[1][3];
 			translation.z = m[2][3];
 
-			scale.x = math::sqrt(m[0][0] * m[0][0] + m[1][0] * m[1][0] + m[2][0] * m[2][0]);
-			scale.y = math::sqrt(m[0][1] * m[0][1] + m[1][1] * m[1][1] + m[2][1] * m[2][1]);
-			scale.z = math::sqrt(m[0][2] * m[0][2] + m[1][2] * m[1][2] + m[2][2] * m[2][2]);
+			scale = this->scale();
 
 			vec3 inv_scale(1. / scale.x, 1. / scale.y, 1. / scale.z);
 			rotation = quat::from_matrix3x3(to_matrix3x3().scaled(inv_scale));
@@ -295,61 +280,44 @@ namespace rengine {
 
 		matrix4x4 matrix4x4::inverse(const matrix4x4& matrix)
 		{
-			number_t v0 = matrix.m[2][0] * matrix.m[3][1] - matrix.m[2][1] * matrix.m[3][0];
-			number_t v1 = matrix.m[2][0] * matrix.m[3][2] - matrix.m[2][2] * matrix.m[3][0];
-			number_t v2 = matrix.m[2][0] * matrix.m[3][3] - matrix.m[2][3] * matrix.m[3][0];
-			number_t v3 = matrix.m[2][1] * matrix.m[3][2] - matrix.m[2][2] * matrix.m[3][1];
-			number_t v4 = matrix.m[2][1] * matrix.m[3][3] - matrix.m[2][3] * matrix.m[3][1];
-			number_t v5 = matrix.m[2][2] * matrix.m[3][3] - matrix.m[2][3] * matrix.m[3][2];
-
-			number_t i00 = (v5 * matrix.m[1][1] - v4 * matrix.m[1][2] + v3 * matrix.m[1][3]);
-			number_t i10 = -(v5 * matrix.m[1][0] - v2 * matrix.m[1][2] + v1 * matrix.m[1][3]);
-			number_t i20 = (v4 * matrix.m[1][0] - v2 * matrix.m[1][1] + v0 * matrix.m[1][3]);
-			number_t i30 = -(v3 * matrix.m[1][0] - v1 * matrix.m[1][1] + v0 * matrix.m[1][2]);
-
-			number_t inv_det = 1. / (i00 * matrix.m[0][0] + i10 * matrix.m[0][1] + i20 * matrix.m[0][2] + i30 * matrix.m[0][3]);
-
-			i00 *= inv_det;
-			i10 *= inv_det;
-			i20 *= inv_det;
-			i30 *= inv_det;
-
-			number_t i01 = -(v5 * matrix.m[0][1] - v4 * matrix.m[0][2] + v3 * matrix.m[0][3]) * inv_det;
-			number_t i11 = (v5 * matrix.m[0][0] - v2 * matrix.m[0][2] + v1 * matrix.m[0][3]) * inv_det;
-			number_t i21 = -(v4 * matrix.m[0][0] - v2 * matrix.m[0][1] + v0 * matrix.m[0][3]) * inv_det;
-			number_t i31 = (v3 * matrix.m[0][0] - v1 * matrix.m[0][1] + v0 * matrix.m[0][2]) * inv_det;
-
-			v0 = matrix.m[1][0] * matrix.m[3][1] - matrix.m[1][1] * matrix.m[3][0];
-			v1 = matrix.m[1][0] * matrix.m[3][2] - matrix.m[1][2] * matrix.m[3][0];
-			v2 = matrix.m[1][0] * matrix.m[3][3] - matrix.m[1][3] * matrix.m[3][0];
-			v3 = matrix.m[1][1] * matrix.m[3][2] - matrix.m[1][2] * matrix.m[3][1];
-			v4 = matrix.m[1][1] * matrix.m[3][3] - matrix.m[1][3] * matrix.m[3][1];
-			v5 = matrix.m[1][2] * matrix.m[3][3] - matrix.m[1][3] * matrix.m[3][2];
-
-			number_t i02 = (v5 * matrix.m[0][1] - v4 * matrix.m[0][2] + v3 * matrix.m[0][3]) * inv_det;
-			number_t i12 = -(v5 * matrix.m[0][0] - v2 * matrix.m[0][2] + v1 * matrix.m[0][3]) * inv_det;
-			number_t i22 = (v4 * matrix.m[0][0] - v2 * matrix.m[0][1] + v0 * matrix.m[0][3]) * inv_det;
-			number_t i32 = -(v3 * matrix.m[0][0] - v1 * matrix.m[0][1] + v0 * matrix.m[0][2]) * inv_det;
-
-			v0 = matrix.m[2][1] * matrix.m[1][0] - matrix.m[2][0] * matrix.m[1][1];
-			v1 = matrix.m[2][2] * matrix.m[1][0] - matrix.m[2][0] * matrix.m[1][2];
-			v2 = matrix.m[2][3] * matrix.m[1][0] - matrix.m[2][0] * matrix.m[1][3];
-			v3 = matrix.m[2][2] * matrix.m[1][1] - matrix.m[2][1] * matrix.m[1][2];
-			v4 = matrix.m[2][3] * matrix.m[1][1] - matrix.m[2][1] * matrix.m[1][3];
-			v5 = matrix.m[2][3] * matrix.m[1][2] - matrix.m[2][2] * matrix.m[1][3];
-
-			number_t i03 = -(v5 * matrix.m[0][1] - v4 * matrix.m[0][2] + v3 * matrix.m[0][3]) * inv_det;
-			number_t i13 = (v5 * matrix.m[0][0] - v2 * matrix.m[0][2] + v1 * matrix.m[0][3]) * inv_det;
-			number_t i23 = -(v4 * matrix.m[0][0] - v2 * matrix.m[0][1] + v0 * matrix.m[0][3]) * inv_det;
-			number_t i33 = (v3 * matrix.m[0][0] - v1 * matrix.m[0][1] + v0 * matrix.m[0][2]) * inv_det;
-
-			return matrix4x4(
-				i00, i01, i02, i03,
-				i10, i11, i12, i13,
-				i20, i21, i22, i23,
-				i30, i31, i32, i33
-			);
+			matrix4x4 ret;
+			g_simd_state.kernels.inverse_matrix(&matrix.m[0][0], &ret.m[0][0]);
+			return ret;
+		}
+
+		matrix4x4 matrix4x4::inverse_affine(const matrix4x4& matrix)
+		{
+			// w lane of each row is translation, cross products always zero it
+			const auto r0 = sse_load_number(&matrix.m[0][0]);
+			const auto r1 = sse_load_number(&matrix.m[1][0]);
+			const auto r2 = sse_load_number(&matrix.m[2][0]);
+
+			// columns of 3x3 inverse are cross products of rows divided by determinant
+			auto c0 = sse_cross_number(r1, r2);
+			auto c1 = sse_cross_number(r2, r0);
+			auto c2 = sse_cross_number(r0, r1);
+
+			auto det = sse_mul_number(r0, c0);
+			sse_hsum_number(det);
+			const auto inv_det = sse_div_number(sse_set_single_number(1.), det);
+			c0 = sse_mul_number(c0, inv_det);
+			c1 = sse_mul_number(c1, inv_det);
+			c2 = sse_mul_number(c2, inv_det);
+
+			// translation column is -(inverse * translation)
+			auto c3 = sse_mul_number(c0, sse_set_single_number(-matrix.m[0][3]));
+			c3 = sse_sub_number(c3, sse_mul_number(c1, sse_set_single_number(matrix.m[1][3])));
+			c3 = sse_sub_number(c3, sse_mul_number(c2, sse_set_single_number(matrix.m[2][3])));
+			sse_transpose_number(c0, c1, c2, c3);
+
+			matrix4x4 ret;
+			sse_store_number(&ret.m[0][0], c0);
+			sse_store_number(&ret.m[1][0], c1);
+			sse_store_number(&ret.m[2][0], c2);
+			sse_store_number(&ret.m[3][0], sse_set_number(1, 0, 0, 0));
+			return ret;
 		}
+
 		matrix4x4 matrix4x4::transform(const vec3& translation, const quat& rotation, const vec3& scale)
 		{
 			matrix4x4 t = from_translation(translation);
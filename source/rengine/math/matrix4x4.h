@@ -82,6 +82,8 @@ namespace rengine {
 			static matrix4x4 from_scale(const vec3& value);
 
 			static matrix4x4 inverse(const matrix4x4& matrix);
+			// faster inverse for matrices whose last row is 0, 0, 0, 1
+			static matrix4x4 inverse_affine(const matrix4x4& matrix);
 
 			static matrix4x4 transform(const vec3& translation, const quat& rotation, const vec3& scale);
 
@@ -18,6 +18,103 @@ namespace rengine {
 			);
 		}
 
+		number_t quat::dot(const quat& rhs) const
+		{
+			auto result = sse_mul_number(sse_load_number(&w), sse_load_number(&rhs.w));
+			sse_hsum_number(result);
+			return sse_cvtss_number(result);
+		}
+
+		quat quat::mul(const quat& rhs) const
+		{
+			// lanes are w, x, y, z. each component of lhs scales a permutation of rhs
+			// and signs of hamilton product are folded into broadcasted component.
+			const auto q = sse_load_number(&rhs.w);
+			auto result = sse_mul_number(sse_set_single_number(w), q);
+			result = sse_add_number(result, sse_mul_number(sse_set_number(x, -x, x, -x), sse_shuffle_number(q, q, sse_shuffle(2, 3, 0, 1))));
+			result = sse_add_number(result, sse_mul_number(sse_set_number(-y, y, y, -y), sse_shuffle_number(q, q, sse_shuffle(1, 0, 3, 2))));
+			result = sse_add_number(result, sse_mul_number(sse_set_number(z, z, -z, -z), sse_shuffle_number(q, q, sse_shuffle(0, 1, 2, 3))));
+
+			quat ret;
+			sse_store_number(&ret.w, result);
+			return ret;
+		}
+
+		quat quat::normalized() const
+		{
+			const auto q = sse_load_number(&w);
+			auto len_sq = sse_mul_number(q, q);
+			sse_hsum_number(len_sq);
+
+			const number_t len = math::sqrt(sse_cvtss_number(len_sq));
+			if (len <= MATH_EPSILON)
+				return *this;
+
+			quat ret;
+			sse_store_number(&ret.w, sse_mul_number(q, sse_set_single_number(1. / len)));
+			return ret;
+		}
+
+		vec3 quat::rotate(const vec3& value) const
+		{
+			// v + w * t + u x t, where t = 2 * (u x v) and u is vector part of quaternion
+			const auto q = sse_load_number(&w);
+			const auto u = sse_shuffle_number(q, q, sse_shuffle(0, 3, 2, 1));
+			const auto v = sse_set_number(0, value.z, value.y, value.x);
+
+			auto t = sse_cross_number(u, v);
+			t = sse_add_number(t, t);
+
+			auto result = sse_add_number(v, sse_mul_number(sse_set_single_number(w), t));
+			result = sse_add_number(result, sse_cross_number(u, t));
+
+			number_t data[4];
+			sse_store_number(data, result);
+			return vec3(data);
+		}
+
+		quat quat::nlerp(const quat& from, const quat& to, number_t t)
+		{
+			// takes shortest path
+			const number_t to_t = from.dot(to) < 0. ? -t : t;
+			const auto result = sse_add_number(
+				sse_mul_number(sse_load_number(&from.w), sse_set_single_number(1. - t)),
+				sse_mul_number(sse_load_number(&to.w), sse_set_single_number(to_t))
+			);
+
+			quat ret;
+			sse_store_number(&ret.w, result);
+			return ret.normalized();
+		}
+
+		quat quat::slerp(const quat& from, const quat& to, number_t t)
+		{
+			number_t cos_theta = from.dot(to);
+			number_t sign = 1.;
+			if (cos_theta < 0.) {
+				cos_theta = -cos_theta;
+				sign = -1.;
+			}
+
+			// sin(theta) goes to zero when quaternions are too close
+			if (cos_theta > 1. - MATH_EPSILON)
+				return nlerp(from, to, t);
+
+			const number_t theta = math::acos(cos_theta);
+			const number_t inv_sin_theta = 1. / math::sin(theta);
+			const number_t from_t = math::sin((1. - t) * theta) * inv_sin_theta;
+			const number_t to_t = math::sin(t * theta) * inv_sin_theta * sign;
+
+			const auto result = sse_add_number(
+				sse_mul_number(sse_load_number(&from.w), sse_set_single_number(from_t)),
+				sse_mul_number(sse_load_number(&to.w), sse_set_single_number(to_t))
+			);
+
+			quat ret;
+			sse_store_number(&ret.w, result);
+			return ret;
+		}
+
 		quat quat::from_matrix3x3(const matrix3x3& matrix)
         {
             quat ret;
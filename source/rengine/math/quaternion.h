@@ -17,6 +17,14 @@ namespace rengine {
 
             const matrix3x3 to_matrix() const;
 
+            number_t dot(const quat& rhs) const;
+            quat mul(const quat& rhs) const;
+            quat normalized() const;
+            vec3 rotate(const vec3& value) const;
+
+            static quat nlerp(const quat& from, const quat& to, number_t t);
+            static quat slerp(const quat& from, const quat& to, number_t t);
+
             static quat from_matrix3x3(const matrix3x3& matrix);
             static quat from_rotation(number_t degrees);
             static quat from_euler_angles(const vec3& angles);
@@ -0,0 +1,217 @@
+#include "./simd.h"
+#include "./simd_private.h"
+
+#include "../io/logger.h"
+
+#if MATH_SIMD_AVX
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace rengine {
+	namespace math {
+		simd_state g_simd_state = {
+#if MATH_SIMD_SSE2
+			simd_level::sse2,
+			simd_level::sse2,
+			{
+				simd__mul_matrix_sse2,
+				simd__inverse_matrix_sse2,
+				simd__transform_points_sse2,
+				simd__transform_directions_sse2,
+				simd__transform_vectors_sse2,
+				simd__transform_points_soa_sse2,
+				simd__transform_directions_soa_sse2,
+				simd__cull_boxes_sse2,
+				simd__cull_spheres_sse2,
+			}
+#else
+			simd_level::scalar,
+			simd_level::scalar,
+			{
+				simd__mul_matrix_scalar,
+				simd__inverse_matrix_scalar,
+				simd__transform_points_scalar,
+				simd__transform_directions_scalar,
+				simd__transform_vectors_scalar,
+				simd__transform_points_soa_scalar,
+				simd__transform_directions_soa_scalar,
+				simd__cull_boxes_scalar,
+				simd__cull_spheres_scalar,
+			}
+#endif
+		};
+
+		simd_level simd_get_level()
+		{
+			return g_simd_state.level;
+		}
+
+		simd_level simd_get_supported_level()
+		{
+			return g_simd_state.supported_level;
+		}
+
+		void simd_set_level(simd_level level)
+		{
+			simd__select(level);
+		}
+
+		c_str simd_get_level_name(simd_level level)
+		{
+			if (level >= simd_level::count)
+				return strings::g_empty;
+			return strings::g_simd_level_names[(u8)level];
+		}
+
+		void simd__init()
+		{
+			auto& state = g_simd_state;
+			state.supported_level = simd__detect();
+			simd__select(state.supported_level);
+
+			io::logger_use(strings::logs::g_math_tag)->info_fmt(strings::logs::g_math_simd_level,
+				simd_get_level_name(state.level),
+				simd_get_level_name(state.supported_level));
+			simd__validate();
+		}
+
+#if MATH_SIMD_AVX
+		static void simd__cpuid(i32 regs[4], i32 leaf, i32 sub_leaf)
+		{
+#if defined(_MSC_VER)
+			__cpuidex(regs, leaf, sub_leaf);
+#else
+			u32 eax, ebx, ecx, edx;
+			__cpuid_count(leaf, sub_leaf, eax, ebx, ecx, edx);
+			regs[0] = (i32)eax;
+			regs[1] = (i32)ebx;
+			regs[2] = (i32)ecx;
+			regs[3] = (i32)edx;
+#endif
+		}
+
+		static u64 simd__xgetbv()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			u32 eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return ((u64)edx << 32) | eax;
+#endif
+		}
+#endif
+
+		simd_level simd__detect()
+		{
+#if !MATH_SIMD_SSE2
+			return simd_level::scalar;
+#elif !MATH_SIMD_AVX
+			return simd_level::sse2;
+#else
+			i32 regs[4];
+			simd__cpuid(regs, 0, 0);
+			const i32 max_leaf = regs[0];
+
+			simd__cpuid(regs, 1, 0);
+			const bool has_fma = (regs[2] & (1 << 12)) != 0;
+			const bool has_osxsave = (regs[2] & (1 << 27)) != 0;
+			const bool has_avx = (regs[2] & (1 << 28)) != 0;
+			if (max_leaf < 7 || !has_fma || !has_osxsave || !has_avx)
+				return simd_level::sse2;
+
+			// cpu support is not enough, os must also save wider registers on context switch
+			const u64 xcr0 = simd__xgetbv();
+			// xmm and ymm states
+			if ((xcr0 & 0x6) != 0x6)
+				return simd_level::sse2;
+
+			simd__cpuid(regs, 7, 0);
+			const bool has_avx2 = (regs[1] & (1 << 5)) != 0;
+			const bool has_avx512f = (regs[1] & (1 << 16)) != 0;
+			if (!has_avx2)
+				return simd_level::sse2;
+
+			// opmask, zmm low and zmm high states
+			if (has_avx512f && (xcr0 & 0xE6) == 0xE6)
+				return simd_level::avx512;
+			return simd_level::avx2;
+#endif
+		}
+
+		void simd__select(simd_level level)
+		{
+			auto& state = g_simd_state;
+			level = level > state.supported_level ? state.supported_level : level;
+			state.kernels = simd__get_kernels(level);
+			state.level = level;
+		}
+
+		simd_kernels simd__get_kernels(simd_level level)
+		{
+			simd_kernels kernels = {
+				simd__mul_matrix_scalar,
+				simd__inverse_matrix_scalar,
+				simd__transform_points_scalar,
+				simd__transform_directions_scalar,
+				simd__transform_vectors_scalar,
+				simd__transform_points_soa_scalar,
+				simd__transform_directions_soa_scalar,
+				simd__cull_boxes_scalar,
+				simd__cull_spheres_scalar,
+			};
+
+			// each level only replaces kernels that benefit from it
+#if MATH_SIMD_SSE2
+			if (level >= simd_level::sse2) {
+				kernels.mul_matrix = simd__mul_matrix_sse2;
+				kernels.inverse_matrix = simd__inverse_matrix_sse2;
+				kernels.transform_points = simd__transform_points_sse2;
+				kernels.transform_directions = simd__transform_directions_sse2;
+				kernels.transform_vectors = simd__transform_vectors_sse2;
+				kernels.transform_points_soa = simd__transform_points_soa_sse2;
+				kernels.transform_directions_soa = simd__transform_directions_soa_sse2;
+				kernels.cull_boxes = simd__cull_boxes_sse2;
+				kernels.cull_spheres = simd__cull_spheres_sse2;
+			}
+#endif
+#if MATH_SIMD_AVX
+			if (level >= simd_level::avx2) {
+				kernels.mul_matrix = simd__mul_matrix_avx2;
+				kernels.transform_points = simd__transform_points_avx2;
+				kernels.transform_directions = simd__transform_directions_avx2;
+				kernels.transform_vectors = simd__transform_vectors_avx2;
+				kernels.transform_points_soa = simd__transform_points_soa_avx2;
+				kernels.transform_directions_soa = simd__transform_directions_soa_avx2;
+				kernels.cull_boxes = simd__cull_boxes_avx2;
+				kernels.cull_spheres = simd__cull_spheres_avx2;
+			}
+			if (level >= simd_level::avx512) {
+				kernels.mul_matrix = simd__mul_matrix_avx512;
+				kernels.transform_points = simd__transform_points_avx512;
+				kernels.transform_directions = simd__transform_directions_avx512;
+				kernels.transform_vectors = simd__transform_vectors_avx512;
+				kernels.transform_points_soa = simd__transform_points_soa_avx512;
+				kernels.transform_directions_soa = simd__transform_directions_soa_avx512;
+			}
+#endif
+			return kernels;
+		}
+
+		bool simd__is_aligned(const void* mem, size_t alignment)
+		{
+			return (reinterpret_cast<uintptr_t>(mem) & (alignment - 1)) == 0;
+		}
+
+		bool simd__is_aligned(const vec3_soa& soa, size_t alignment)
+		{
+			return simd__is_aligned(soa.x, alignment)
+				&& simd__is_aligned(soa.y, alignment)
+				&& simd__is_aligned(soa.z, alignment);
+		}
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <rengine/api.h>
+#include <rengine/types.h>
+
+namespace rengine {
+	namespace math {
+		enum class simd_level : u8 {
+			scalar = 0,
+			sse2,
+			// avx2 kernels also requires fma
+			avx2,
+			avx512,
+			count
+		};
+
+		/*
+		* Hot math kernels (matrix multiply, inverse and batch transforms) are
+		* compiled for each instruction set and selected by cpuid when engine starts.
+		* Until then, sse2 kernels are used.
+		* Double precision builds only have sse2 kernels, they use avx registers when engine is built with avx.
+		*/
+		R_EXPORT simd_level simd_get_level();
+		R_EXPORT simd_level simd_get_supported_level();
+		// level is clamped to supported level, useful to compare kernels
+		R_EXPORT void simd_set_level(simd_level level);
+		R_EXPORT c_str simd_get_level_name(simd_level level);
+	}
+}
@@ -0,0 +1,318 @@
+// built with avx2 and fma flags, kernels are only called when cpu supports them
+#include "./simd_kernels_private.h"
+
+#if MATH_SIMD_AVX
+#include <immintrin.h>
+
+// lanes are given from first to last, applied to each 128 bits lane
+#define avx2__shuffle(a, b, x, y, z, w) _mm256_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+
+namespace rengine {
+	namespace math {
+		struct avx2_matrix_lanes {
+			__m256 c[4][4];
+
+			avx2_matrix_lanes(const number_t* m) {
+				for (u8 row = 0; row < 4; ++row) {
+					for (u8 col = 0; col < 4; ++col)
+						c[row][col] = _mm256_set1_ps(m[row * 4 + col]);
+				}
+			}
+
+			inline __m256 row(u8 idx, __m256 x, __m256 y, __m256 z) const {
+				return _mm256_fmadd_ps(c[idx][0], x, _mm256_fmadd_ps(c[idx][1], y, _mm256_fmadd_ps(c[idx][2], z, c[idx][3])));
+			}
+
+			inline __m256 row_direction(u8 idx, __m256 x, __m256 y, __m256 z) const {
+				return _mm256_fmadd_ps(c[idx][0], x, _mm256_fmadd_ps(c[idx][1], y, _mm256_mul_ps(c[idx][2], z)));
+			}
+
+			// lower half of lanes, used by 4 elements tail
+			inline __m128 row(u8 idx, __m128 x, __m128 y, __m128 z) const {
+				return _mm_fmadd_ps(_mm256_castps256_ps128(c[idx][0]), x,
+					_mm_fmadd_ps(_mm256_castps256_ps128(c[idx][1]), y,
+						_mm_fmadd_ps(_mm256_castps256_ps128(c[idx][2]), z, _mm256_castps256_ps128(c[idx][3]))));
+			}
+
+			inline __m128 row_direction(u8 idx, __m128 x, __m128 y, __m128 z) const {
+				return _mm_fmadd_ps(_mm256_castps256_ps128(c[idx][0]), x,
+					_mm_fmadd_ps(_mm256_castps256_ps128(c[idx][1]), y,
+						_mm_mul_ps(_mm256_castps256_ps128(c[idx][2]), z)));
+			}
+		};
+
+		/*
+		* 8 packed vec3 (24 numbers) to x, y, z lanes.
+		* Low 128 bits holds first 4 vectors and high 128 bits the last ones,
+		* then same in lane shuffles of sse2 kernel can be used.
+		*/
+		static inline void avx2__load_vec3x8(const number_t* data, __m256& x, __m256& y, __m256& z)
+		{
+			const __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(data)), _mm_loadu_ps(data + 12), 1);
+			const __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(data + 4)), _mm_loadu_ps(data + 16), 1);
+			const __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(data + 8)), _mm_loadu_ps(data + 20), 1);
+
+			const __m256 t0 = avx2__shuffle(b, c, 2, 3, 0, 1);
+			const __m256 t1 = avx2__shuffle(a, b, 1, 2, 0, 1);
+			const __m256 t2 = avx2__shuffle(t0, c, 1, 2, 2, 3);
+
+			x = avx2__shuffle(a, t0, 0, 3, 0, 3);
+			y = avx2__shuffle(t1, t2, 0, 2, 0, 2);
+			z = avx2__shuffle(t1, t2, 1, 3, 1, 3);
+		}
+
+		static inline void avx2__store_vec3x8(number_t* data, __m256 x, __m256 y, __m256 z)
+		{
+			const __m256 xy_lo = _mm256_unpacklo_ps(x, y);
+			const __m256 xy_hi = _mm256_unpackhi_ps(x, y);
+			const __m256 t0 = avx2__shuffle(z, xy_lo, 0, 0, 2, 3);
+			const __m256 t1 = avx2__shuffle(xy_lo, z, 3, 3, 1, 1);
+			const __m256 t2 = avx2__shuffle(z, xy_hi, 2, 3, 2, 3);
+
+			const __m256 a = avx2__shuffle(xy_lo, t0, 0, 1, 0, 2);
+			const __m256 b = avx2__shuffle(t1, xy_hi, 0, 2, 0, 1);
+			const __m256 c = avx2__shuffle(t2, t2, 0, 2, 3, 1);
+
+			_mm_storeu_ps(data, _mm256_castps256_ps128(a));
+			_mm_storeu_ps(data + 4, _mm256_castps256_ps128(b));
+			_mm_storeu_ps(data + 8, _mm256_castps256_ps128(c));
+			_mm_storeu_ps(data + 12, _mm256_extractf128_ps(a, 1));
+			_mm_storeu_ps(data + 16, _mm256_extractf128_ps(b, 1));
+			_mm_storeu_ps(data + 20, _mm256_extractf128_ps(c, 1));
+		}
+
+		void simd__mul_matrix_avx2(const number_t* lhs, const number_t* rhs, number_t* out)
+		{
+			const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs));
+			const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 4));
+			const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 8));
+			const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 12));
+			// two rows per register
+			const __m256 l01 = _mm256_loadu_ps(lhs);
+			const __m256 l23 = _mm256_loadu_ps(lhs + 8);
+
+			__m256 t01 = _mm256_mul_ps(_mm256_permute_ps(l01, 0x00), r0);
+			__m256 t23 = _mm256_mul_ps(_mm256_permute_ps(l23, 0x00), r0);
+			t01 = _mm256_fmadd_ps(_mm256_permute_ps(l01, 0x55), r1, t01);
+			t23 = _mm256_fmadd_ps(_mm256_permute_ps(l23, 0x55), r1, t23);
+			t01 = _mm256_fmadd_ps(_mm256_permute_ps(l01, 0xAA), r2, t01);
+			t23 = _mm256_fmadd_ps(_mm256_permute_ps(l23, 0xAA), r2, t23);
+			t01 = _mm256_fmadd_ps(_mm256_permute_ps(l01, 0xFF), r3, t01);
+			t23 = _mm256_fmadd_ps(_mm256_permute_ps(l23, 0xFF), r3, t23);
+
+			_mm256_storeu_ps(out, t01);
+			_mm256_storeu_ps(out + 8, t23);
+		}
+
+		template<bool direction>
+		static void avx2__transform_vec3(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			const avx2_matrix_lanes lanes(m);
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 x, y, z;
+				avx2__load_vec3x8(in + i * 3, x, y, z);
+
+				if constexpr (direction) {
+					avx2__store_vec3x8(out + i * 3,
+						lanes.row_direction(0, x, y, z),
+						lanes.row_direction(1, x, y, z),
+						lanes.row_direction(2, x, y, z));
+				}
+				else {
+					const __m256 w = lanes.row(3, x, y, z);
+					avx2__store_vec3x8(out + i * 3,
+						_mm256_div_ps(lanes.row(0, x, y, z), w),
+						_mm256_div_ps(lanes.row(1, x, y, z), w),
+						_mm256_div_ps(lanes.row(2, x, y, z), w));
+				}
+			}
+
+			if (i == count)
+				return;
+			if constexpr (direction)
+				simd__transform_directions_sse2(m, in + i * 3, out + i * 3, count - i);
+			else
+				simd__transform_points_sse2(m, in + i * 3, out + i * 3, count - i);
+		}
+
+		void simd__transform_points_avx2(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			avx2__transform_vec3<false>(m, in, out, count);
+		}
+
+		void simd__transform_directions_avx2(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			avx2__transform_vec3<true>(m, in, out, count);
+		}
+
+		void simd__transform_vectors_avx2(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			// columns of matrix, repeated on both 128 bits lanes
+			__m256 cols[4];
+			for (u8 col = 0; col < 4; ++col) {
+				const __m128 value = _mm_setr_ps(m[col], m[4 + col], m[8 + col], m[12 + col]);
+				cols[col] = _mm256_insertf128_ps(_mm256_castps128_ps256(value), value, 1);
+			}
+
+			// two vectors per register
+			for (size_t i = 0; i < count * 4; i += 8) {
+				const __m256 v = _mm256_loadu_ps(in + i);
+				__m256 r = _mm256_mul_ps(_mm256_permute_ps(v, 0x00), cols[0]);
+				r = _mm256_fmadd_ps(_mm256_permute_ps(v, 0x55), cols[1], r);
+				r = _mm256_fmadd_ps(_mm256_permute_ps(v, 0xAA), cols[2], r);
+				r = _mm256_fmadd_ps(_mm256_permute_ps(v, 0xFF), cols[3], r);
+				_mm256_storeu_ps(out + i, r);
+			}
+		}
+
+		template<bool aligned>
+		static inline __m256 avx2__load_lanes(const number_t* data)
+		{
+			if constexpr (aligned)
+				return _mm256_load_ps(data);
+			else
+				return _mm256_loadu_ps(data);
+		}
+
+		template<bool aligned>
+		static inline void avx2__store_lanes(number_t* data, __m256 value)
+		{
+			if constexpr (aligned)
+				_mm256_store_ps(data, value);
+			else
+				_mm256_storeu_ps(data, value);
+		}
+
+		template<bool aligned, bool direction>
+		static void avx2__transform_soa(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			const avx2_matrix_lanes lanes(m);
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				const __m256 x = avx2__load_lanes<aligned>(in.x + i);
+				const __m256 y = avx2__load_lanes<aligned>(in.y + i);
+				const __m256 z = avx2__load_lanes<aligned>(in.z + i);
+
+				if constexpr (direction) {
+					avx2__store_lanes<aligned>(out.x + i, lanes.row_direction(0, x, y, z));
+					avx2__store_lanes<aligned>(out.y + i, lanes.row_direction(1, x, y, z));
+					avx2__store_lanes<aligned>(out.z + i, lanes.row_direction(2, x, y, z));
+				}
+				else {
+					const __m256 w = lanes.row(3, x, y, z);
+					avx2__store_lanes<aligned>(out.x + i, _mm256_div_ps(lanes.row(0, x, y, z), w));
+					avx2__store_lanes<aligned>(out.y + i, _mm256_div_ps(lanes.row(1, x, y, z), w));
+					avx2__store_lanes<aligned>(out.z + i, _mm256_div_ps(lanes.row(2, x, y, z), w));
+				}
+			}
+
+			// count is multiple of 4, then at most 4 elements are left
+			if (i == count)
+				return;
+
+			const __m128 x = _mm_loadu_ps(in.x + i);
+			const __m128 y = _mm_loadu_ps(in.y + i);
+			const __m128 z = _mm_loadu_ps(in.z + i);
+			if constexpr (direction) {
+				_mm_storeu_ps(out.x + i, lanes.row_direction(0, x, y, z));
+				_mm_storeu_ps(out.y + i, lanes.row_direction(1, x, y, z));
+				_mm_storeu_ps(out.z + i, lanes.row_direction(2, x, y, z));
+			}
+			else {
+				const __m128 w = lanes.row(3, x, y, z);
+				_mm_storeu_ps(out.x + i, _mm_div_ps(lanes.row(0, x, y, z), w));
+				_mm_storeu_ps(out.y + i, _mm_div_ps(lanes.row(1, x, y, z), w));
+				_mm_storeu_ps(out.z + i, _mm_div_ps(lanes.row(2, x, y, z), w));
+			}
+		}
+
+		void simd__transform_points_soa_avx2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			if (simd__is_aligned(in, 32) && simd__is_aligned(out, 32))
+				avx2__transform_soa<true, false>(m, in, out, count);
+			else
+				avx2__transform_soa<false, false>(m, in, out, count);
+		}
+
+		void simd__transform_directions_soa_avx2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			if (simd__is_aligned(in, 32) && simd__is_aligned(out, 32))
+				avx2__transform_soa<true, true>(m, in, out, count);
+			else
+				avx2__transform_soa<false, true>(m, in, out, count);
+		}
+
+		// frustum plane components broadcasted to all lanes
+		struct avx2_frustum_lanes {
+			__m256 n[(u8)frustum_plane::count][4];
+			__m256 abs_n[(u8)frustum_plane::count][3];
+
+			avx2_frustum_lanes(const number_t* planes) {
+				for (u8 p = 0; p < (u8)frustum_plane::count; ++p) {
+					for (u8 c = 0; c < 4; ++c)
+						n[p][c] = _mm256_set1_ps(planes[p * 4 + c]);
+					// sign bit is cleared
+					for (u8 c = 0; c < 3; ++c)
+						abs_n[p][c] = _mm256_andnot_ps(_mm256_set1_ps(-0.f), n[p][c]);
+				}
+			}
+
+			inline __m256 distance(u8 p, __m256 x, __m256 y, __m256 z) const {
+				return _mm256_fmadd_ps(n[p][0], x, _mm256_fmadd_ps(n[p][1], y, _mm256_fmadd_ps(n[p][2], z, n[p][3])));
+			}
+
+			// box extents projected on plane normal
+			inline __m256 radius(u8 p, __m256 x, __m256 y, __m256 z) const {
+				return _mm256_fmadd_ps(abs_n[p][0], x, _mm256_fmadd_ps(abs_n[p][1], y, _mm256_mul_ps(abs_n[p][2], z)));
+			}
+		};
+
+		void simd__cull_boxes_avx2(const number_t* planes, const vec3_soa& centers, const vec3_soa& extents, size_t begin, size_t end, u32* mask)
+		{
+			const avx2_frustum_lanes lanes(planes);
+			size_t i = begin;
+			for (; i + 8 <= end; i += 8) {
+				const __m256 x = _mm256_loadu_ps(centers.x + i);
+				const __m256 y = _mm256_loadu_ps(centers.y + i);
+				const __m256 z = _mm256_loadu_ps(centers.z + i);
+				const __m256 ex = _mm256_loadu_ps(extents.x + i);
+				const __m256 ey = _mm256_loadu_ps(extents.y + i);
+				const __m256 ez = _mm256_loadu_ps(extents.z + i);
+
+				// sign bit is set on lanes outside of plane, stops when all lanes are outside
+				int outside = 0;
+				for (u8 p = 0; p < (u8)frustum_plane::count && outside != 0xFF; ++p)
+					outside |= _mm256_movemask_ps(_mm256_add_ps(lanes.distance(p, x, y, z), lanes.radius(p, ex, ey, ez)));
+
+				mask[i >> 5] |= (u32)(~outside & 0xFF) << (i & 31);
+			}
+
+			// range is multiple of 4, then at most 4 elements are left
+			if (i < end)
+				simd__cull_boxes_sse2(planes, centers, extents, i, end, mask);
+		}
+
+		void simd__cull_spheres_avx2(const number_t* planes, const vec3_soa& centers, const number_t* radius, size_t begin, size_t end, u32* mask)
+		{
+			const avx2_frustum_lanes lanes(planes);
+			size_t i = begin;
+			for (; i + 8 <= end; i += 8) {
+				const __m256 x = _mm256_loadu_ps(centers.x + i);
+				const __m256 y = _mm256_loadu_ps(centers.y + i);
+				const __m256 z = _mm256_loadu_ps(centers.z + i);
+				const __m256 r = _mm256_loadu_ps(radius + i);
+
+				int outside = 0;
+				for (u8 p = 0; p < (u8)frustum_plane::count && outside != 0xFF; ++p)
+					outside |= _mm256_movemask_ps(_mm256_add_ps(lanes.distance(p, x, y, z), r));
+
+				mask[i >> 5] |= (u32)(~outside & 0xFF) << (i & 31);
+			}
+
+			if (i < end)
+				simd__cull_spheres_sse2(planes, centers, radius, i, end, mask);
+		}
+	}
+}
+#endif
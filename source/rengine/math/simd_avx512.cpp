@@ -0,0 +1,215 @@
+// built with avx512f, avx2 and fma flags, kernels are only called when cpu supports them
+#include "./simd_kernels_private.h"
+
+#if MATH_SIMD_AVX
+#include <immintrin.h>
+
+namespace rengine {
+	namespace math {
+		/*
+		* Permutation indices between 16 packed vec3 (3 registers) and x, y, z lanes.
+		* Each register is built from two permutes, first one picks lanes from
+		* a pair of registers and second one merges lanes of remaining register.
+		*/
+		struct avx512_vec3_tables {
+			i32 load_first[3][16];
+			i32 load_second[3][16];
+			i32 store_first[3][16];
+			i32 store_second[3][16];
+		};
+
+		static constexpr avx512_vec3_tables avx512__make_vec3_tables()
+		{
+			avx512_vec3_tables tables{};
+			for (i32 comp = 0; comp < 3; ++comp) {
+				for (i32 k = 0; k < 16; ++k) {
+					const i32 elem = k * 3 + comp;
+					// first two registers holds 32 numbers
+					tables.load_first[comp][k] = elem < 32 ? elem : 0;
+					tables.load_second[comp][k] = elem < 32 ? k : 16 + elem - 32;
+				}
+			}
+
+			for (i32 reg = 0; reg < 3; ++reg) {
+				for (i32 lane = 0; lane < 16; ++lane) {
+					const i32 elem = reg * 16 + lane;
+					const i32 k = elem / 3;
+					const i32 comp = elem % 3;
+					// x and y are merged first, then z
+					tables.store_first[reg][lane] = comp == 0 ? k : (comp == 1 ? 16 + k : 0);
+					tables.store_second[reg][lane] = comp == 2 ? 16 + k : lane;
+				}
+			}
+			return tables;
+		}
+
+		alignas(64) static constexpr avx512_vec3_tables g_avx512_vec3_tables = avx512__make_vec3_tables();
+
+		struct avx512_matrix_lanes {
+			__m512 c[4][4];
+
+			avx512_matrix_lanes(const number_t* m) {
+				for (u8 row = 0; row < 4; ++row) {
+					for (u8 col = 0; col < 4; ++col)
+						c[row][col] = _mm512_set1_ps(m[row * 4 + col]);
+				}
+			}
+
+			inline __m512 row(u8 idx, __m512 x, __m512 y, __m512 z) const {
+				return _mm512_fmadd_ps(c[idx][0], x, _mm512_fmadd_ps(c[idx][1], y, _mm512_fmadd_ps(c[idx][2], z, c[idx][3])));
+			}
+
+			inline __m512 row_direction(u8 idx, __m512 x, __m512 y, __m512 z) const {
+				return _mm512_fmadd_ps(c[idx][0], x, _mm512_fmadd_ps(c[idx][1], y, _mm512_mul_ps(c[idx][2], z)));
+			}
+		};
+
+		static inline __m512i avx512__load_indices(const i32* indices)
+		{
+			return _mm512_loadu_si512(indices);
+		}
+
+		static inline void avx512__load_vec3x16(const number_t* data, __m512& x, __m512& y, __m512& z)
+		{
+			const auto& tables = g_avx512_vec3_tables;
+			const __m512 a = _mm512_loadu_ps(data);
+			const __m512 b = _mm512_loadu_ps(data + 16);
+			const __m512 c = _mm512_loadu_ps(data + 32);
+
+			__m512* lanes[] = { &x, &y, &z };
+			for (u8 comp = 0; comp < 3; ++comp) {
+				const __m512 t = _mm512_permutex2var_ps(a, avx512__load_indices(tables.load_first[comp]), b);
+				*lanes[comp] = _mm512_permutex2var_ps(t, avx512__load_indices(tables.load_second[comp]), c);
+			}
+		}
+
+		static inline void avx512__store_vec3x16(number_t* data, __m512 x, __m512 y, __m512 z)
+		{
+			const auto& tables = g_avx512_vec3_tables;
+			for (u8 reg = 0; reg < 3; ++reg) {
+				const __m512 t = _mm512_permutex2var_ps(x, avx512__load_indices(tables.store_first[reg]), y);
+				_mm512_storeu_ps(data + reg * 16, _mm512_permutex2var_ps(t, avx512__load_indices(tables.store_second[reg]), z));
+			}
+		}
+
+		void simd__mul_matrix_avx512(const number_t* lhs, const number_t* rhs, number_t* out)
+		{
+			// whole lhs fits on a register, each 128 bits lane is a row
+			const __m512 l = _mm512_loadu_ps(lhs);
+			const __m512 r0 = _mm512_broadcast_f32x4(_mm_loadu_ps(rhs));
+			const __m512 r1 = _mm512_broadcast_f32x4(_mm_loadu_ps(rhs + 4));
+			const __m512 r2 = _mm512_broadcast_f32x4(_mm_loadu_ps(rhs + 8));
+			const __m512 r3 = _mm512_broadcast_f32x4(_mm_loadu_ps(rhs + 12));
+
+			__m512 t = _mm512_mul_ps(_mm512_permute_ps(l, 0x00), r0);
+			t = _mm512_fmadd_ps(_mm512_permute_ps(l, 0x55), r1, t);
+			t = _mm512_fmadd_ps(_mm512_permute_ps(l, 0xAA), r2, t);
+			t = _mm512_fmadd_ps(_mm512_permute_ps(l, 0xFF), r3, t);
+			_mm512_storeu_ps(out, t);
+		}
+
+		template<bool direction>
+		static void avx512__transform_vec3(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			const avx512_matrix_lanes lanes(m);
+			size_t i = 0;
+			for (; i + 16 <= count; i += 16) {
+				__m512 x, y, z;
+				avx512__load_vec3x16(in + i * 3, x, y, z);
+
+				if constexpr (direction) {
+					avx512__store_vec3x16(out + i * 3,
+						lanes.row_direction(0, x, y, z),
+						lanes.row_direction(1, x, y, z),
+						lanes.row_direction(2, x, y, z));
+				}
+				else {
+					const __m512 w = lanes.row(3, x, y, z);
+					avx512__store_vec3x16(out + i * 3,
+						_mm512_div_ps(lanes.row(0, x, y, z), w),
+						_mm512_div_ps(lanes.row(1, x, y, z), w),
+						_mm512_div_ps(lanes.row(2, x, y, z), w));
+				}
+			}
+
+			if (i == count)
+				return;
+			if constexpr (direction)
+				simd__transform_directions_avx2(m, in + i * 3, out + i * 3, count - i);
+			else
+				simd__transform_points_avx2(m, in + i * 3, out + i * 3, count - i);
+		}
+
+		void simd__transform_points_avx512(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			avx512__transform_vec3<false>(m, in, out, count);
+		}
+
+		void simd__transform_directions_avx512(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			avx512__transform_vec3<true>(m, in, out, count);
+		}
+
+		void simd__transform_vectors_avx512(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			// columns of matrix, repeated on each 128 bits lane
+			__m512 cols[4];
+			for (u8 col = 0; col < 4; ++col)
+				cols[col] = _mm512_broadcast_f32x4(_mm_setr_ps(m[col], m[4 + col], m[8 + col], m[12 + col]));
+
+			// four vectors per register
+			for (size_t i = 0; i < count * 4; i += 16) {
+				const __m512 v = _mm512_loadu_ps(in + i);
+				__m512 r = _mm512_mul_ps(_mm512_permute_ps(v, 0x00), cols[0]);
+				r = _mm512_fmadd_ps(_mm512_permute_ps(v, 0x55), cols[1], r);
+				r = _mm512_fmadd_ps(_mm512_permute_ps(v, 0xAA), cols[2], r);
+				r = _mm512_fmadd_ps(_mm512_permute_ps(v, 0xFF), cols[3], r);
+				_mm512_storeu_ps(out + i, r);
+			}
+		}
+
+		template<bool direction>
+		static inline void avx512__transform_soa_lanes(const avx512_matrix_lanes& lanes, const vec3_soa& in, vec3_soa& out, size_t i, __mmask16 mask)
+		{
+			const __m512 x = _mm512_maskz_loadu_ps(mask, in.x + i);
+			const __m512 y = _mm512_maskz_loadu_ps(mask, in.y + i);
+			const __m512 z = _mm512_maskz_loadu_ps(mask, in.z + i);
+
+			if constexpr (direction) {
+				_mm512_mask_storeu_ps(out.x + i, mask, lanes.row_direction(0, x, y, z));
+				_mm512_mask_storeu_ps(out.y + i, mask, lanes.row_direction(1, x, y, z));
+				_mm512_mask_storeu_ps(out.z + i, mask, lanes.row_direction(2, x, y, z));
+			}
+			else {
+				const __m512 w = lanes.row(3, x, y, z);
+				_mm512_mask_storeu_ps(out.x + i, mask, _mm512_div_ps(lanes.row(0, x, y, z), w));
+				_mm512_mask_storeu_ps(out.y + i, mask, _mm512_div_ps(lanes.row(1, x, y, z), w));
+				_mm512_mask_storeu_ps(out.z + i, mask, _mm512_div_ps(lanes.row(2, x, y, z), w));
+			}
+		}
+
+		template<bool direction>
+		static void avx512__transform_soa(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			const avx512_matrix_lanes lanes(m);
+			size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+				avx512__transform_soa_lanes<direction>(lanes, in, out, i, 0xFFFF);
+
+			// masked lanes are neither loaded nor stored
+			if (i < count)
+				avx512__transform_soa_lanes<direction>(lanes, in, out, i, (__mmask16)((1u << (count - i)) - 1));
+		}
+
+		void simd__transform_points_soa_avx512(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			avx512__transform_soa<false>(m, in, out, count);
+		}
+
+		void simd__transform_directions_soa_avx512(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			avx512__transform_soa<true>(m, in, out, count);
+		}
+	}
+}
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+// kernels of each instruction set are built on their own translation unit with wider instruction flags.
+// this header must not pull inline code, otherwise it can be emitted with instructions unsupported by the cpu.
+#include "./batch.h"
+#include "./frustum.h"
+
+// sse2 kernels are written with sse_*_number macros, then double precision builds also runs them
+#if ENGINE_SSE
+	#define MATH_SIMD_SSE2 1
+#else
+	#define MATH_SIMD_SSE2 0
+#endif
+
+// avx kernels are float only
+#if MATH_SIMD_SSE2 && ENGINE_SIMD_X86 && ENGINE_SIMD_DISPATCH && !defined(HIGH_DEFINITION_PRECISION)
+	#define MATH_SIMD_AVX 1
+#else
+	#define MATH_SIMD_AVX 0
+#endif
+
+namespace rengine {
+	namespace math {
+		// matrices are row major 4x4 arrays, vectors are packed arrays of vec3 or vec4
+		typedef void(*simd_mul_matrix_fn)(const number_t* lhs, const number_t* rhs, number_t* out);
+		typedef void(*simd_inverse_matrix_fn)(const number_t* m, number_t* out);
+		// count must be multiple of 4
+		typedef void(*simd_transform_fn)(const number_t* m, const number_t* in, number_t* out, size_t count);
+		typedef void(*simd_transform_soa_fn)(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		// planes are packed frustum planes (nx, ny, nz, d), bits of visible elements from begin to end are set on mask.
+		// begin must be multiple of 8 and end multiple of 4, then wider kernels never straddle mask words
+		typedef void(*simd_cull_boxes_fn)(const number_t* planes, const vec3_soa& centers, const vec3_soa& extents, size_t begin, size_t end, u32* mask);
+		typedef void(*simd_cull_spheres_fn)(const number_t* planes, const vec3_soa& centers, const number_t* radius, size_t begin, size_t end, u32* mask);
+
+		struct simd_kernels {
+			simd_mul_matrix_fn mul_matrix;
+			simd_inverse_matrix_fn inverse_matrix;
+			simd_transform_fn transform_points;
+			simd_transform_fn transform_directions;
+			simd_transform_fn transform_vectors;
+			simd_transform_soa_fn transform_points_soa;
+			simd_transform_soa_fn transform_directions_soa;
+			simd_cull_boxes_fn cull_boxes;
+			simd_cull_spheres_fn cull_spheres;
+		};
+
+		bool simd__is_aligned(const void* mem, size_t alignment);
+		bool simd__is_aligned(const vec3_soa& soa, size_t alignment);
+
+		// scalar kernels also accept any count and range
+		void simd__mul_matrix_scalar(const number_t* lhs, const number_t* rhs, number_t* out);
+		void simd__inverse_matrix_scalar(const number_t* m, number_t* out);
+		void simd__transform_points_scalar(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_directions_scalar(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_vectors_scalar(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_points_soa_scalar(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		void simd__transform_directions_soa_scalar(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		void simd__cull_boxes_scalar(const number_t* planes, const vec3_soa& centers, const vec3_soa& extents, size_t begin, size_t end, u32* mask);
+		void simd__cull_spheres_scalar(const number_t* planes, const vec3_soa& centers, const number_t* radius, size_t begin, size_t end, u32* mask);
+
+#if MATH_SIMD_SSE2
+		void simd__mul_matrix_sse2(const number_t* lhs, const number_t* rhs, number_t* out);
+		void simd__inverse_matrix_sse2(const number_t* m, number_t* out);
+		void simd__transform_points_sse2(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_directions_sse2(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_vectors_sse2(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_points_soa_sse2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		void simd__transform_directions_soa_sse2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		void simd__cull_boxes_sse2(const number_t* planes, const vec3_soa& centers, const vec3_soa& extents, size_t begin, size_t end, u32* mask);
+		void simd__cull_spheres_sse2(const number_t* planes, const vec3_soa& centers, const number_t* radius, size_t begin, size_t end, u32* mask);
+#endif
+
+#if MATH_SIMD_AVX
+		void simd__mul_matrix_avx2(const number_t* lhs, const number_t* rhs, number_t* out);
+		void simd__transform_points_avx2(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_directions_avx2(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_vectors_avx2(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_points_soa_avx2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		void simd__transform_directions_soa_avx2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		void simd__cull_boxes_avx2(const number_t* planes, const vec3_soa& centers, const vec3_soa& extents, size_t begin, size_t end, u32* mask);
+		void simd__cull_spheres_avx2(const number_t* planes, const vec3_soa& centers, const number_t* radius, size_t begin, size_t end, u32* mask);
+
+		void simd__mul_matrix_avx512(const number_t* lhs, const number_t* rhs, number_t* out);
+		void simd__transform_points_avx512(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_directions_avx512(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_vectors_avx512(const number_t* m, const number_t* in, number_t* out, size_t count);
+		void simd__transform_points_soa_avx512(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+		void simd__transform_directions_soa_avx512(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count);
+#endif
+	}
+}
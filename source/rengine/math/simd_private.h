@@ -0,0 +1,24 @@
+#pragma once
+#include "../base_private.h"
+#include "./simd.h"
+#include "./simd_kernels_private.h"
+
+namespace rengine {
+	namespace math {
+		struct simd_state {
+			simd_level level;
+			simd_level supported_level;
+			// kernels are replaced only at engine init or by simd_set_level
+			simd_kernels kernels;
+		};
+		extern simd_state g_simd_state;
+
+		void simd__init();
+		// compares sse math against scalar formulas and logs mismatches, no-op outside debug builds
+		void simd__validate();
+
+		simd_level simd__detect();
+		void simd__select(simd_level level);
+		simd_kernels simd__get_kernels(simd_level level);
+	}
+}
@@ -0,0 +1,177 @@
+#include "./simd_kernels_private.h"
+
+#include <string.h>
+
+namespace rengine {
+	namespace math {
+		void simd__mul_matrix_scalar(const number_t* lhs, const number_t* rhs, number_t* out)
+		{
+			number_t result[16];
+			for (u8 row = 0; row < 4; ++row) {
+				for (u8 col = 0; col < 4; ++col) {
+					result[row * 4 + col] = lhs[row * 4 + 0] * rhs[0 * 4 + col]
+						+ lhs[row * 4 + 1] * rhs[1 * 4 + col]
+						+ lhs[row * 4 + 2] * rhs[2 * 4 + col]
+						+ lhs[row * 4 + 3] * rhs[3 * 4 + col];
+				}
+			}
+			memcpy(out, result, sizeof(result));
+		}
+
+		void simd__inverse_matrix_scalar(const number_t* m, number_t* out)
+		{
+			const number_t (*matrix)[4] = reinterpret_cast<const number_t(*)[4]>(m);
+			number_t v0 = matrix[2][0] * matrix[3][1] - matrix[2][1] * matrix[3][0];
+			number_t v1 = matrix[2][0] * matrix[3][2] - matrix[2][2] * matrix[3][0];
+			number_t v2 = matrix[2][0] * matrix[3][3] - matrix[2][3] * matrix[3][0];
+			number_t v3 = matrix[2][1] * matrix[3][2] - matrix[2][2] * matrix[3][1];
+			number_t v4 = matrix[2][1] * matrix[3][3] - matrix[2][3] * matrix[3][1];
+			number_t v5 = matrix[2][2] * matrix[3][3] - matrix[2][3] * matrix[3][2];
+
+			number_t i00 = (v5 * matrix[1][1] - v4 * matrix[1][2] + v3 * matrix[1][3]);
+			number_t i10 = -(v5 * matrix[1][0] - v2 * matrix[1][2] + v1 * matrix[1][3]);
+			number_t i20 = (v4 * matrix[1][0] - v2 * matrix[1][1] + v0 * matrix[1][3]);
+			number_t i30 = -(v3 * matrix[1][0] - v1 * matrix[1][1] + v0 * matrix[1][2]);
+
+			number_t inv_det = 1. / (i00 * matrix[0][0] + i10 * matrix[0][1] + i20 * matrix[0][2] + i30 * matrix[0][3]);
+
+			i00 *= inv_det;
+			i10 *= inv_det;
+			i20 *= inv_det;
+			i30 *= inv_det;
+
+			number_t i01 = -(v5 * matrix[0][1] - v4 * matrix[0][2] + v3 * matrix[0][3]) * inv_det;
+			number_t i11 = (v5 * matrix[0][0] - v2 * matrix[0][2] + v1 * matrix[0][3]) * inv_det;
+			number_t i21 = -(v4 * matrix[0][0] - v2 * matrix[0][1] + v0 * matrix[0][3]) * inv_det;
+			number_t i31 = (v3 * matrix[0][0] - v1 * matrix[0][1] + v0 * matrix[0][2]) * inv_det;
+
+			v0 = matrix[1][0] * matrix[3][1] - matrix[1][1] * matrix[3][0];
+			v1 = matrix[1][0] * matrix[3][2] - matrix[1][2] * matrix[3][0];
+			v2 = matrix[1][0] * matrix[3][3] - matrix[1][3] * matrix[3][0];
+			v3 = matrix[1][1] * matrix[3][2] - matrix[1][2] * matrix[3][1];
+			v4 = matrix[1][1] * matrix[3][3] - matrix[1][3] * matrix[3][1];
+			v5 = matrix[1][2] * matrix[3][3] - matrix[1][3] * matrix[3][2];
+
+			number_t i02 = (v5 * matrix[0][1] - v4 * matrix[0][2] + v3 * matrix[0][3]) * inv_det;
+			number_t i12 = -(v5 * matrix[0][0] - v2 * matrix[0][2] + v1 * matrix[0][3]) * inv_det;
+			number_t i22 = (v4 * matrix[0][0] - v2 * matrix[0][1] + v0 * matrix[0][3]) * inv_det;
+			number_t i32 = -(v3 * matrix[0][0] - v1 * matrix[0][1] + v0 * matrix[0][2]) * inv_det;
+
+			v0 = matrix[2][1] * matrix[1][0] - matrix[2][0] * matrix[1][1];
+			v1 = matrix[2][2] * matrix[1][0] - matrix[2][0] * matrix[1][2];
+			v2 = matrix[2][3] * matrix[1][0] - matrix[2][0] * matrix[1][3];
+			v3 = matrix[2][2] * matrix[1][1] - matrix[2][1] * matrix[1][2];
+			v4 = matrix[2][3] * matrix[1][1] - matrix[2][1] * matrix[1][3];
+			v5 = matrix[2][3] * matrix[1][2] - matrix[2][2] * matrix[1][3];
+
+			number_t i03 = -(v5 * matrix[0][1] - v4 * matrix[0][2] + v3 * matrix[0][3]) * inv_det;
+			number_t i13 = (v5 * matrix[0][0] - v2 * matrix[0][2] + v1 * matrix[0][3]) * inv_det;
+			number_t i23 = -(v4 * matrix[0][0] - v2 * matrix[0][1] + v0 * matrix[0][3]) * inv_det;
+			number_t i33 = (v3 * matrix[0][0] - v1 * matrix[0][1] + v0 * matrix[0][2]) * inv_det;
+
+			const number_t result[] = {
+				i00, i01, i02, i03,
+				i10, i11, i12, i13,
+				i20, i21, i22, i23,
+				i30, i31, i32, i33
+			};
+			memcpy(out, result, sizeof(result));
+		}
+
+		void simd__transform_points_scalar(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			for (size_t i = 0; i < count * 3; i += 3) {
+				const number_t x = in[i + 0];
+				const number_t y = in[i + 1];
+				const number_t z = in[i + 2];
+				const number_t w = m[12] * x + m[13] * y + m[14] * z + m[15];
+				out[i + 0] = (m[0] * x + m[1] * y + m[2] * z + m[3]) / w;
+				out[i + 1] = (m[4] * x + m[5] * y + m[6] * z + m[7]) / w;
+				out[i + 2] = (m[8] * x + m[9] * y + m[10] * z + m[11]) / w;
+			}
+		}
+
+		void simd__transform_directions_scalar(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			for (size_t i = 0; i < count * 3; i += 3) {
+				const number_t x = in[i + 0];
+				const number_t y = in[i + 1];
+				const number_t z = in[i + 2];
+				out[i + 0] = m[0] * x + m[1] * y + m[2] * z;
+				out[i + 1] = m[4] * x + m[5] * y + m[6] * z;
+				out[i + 2] = m[8] * x + m[9] * y + m[10] * z;
+			}
+		}
+
+		void simd__transform_vectors_scalar(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			for (size_t i = 0; i < count * 4; i += 4) {
+				const number_t x = in[i + 0];
+				const number_t y = in[i + 1];
+				const number_t z = in[i + 2];
+				const number_t w = in[i + 3];
+				out[i + 0] = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+				out[i + 1] = m[4] * x + m[5] * y + m[6] * z + m[7] * w;
+				out[i + 2] = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+				out[i + 3] = m[12] * x + m[13] * y + m[14] * z + m[15] * w;
+			}
+		}
+
+		void simd__transform_points_soa_scalar(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i) {
+				const number_t x = in.x[i];
+				const number_t y = in.y[i];
+				const number_t z = in.z[i];
+				const number_t w = m[12] * x + m[13] * y + m[14] * z + m[15];
+				out.x[i] = (m[0] * x + m[1] * y + m[2] * z + m[3]) / w;
+				out.y[i] = (m[4] * x + m[5] * y + m[6] * z + m[7]) / w;
+				out.z[i] = (m[8] * x + m[9] * y + m[10] * z + m[11]) / w;
+			}
+		}
+
+		void simd__transform_directions_soa_scalar(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i) {
+				const number_t x = in.x[i];
+				const number_t y = in.y[i];
+				const number_t z = in.z[i];
+				out.x[i] = m[0] * x + m[1] * y + m[2] * z;
+				out.y[i] = m[4] * x + m[5] * y + m[6] * z;
+				out.z[i] = m[8] * x + m[9] * y + m[10] * z;
+			}
+		}
+
+		void simd__cull_boxes_scalar(const number_t* planes, const vec3_soa& centers, const vec3_soa& extents, size_t begin, size_t end, u32* mask)
+		{
+			for (size_t i = begin; i < end; ++i) {
+				bool visible = true;
+				for (u8 p = 0; p < (u8)frustum_plane::count && visible; ++p) {
+					const number_t* plane = planes + p * 4;
+					// box is outside when its projected radius doesn't reach plane
+					const number_t distance = plane[0] * centers.x[i] + plane[1] * centers.y[i] + plane[2] * centers.z[i] + plane[3];
+					const number_t radius = math::abs(plane[0]) * extents.x[i] + math::abs(plane[1]) * extents.y[i] + math::abs(plane[2]) * extents.z[i];
+					visible = distance + radius >= 0;
+				}
+
+				if (visible)
+					mask[i >> 5] |= 1u << (i & 31);
+			}
+		}
+
+		void simd__cull_spheres_scalar(const number_t* planes, const vec3_soa& centers, const number_t* radius, size_t begin, size_t end, u32* mask)
+		{
+			for (size_t i = begin; i < end; ++i) {
+				bool visible = true;
+				for (u8 p = 0; p < (u8)frustum_plane::count && visible; ++p) {
+					const number_t* plane = planes + p * 4;
+					const number_t distance = plane[0] * centers.x[i] + plane[1] * centers.y[i] + plane[2] * centers.z[i] + plane[3];
+					visible = distance + radius[i] >= 0;
+				}
+
+				if (visible)
+					mask[i >> 5] |= 1u << (i & 31);
+			}
+		}
+	}
+}
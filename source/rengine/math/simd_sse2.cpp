@@ -0,0 +1,358 @@
+#include "./simd_kernels_private.h"
+#include "./sse.h"
+
+#if MATH_SIMD_SSE2
+// lanes are given from first to last, sse_shuffle expects them in reverse order
+#define sse2__shuffle(a, b, x, y, z, w) sse_shuffle_number(a, b, sse_shuffle(w, z, y, x))
+#define sse2__swizzle(v, x, y, z, w) sse2__shuffle(v, v, x, y, z, w)
+
+namespace rengine {
+	namespace math {
+		// matrix elements broadcasted to all lanes
+		struct sse2_matrix_lanes {
+			sse_m128_t c[4][4];
+
+			sse2_matrix_lanes(const number_t* m) {
+				for (u8 row = 0; row < 4; ++row) {
+					for (u8 col = 0; col < 4; ++col)
+						c[row][col] = sse_set_single_number(m[row * 4 + col]);
+				}
+			}
+
+			inline sse_m128_t row(u8 idx, sse_m128_t x, sse_m128_t y, sse_m128_t z) const {
+				return sse_add_number(
+					sse_add_number(sse_mul_number(c[idx][0], x), sse_mul_number(c[idx][1], y)),
+					sse_add_number(sse_mul_number(c[idx][2], z), c[idx][3])
+				);
+			}
+
+			inline sse_m128_t row_direction(u8 idx, sse_m128_t x, sse_m128_t y, sse_m128_t z) const {
+				return sse_add_number(
+					sse_add_number(sse_mul_number(c[idx][0], x), sse_mul_number(c[idx][1], y)),
+					sse_mul_number(c[idx][2], z)
+				);
+			}
+		};
+
+		// 4 packed vec3 (12 numbers) to x, y, z lanes
+		static inline void sse2__load_vec3x4(const number_t* data, sse_m128_t& x, sse_m128_t& y, sse_m128_t& z)
+		{
+			// a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+			const sse_m128_t a = sse_load_number(data);
+			const sse_m128_t b = sse_load_number(data + 4);
+			const sse_m128_t c = sse_load_number(data + 8);
+
+			// x2 y2 z2 x3
+			const sse_m128_t t0 = sse2__shuffle(b, c, 2, 3, 0, 1);
+			// y0 z0 y1 z1
+			const sse_m128_t t1 = sse2__shuffle(a, b, 1, 2, 0, 1);
+			// y2 z2 y3 z3
+			const sse_m128_t t2 = sse2__shuffle(t0, c, 1, 2, 2, 3);
+
+			x = sse2__shuffle(a, t0, 0, 3, 0, 3);
+			y = sse2__shuffle(t1, t2, 0, 2, 0, 2);
+			z = sse2__shuffle(t1, t2, 1, 3, 1, 3);
+		}
+
+		static inline void sse2__store_vec3x4(number_t* data, sse_m128_t x, sse_m128_t y, sse_m128_t z)
+		{
+			// x0 y0 x1 y1
+			const sse_m128_t xy_lo = sse_unpacklo_number(x, y);
+			// x2 y2 x3 y3
+			const sse_m128_t xy_hi = sse_unpackhi_number(x, y);
+			// z0 z0 x1 y1
+			const sse_m128_t t0 = sse2__shuffle(z, xy_lo, 0, 0, 2, 3);
+			// y1 y1 z1 z1
+			const sse_m128_t t1 = sse2__shuffle(xy_lo, z, 3, 3, 1, 1);
+			// z2 z3 x3 y3
+			const sse_m128_t t2 = sse2__shuffle(z, xy_hi, 2, 3, 2, 3);
+
+			sse_store_number(data, sse2__shuffle(xy_lo, t0, 0, 1, 0, 2));
+			sse_store_number(data + 4, sse2__shuffle(t1, xy_hi, 0, 2, 0, 1));
+			sse_store_number(data + 8, sse2__swizzle(t2, 0, 2, 3, 1));
+		}
+
+		void simd__mul_matrix_sse2(const number_t* lhs, const number_t* rhs, number_t* out)
+		{
+			// reference: https://github.com/u3d-community/U3D/blob/383b74222188a8d301aaf93061e26c9d8efdc825/Source/Urho3D/Math/Matrix4.h#L417
+			const auto r0 = sse_load_number(rhs);
+			const auto r1 = sse_load_number(rhs + 4);
+			const auto r2 = sse_load_number(rhs + 8);
+			const auto r3 = sse_load_number(rhs + 12);
+
+			sse_m128_t l[4];
+			for (u8 i = 0; i < 4; ++i)
+				l[i] = sse_load_number(lhs + i * 4);
+
+			sse_m128_t t0, t1, t2, t3;
+			for (u8 i = 0; i < 4; ++i) {
+				t0 = sse_mul_number(sse2__swizzle(l[i], 0, 0, 0, 0), r0);
+				t1 = sse_mul_number(sse2__swizzle(l[i], 1, 1, 1, 1), r1);
+				t2 = sse_mul_number(sse2__swizzle(l[i], 2, 2, 2, 2), r2);
+				t3 = sse_mul_number(sse2__swizzle(l[i], 3, 3, 3, 3), r3);
+				sse_store_number(out + i * 4, sse_add_number(sse_add_number(t0, t1), sse_add_number(t2, t3)));
+			}
+		}
+
+		// 2x2 matrices are stored on a single register as row major
+		static inline sse_m128_t sse2__mat2_mul(sse_m128_t a, sse_m128_t b)
+		{
+			return sse_add_number(
+				sse_mul_number(a, sse2__swizzle(b, 0, 3, 0, 3)),
+				sse_mul_number(sse2__swizzle(a, 1, 0, 3, 2), sse2__swizzle(b, 2, 1, 2, 1))
+			);
+		}
+
+		// adjugate(a) * b
+		static inline sse_m128_t sse2__mat2_adj_mul(sse_m128_t a, sse_m128_t b)
+		{
+			return sse_sub_number(
+				sse_mul_number(sse2__swizzle(a, 3, 3, 0, 0), b),
+				sse_mul_number(sse2__swizzle(a, 1, 1, 2, 2), sse2__swizzle(b, 2, 3, 0, 1))
+			);
+		}
+
+		// a * adjugate(b)
+		static inline sse_m128_t sse2__mat2_mul_adj(sse_m128_t a, sse_m128_t b)
+		{
+			return sse_sub_number(
+				sse_mul_number(a, sse2__swizzle(b, 3, 0, 3, 0)),
+				sse_mul_number(sse2__swizzle(a, 1, 0, 3, 2), sse2__swizzle(b, 2, 1, 2, 1))
+			);
+		}
+
+		void simd__inverse_matrix_sse2(const number_t* m, number_t* out)
+		{
+			// reference: https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+			// matrix is split into 2x2 blocks | A B |
+			//                                 | C D |
+			const auto r0 = sse_load_number(m);
+			const auto r1 = sse_load_number(m + 4);
+			const auto r2 = sse_load_number(m + 8);
+			const auto r3 = sse_load_number(m + 12);
+
+			const auto a = sse_movelh_number(r0, r1);
+			const auto b = sse_movehl_number(r1, r0);
+			const auto c = sse_movelh_number(r2, r3);
+			const auto d = sse_movehl_number(r3, r2);
+
+			// |A| |B| |C| |D|
+			const auto det_sub = sse_sub_number(
+				sse_mul_number(sse2__shuffle(r0, r2, 0, 2, 0, 2), sse2__shuffle(r1, r3, 1, 3, 1, 3)),
+				sse_mul_number(sse2__shuffle(r0, r2, 1, 3, 1, 3), sse2__shuffle(r1, r3, 0, 2, 0, 2))
+			);
+			const auto det_a = sse2__swizzle(det_sub, 0, 0, 0, 0);
+			const auto det_b = sse2__swizzle(det_sub, 1, 1, 1, 1);
+			const auto det_c = sse2__swizzle(det_sub, 2, 2, 2, 2);
+			const auto det_d = sse2__swizzle(det_sub, 3, 3, 3, 3);
+
+			const auto d_c = sse2__mat2_adj_mul(d, c);
+			const auto a_b = sse2__mat2_adj_mul(a, b);
+			// adjugates of inverse blocks | X Y |
+			//                             | Z W |
+			auto x = sse_sub_number(sse_mul_number(det_d, a), sse2__mat2_mul(b, d_c));
+			auto w = sse_sub_number(sse_mul_number(det_a, d), sse2__mat2_mul(c, a_b));
+			auto y = sse_sub_number(sse_mul_number(det_b, c), sse2__mat2_mul_adj(d, a_b));
+			auto z = sse_sub_number(sse_mul_number(det_c, b), sse2__mat2_mul_adj(a, d_c));
+
+			// |M| = |A| * |D| + |B| * |C| - trace(A#B * D#C)
+			auto tr = sse_mul_number(a_b, sse2__swizzle(d_c, 0, 2, 1, 3));
+			tr = sse_add_number(tr, sse_movehl_number(tr, tr));
+			tr = sse_add_number(tr, sse2__swizzle(tr, 1, 1, 1, 1));
+			tr = sse2__swizzle(tr, 0, 0, 0, 0);
+			auto det_m = sse_add_number(sse_mul_number(det_a, det_d), sse_mul_number(det_b, det_c));
+			det_m = sse_sub_number(det_m, tr);
+
+			const auto inv_det_m = sse_div_number(sse_set_number(1.f, -1.f, -1.f, 1.f), det_m);
+			x = sse_mul_number(x, inv_det_m);
+			y = sse_mul_number(y, inv_det_m);
+			z = sse_mul_number(z, inv_det_m);
+			w = sse_mul_number(w, inv_det_m);
+
+			// adjugate shuffle is merged with blocks store
+			sse_store_number(out, sse2__shuffle(x, y, 3, 1, 3, 1));
+			sse_store_number(out + 4, sse2__shuffle(x, y, 2, 0, 2, 0));
+			sse_store_number(out + 8, sse2__shuffle(z, w, 3, 1, 3, 1));
+			sse_store_number(out + 12, sse2__shuffle(z, w, 2, 0, 2, 0));
+		}
+
+		void simd__transform_points_sse2(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			const sse2_matrix_lanes lanes(m);
+			for (size_t i = 0; i < count * 3; i += 12) {
+				sse_m128_t x, y, z;
+				sse2__load_vec3x4(in + i, x, y, z);
+
+				const sse_m128_t w = lanes.row(3, x, y, z);
+				sse2__store_vec3x4(out + i,
+					sse_div_number(lanes.row(0, x, y, z), w),
+					sse_div_number(lanes.row(1, x, y, z), w),
+					sse_div_number(lanes.row(2, x, y, z), w));
+			}
+		}
+
+		void simd__transform_directions_sse2(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			const sse2_matrix_lanes lanes(m);
+			for (size_t i = 0; i < count * 3; i += 12) {
+				sse_m128_t x, y, z;
+				sse2__load_vec3x4(in + i, x, y, z);
+				sse2__store_vec3x4(out + i,
+					lanes.row_direction(0, x, y, z),
+					lanes.row_direction(1, x, y, z),
+					lanes.row_direction(2, x, y, z));
+			}
+		}
+
+		void simd__transform_vectors_sse2(const number_t* m, const number_t* in, number_t* out, size_t count)
+		{
+			const sse2_matrix_lanes lanes(m);
+			for (size_t i = 0; i < count * 4; i += 16) {
+				sse_m128_t x = sse_load_number(in + i);
+				sse_m128_t y = sse_load_number(in + i + 4);
+				sse_m128_t z = sse_load_number(in + i + 8);
+				sse_m128_t w = sse_load_number(in + i + 12);
+				sse_transpose_number(x, y, z, w);
+
+				sse_m128_t r[4];
+				for (u8 row = 0; row < 4; ++row) {
+					r[row] = sse_add_number(
+						sse_add_number(sse_mul_number(lanes.c[row][0], x), sse_mul_number(lanes.c[row][1], y)),
+						sse_add_number(sse_mul_number(lanes.c[row][2], z), sse_mul_number(lanes.c[row][3], w))
+					);
+				}
+				sse_transpose_number(r[0], r[1], r[2], r[3]);
+
+				sse_store_number(out + i, r[0]);
+				sse_store_number(out + i + 4, r[1]);
+				sse_store_number(out + i + 8, r[2]);
+				sse_store_number(out + i + 12, r[3]);
+			}
+		}
+
+		template<bool aligned>
+		static inline sse_m128_t sse2__load_lanes(const number_t* data)
+		{
+			if constexpr (aligned)
+				return sse_load_aligned_number(data);
+			else
+				return sse_load_number(data);
+		}
+
+		template<bool aligned>
+		static inline void sse2__store_lanes(number_t* data, sse_m128_t value)
+		{
+			if constexpr (aligned)
+				sse_store_aligned_number(data, value);
+			else
+				sse_store_number(data, value);
+		}
+
+		template<bool aligned, bool direction>
+		static void sse2__transform_soa(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			const sse2_matrix_lanes lanes(m);
+			for (size_t i = 0; i < count; i += 4) {
+				const sse_m128_t x = sse2__load_lanes<aligned>(in.x + i);
+				const sse_m128_t y = sse2__load_lanes<aligned>(in.y + i);
+				const sse_m128_t z = sse2__load_lanes<aligned>(in.z + i);
+
+				if constexpr (direction) {
+					sse2__store_lanes<aligned>(out.x + i, lanes.row_direction(0, x, y, z));
+					sse2__store_lanes<aligned>(out.y + i, lanes.row_direction(1, x, y, z));
+					sse2__store_lanes<aligned>(out.z + i, lanes.row_direction(2, x, y, z));
+				}
+				else {
+					const sse_m128_t w = lanes.row(3, x, y, z);
+					sse2__store_lanes<aligned>(out.x + i, sse_div_number(lanes.row(0, x, y, z), w));
+					sse2__store_lanes<aligned>(out.y + i, sse_div_number(lanes.row(1, x, y, z), w));
+					sse2__store_lanes<aligned>(out.z + i, sse_div_number(lanes.row(2, x, y, z), w));
+				}
+			}
+		}
+
+		void simd__transform_points_soa_sse2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			if (simd__is_aligned(in, sizeof(sse_m128_t)) && simd__is_aligned(out, sizeof(sse_m128_t)))
+				sse2__transform_soa<true, false>(m, in, out, count);
+			else
+				sse2__transform_soa<false, false>(m, in, out, count);
+		}
+
+		void simd__transform_directions_soa_sse2(const number_t* m, const vec3_soa& in, vec3_soa& out, size_t count)
+		{
+			if (simd__is_aligned(in, sizeof(sse_m128_t)) && simd__is_aligned(out, sizeof(sse_m128_t)))
+				sse2__transform_soa<true, true>(m, in, out, count);
+			else
+				sse2__transform_soa<false, true>(m, in, out, count);
+		}
+
+		// frustum plane components broadcasted to all lanes
+		struct sse2_frustum_lanes {
+			sse_m128_t n[(u8)frustum_plane::count][4];
+			sse_m128_t abs_n[(u8)frustum_plane::count][3];
+
+			sse2_frustum_lanes(const number_t* planes) {
+				for (u8 p = 0; p < (u8)frustum_plane::count; ++p) {
+					for (u8 c = 0; c < 4; ++c)
+						n[p][c] = sse_set_single_number(planes[p * 4 + c]);
+					for (u8 c = 0; c < 3; ++c)
+						abs_n[p][c] = sse_set_single_number(math::abs(planes[p * 4 + c]));
+				}
+			}
+
+			inline sse_m128_t distance(u8 p, sse_m128_t x, sse_m128_t y, sse_m128_t z) const {
+				return sse_add_number(
+					sse_add_number(sse_mul_number(n[p][0], x), sse_mul_number(n[p][1], y)),
+					sse_add_number(sse_mul_number(n[p][2], z), n[p][3])
+				);
+			}
+
+			// box extents projected on plane normal
+			inline sse_m128_t radius(u8 p, sse_m128_t x, sse_m128_t y, sse_m128_t z) const {
+				return sse_add_number(
+					sse_add_number(sse_mul_number(abs_n[p][0], x), sse_mul_number(abs_n[p][1], y)),
+					sse_mul_number(abs_n[p][2], z)
+				);
+			}
+		};
+
+		void simd__cull_boxes_sse2(const number_t* planes, const vec3_soa& centers, const vec3_soa& extents, size_t begin, size_t end, u32* mask)
+		{
+			const sse2_frustum_lanes lanes(planes);
+			for (size_t i = begin; i < end; i += 4) {
+				const sse_m128_t x = sse_load_number(centers.x + i);
+				const sse_m128_t y = sse_load_number(centers.y + i);
+				const sse_m128_t z = sse_load_number(centers.z + i);
+				const sse_m128_t ex = sse_load_number(extents.x + i);
+				const sse_m128_t ey = sse_load_number(extents.y + i);
+				const sse_m128_t ez = sse_load_number(extents.z + i);
+
+				// sign bit is set on lanes outside of plane, stops when all lanes are outside
+				int outside = 0;
+				for (u8 p = 0; p < (u8)frustum_plane::count && outside != 0xF; ++p)
+					outside |= sse_movemask_number(sse_add_number(lanes.distance(p, x, y, z), lanes.radius(p, ex, ey, ez)));
+
+				mask[i >> 5] |= (u32)(~outside & 0xF) << (i & 31);
+			}
+		}
+
+		void simd__cull_spheres_sse2(const number_t* planes, const vec3_soa& centers, const number_t* radius, size_t begin, size_t end, u32* mask)
+		{
+			const sse2_frustum_lanes lanes(planes);
+			for (size_t i = begin; i < end; i += 4) {
+				const sse_m128_t x = sse_load_number(centers.x + i);
+				const sse_m128_t y = sse_load_number(centers.y + i);
+				const sse_m128_t z = sse_load_number(centers.z + i);
+				const sse_m128_t r = sse_load_number(radius + i);
+
+				int outside = 0;
+				for (u8 p = 0; p < (u8)frustum_plane::count && outside != 0xF; ++p)
+					outside |= sse_movemask_number(sse_add_number(lanes.distance(p, x, y, z), r));
+
+				mask[i >> 5] |= (u32)(~outside & 0xF) << (i & 31);
+			}
+		}
+	}
+}
+#endif
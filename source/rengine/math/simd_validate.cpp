@@ -0,0 +1,230 @@
+#include "./simd_private.h"
+#include "./matrix3x3.h"
+#include "./matrix4x4.h"
+#include "./quaternion.h"
+
+#include "../io/logger.h"
+
+namespace rengine {
+	namespace math {
+#if ENGINE_DEBUG
+		// operations are well conditioned, error is relative to reference magnitude
+		static constexpr number_t g_simd_validate_tolerance = MATH_EPSILON * 10;
+
+		static number_t simd__validate_error(const number_t* value, const number_t* expected, u32 count)
+		{
+			number_t result = 0;
+			for (u32 i = 0; i < count; ++i) {
+				const number_t magnitude = math::abs(expected[i]) > 1 ? math::abs(expected[i]) : 1;
+				const number_t error = math::abs(value[i] - expected[i]) / magnitude;
+				// nan is reported as is, it would be lost by comparisons
+				if (error != error)
+					return error;
+				result = error > result ? error : result;
+			}
+			return result;
+		}
+
+		static void simd__validate_report(c_str name, number_t error)
+		{
+			if (error <= g_simd_validate_tolerance)
+				return;
+			io::logger_use(strings::logs::g_math_tag)->error_fmt(strings::logs::g_math_simd_validation_failed, name, error);
+		}
+
+		static void simd__validate_cross()
+		{
+			const number_t a[] = { 1.5, -2., 3.25 };
+			const number_t b[] = { -.5, 4., 2. };
+			const number_t expected[] = {
+				a[1] * b[2] - a[2] * b[1],
+				a[2] * b[0] - a[0] * b[2],
+				a[0] * b[1] - a[1] * b[0],
+				0
+			};
+
+			// w lanes are filled with garbage, cross product must discard them
+			const auto lhs = sse_set_number(7., a[2], a[1], a[0]);
+			const auto rhs = sse_set_number(-9., b[2], b[1], b[0]);
+			number_t value[4];
+			sse_store_number(value, sse_cross_number(lhs, rhs));
+			simd__validate_report("sse_cross_number", simd__validate_error(value, expected, 4));
+		}
+
+		static void simd__validate_quat()
+		{
+			quat a;
+			a.w = .5; a.x = -.25; a.y = .75; a.z = .1;
+			quat b;
+			b.w = -.3; b.x = .6; b.y = .2; b.z = -.9;
+
+			// hamilton product
+			const number_t expected[] = {
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+				a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w
+			};
+
+			const quat value = a.mul(b);
+			simd__validate_report("quat::mul", simd__validate_error(&value.w, expected, 4));
+		}
+
+		static quat simd__validate_unit_quat(number_t w, number_t x, number_t y, number_t z)
+		{
+			const number_t inv_len = 1. / math::sqrt(w * w + x * x + y * y + z * z);
+			quat ret;
+			ret.w = w * inv_len; ret.x = x * inv_len; ret.y = y * inv_len; ret.z = z * inv_len;
+			return ret;
+		}
+
+		static number_t simd__validate_dot(const quat& a, const quat& b)
+		{
+			return a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+		}
+
+		static quat simd__validate_nlerp(const quat& from, const quat& to, number_t t)
+		{
+			const number_t to_t = simd__validate_dot(from, to) < 0 ? -t : t;
+			return simd__validate_unit_quat(
+				from.w * (1. - t) + to.w * to_t,
+				from.x * (1. - t) + to.x * to_t,
+				from.y * (1. - t) + to.y * to_t,
+				from.z * (1. - t) + to.z * to_t
+			);
+		}
+
+		static void simd__validate_slerp(c_str name, const quat& from, const quat& to, number_t t)
+		{
+			number_t cos_theta = simd__validate_dot(from, to);
+			const number_t sign = cos_theta < 0 ? -1. : 1.;
+			cos_theta *= sign;
+
+			quat expected;
+			if (cos_theta > 1. - MATH_EPSILON) {
+				expected = simd__validate_nlerp(from, to, t);
+			}
+			else {
+				const number_t theta = math::acos(cos_theta);
+				const number_t from_t = math::sin((1. - t) * theta) / math::sin(theta);
+				const number_t to_t = math::sin(t * theta) / math::sin(theta) * sign;
+				expected.w = from.w * from_t + to.w * to_t;
+				expected.x = from.x * from_t + to.x * to_t;
+				expected.y = from.y * from_t + to.y * to_t;
+				expected.z = from.z * from_t + to.z * to_t;
+			}
+
+			const quat value = quat::slerp(from, to, t);
+			simd__validate_report(name, simd__validate_error(&value.w, &expected.w, 4));
+		}
+
+		static void simd__validate_quat_ops()
+		{
+			const quat a = simd__validate_unit_quat(.5, -.25, .75, .1);
+			const quat b = simd__validate_unit_quat(.3, .6, .2, .9);
+			// dot of a and c is negative, shortest path flips c
+			const quat c = simd__validate_unit_quat(-.4, .1, -.8, .3);
+			// close enough to a to take nlerp fallback of slerp
+			const quat d = simd__validate_unit_quat(.5, -.25, .75, .1001);
+
+			const number_t dot = a.dot(b);
+			const number_t expected_dot = simd__validate_dot(a, b);
+			simd__validate_report("quat::dot", simd__validate_error(&dot, &expected_dot, 1));
+
+			quat scaled;
+			scaled.w = -1.5; scaled.x = 2.; scaled.y = .5; scaled.z = -3.;
+			const quat normalized = scaled.normalized();
+			const quat expected_normalized = simd__validate_unit_quat(scaled.w, scaled.x, scaled.y, scaled.z);
+			simd__validate_report("quat::normalized", simd__validate_error(&normalized.w, &expected_normalized.w, 4));
+
+			const vec3 point(1.5, -2., 3.25);
+			const vec3 rotated = a.rotate(point);
+			const vec3 expected_rotated = a.to_matrix().mul(point);
+			const number_t rotated_data[] = { rotated.x, rotated.y, rotated.z };
+			const number_t expected_rotated_data[] = { expected_rotated.x, expected_rotated.y, expected_rotated.z };
+			simd__validate_report("quat::rotate", simd__validate_error(rotated_data, expected_rotated_data, 3));
+
+			const quat nlerp = quat::nlerp(a, b, .3);
+			const quat expected_nlerp = simd__validate_nlerp(a, b, .3);
+			simd__validate_report("quat::nlerp", simd__validate_error(&nlerp.w, &expected_nlerp.w, 4));
+			const quat nlerp_negative = quat::nlerp(a, c, .6);
+			const quat expected_nlerp_negative = simd__validate_nlerp(a, c, .6);
+			simd__validate_report("quat::nlerp negative dot", simd__validate_error(&nlerp_negative.w, &expected_nlerp_negative.w, 4));
+
+			simd__validate_slerp("quat::slerp", a, b, .3);
+			simd__validate_slerp("quat::slerp negative dot", a, c, .6);
+			simd__validate_slerp("quat::slerp near parallel", a, d, .5);
+		}
+
+		static void simd__validate_matrix3x3()
+		{
+			const matrix3x3 a(
+				2., -1., .5,
+				.25, 3., -2.,
+				1.5, .75, 4.
+			);
+			const matrix3x3 b(
+				-1., 2., .3,
+				4., -.5, 1.,
+				.2, 1.25, -3.
+			);
+
+			matrix3x3 expected;
+			for (u8 i = 0; i < 3; ++i) {
+				for (u8 j = 0; j < 3; ++j)
+					expected.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j];
+			}
+			const matrix3x3 mul = a.mul(b);
+			simd__validate_report("matrix3x3::mul", simd__validate_error(&mul.m[0][0], &expected.m[0][0], 9));
+
+			const auto& m = a.m;
+			const number_t det = m[0][0] * m[1][1] * m[2][2] +
+				m[1][0] * m[2][1] * m[0][2] +
+				m[2][0] * m[0][1] * m[1][2] -
+				m[2][0] * m[1][1] * m[0][2] -
+				m[1][0] * m[0][1] * m[2][2] -
+				m[0][0] * m[2][1] * m[1][2];
+			const number_t inv_det = 1. / det;
+			expected = matrix3x3(
+				(m[1][1] * m[2][2] - m[2][1] * m[1][2]) * inv_det,
+				-(m[0][1] * m[2][2] - m[2][1] * m[0][2]) * inv_det,
+				(m[0][1] * m[1][2] - m[1][1] * m[0][2]) * inv_det,
+				-(m[1][0] * m[2][2] - m[2][0] * m[1][2]) * inv_det,
+				(m[0][0] * m[2][2] - m[2][0] * m[0][2]) * inv_det,
+				-(m[0][0] * m[1][2] - m[1][0] * m[0][2]) * inv_det,
+				(m[1][0] * m[2][1] - m[2][0] * m[1][1]) * inv_det,
+				-(m[0][0] * m[2][1] - m[2][0] * m[0][1]) * inv_det,
+				(m[0][0] * m[1][1] - m[1][0] * m[0][1]) * inv_det
+			);
+			const matrix3x3 inverse = a.inverse();
+			simd__validate_report("matrix3x3::inverse", simd__validate_error(&inverse.m[0][0], &expected.m[0][0], 9));
+		}
+
+		static void simd__validate_inverse_affine()
+		{
+			const matrix4x4 matrix(
+				2., -1., .5, 10.,
+				.25, 3., -2., -4.,
+				1.5, .75, 4., 2.5,
+				0., 0., 0., 1.
+			);
+
+			matrix4x4 expected;
+			simd__inverse_matrix_scalar(&matrix.m[0][0], &expected.m[0][0]);
+			const matrix4x4 value = matrix4x4::inverse_affine(matrix);
+			simd__validate_report("matrix4x4::inverse_affine", simd__validate_error(&value.m[0][0], &expected.m[0][0], 16));
+		}
+
+		void simd__validate()
+		{
+			simd__validate_cross();
+			simd__validate_quat();
+			simd__validate_quat_ops();
+			simd__validate_matrix3x3();
+			simd__validate_inverse_affine();
+		}
+#else
+		void simd__validate() {}
+#endif
+	}
+}
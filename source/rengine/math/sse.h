@@ -4,29 +4,43 @@
 #if ENGINE_SSE
 	#include <emmintrin.h>
 	#ifdef HIGH_DEFINITION_PRECISION
-		#define sse_load_number(ptr) _mm_loadu_pd(ptr)
-		#define sse_store_number(ptr, val) _mm_storeu_pd(ptr, val)
-		#define sse_cmpeq_number(first, second) _mm_cmpeq_pd(first, second)
-		#define sse_and_number(first, second) _mm_and_pd(first, second)
-		#define sse_movehl_number(first, second) _mm_movehl_pd(first, second)
-		#define sse_shuffle_number(first, second, imm) _mm_shuffle_pd(first, second, imm)
-		#define sse_cast_int_number(first) _mm_castpd_si128(first)
-		#define sse_set_number(w, z, y, x) _mm_set_pd(w, z, y, x)
+		// double lanes keeps layout of 4 numbers, see sse_pd
+		#if defined(__AVX__)
+			#include <immintrin.h>
+			#define SSE_PD_AVX 1
+		#else
+			#define SSE_PD_AVX 0
+		#endif
+		#define sse_load_number(ptr) rengine::math::sse_pd::load(ptr)
+		#define sse_store_number(ptr, val) rengine::math::sse_pd::store(ptr, val)
+		#define sse_load_aligned_number(ptr) rengine::math::sse_pd::load_aligned(ptr)
+		#define sse_store_aligned_number(ptr, val) rengine::math::sse_pd::store_aligned(ptr, val)
+		#define sse_cmpeq_number(first, second) rengine::math::sse_pd::cmpeq(first, second)
+		#define sse_and_number(first, second) rengine::math::sse_pd::_and(first, second)
+		#define sse_shuffle_number(first, second, imm) rengine::math::sse_pd::shuffle<(imm)>(first, second)
+		#define sse_cast_int_number(first) (first)
+		#define sse_set_number(w, z, y, x) rengine::math::sse_pd::set(w, z, y, x)
 		#define sse_set_int(w, z, y, x) _mm_set_epi32(w, z, y, x)
-		#define sse_set_single_number(x) _mm_set1_pd(x)
+		#define sse_set_single_number(x) rengine::math::sse_pd::set_single(x)
 		#define sse_set_single_int(x) _mm_set1_epi32(x)
-		#define sse_add_number(first, second) _mm_add_pd(first, second)
-		#define sse_sub_number(first, second) _mm_sub_pd(first, second)
-		#define sse_mul_number(first, second) _mm_mul_pd(first, second)
-		#define sse_div_number(first, second) _mm_div_pd(first, second)
-		#define sse_unpacklo_number(first, second) _mm_unpacklo_pd(first, second)
-		#define sse_unpackhi_number(first, second) _mm_unpackhi_pd(first, second)
-		#define sse_movelh_number(first, second) _mm_movelh_pd(first, second)
-		#define sse_movehl_number(first, second) _mm_movehl_pd(first, second)
-		#define sse_cvtss_number(x) _mm_cvtsd_f64(x)
+		#define sse_add_number(first, second) rengine::math::sse_pd::add(first, second)
+		#define sse_sub_number(first, second) rengine::math::sse_pd::sub(first, second)
+		#define sse_mul_number(first, second) rengine::math::sse_pd::mul(first, second)
+		#define sse_div_number(first, second) rengine::math::sse_pd::div(first, second)
+		#define sse_unpacklo_number(first, second) rengine::math::sse_pd::unpacklo(first, second)
+		#define sse_unpackhi_number(first, second) rengine::math::sse_pd::unpackhi(first, second)
+		#define sse_movelh_number(first, second) rengine::math::sse_pd::movelh(first, second)
+		#define sse_movehl_number(first, second) rengine::math::sse_pd::movehl(first, second)
+		#define sse_cvtss_number(x) rengine::math::sse_pd::first(x)
+		#define sse_cvtsi128_int(x) rengine::math::sse_pd::first_int(x)
+		#define sse_movemask_number(x) rengine::math::sse_pd::movemask(x)
+
+		#define sse_m128_t rengine::math::sse_pd::m256_t
 	#else
 		#define sse_load_number(ptr) _mm_loadu_ps(ptr)
 		#define sse_store_number(ptr, val) _mm_storeu_ps(ptr, val)
+		#define sse_load_aligned_number(ptr) _mm_load_ps(ptr)
+		#define sse_store_aligned_number(ptr, val) _mm_store_ps(ptr, val)
 		#define sse_cmpeq_number(first, second) _mm_cmpeq_ps(first, second)
 		#define sse_and_number(first, second) _mm_and_ps(first, second)
 		#define sse_movehl_number(first, second) _mm_movehl_ps(first, second)	
@@ -45,13 +59,16 @@
 		#define sse_movelh_number(first, second) _mm_movelh_ps(first, second)
 		#define sse_movehl_number(first, second) _mm_movehl_ps(first, second)
 		#define sse_cvtss_number(x) _mm_cvtss_f32(x)
-	#endif
-	#define sse_cvtsi128_int(x) _mm_cvtsi128_si32(x)
+		#define sse_cvtsi128_int(x) _mm_cvtsi128_si32(x)
+		#define sse_movemask_number(x) _mm_movemask_ps(x)
 
-	#define sse_m128_t __m128
+		#define sse_m128_t __m128
+	#endif
 #else
 	#define sse_load_number(ptr) rengine::math::fake_sse::load(ptr)
 	#define sse_store_number(ptr, val) rengine::math::fake_sse::store(ptr, val)
+	#define sse_load_aligned_number(ptr) rengine::math::fake_sse::load(ptr)
+	#define sse_store_aligned_number(ptr, val) rengine::math::fake_sse::store(ptr, val)
 	#define sse_cmpeq_number(first, second) rengine::math::fake_sse::cmpeq(first, second)
     #define sse_and_number(first, second) rengine::math::fake_sse::_and(first, second)
 	#define sse_movehl_number(first, second) rengine::math::fake_sse::movehl(first, second)
@@ -71,6 +88,7 @@
 	#define sse_movelh_number(first, second) rengine::math::fake_sse::movelh(first, second)
 	#define sse_movehl_number(first, second) rengine::math::fake_sse::movehl(first, second)
 	#define sse_cvtss_number(x) x.n[0]
+	#define sse_movemask_number(x) rengine::math::fake_sse::movemask(x)
 
 	#define sse_m128_t rengine::math::fake_sse::m128_t
 #endif
@@ -89,6 +107,15 @@
 		row2 = sse_shuffle_number(_tmp2, _tmp3, 0x88); \
 		row3 = sse_shuffle_number(_tmp2, _tmp3, 0xDD); \
 	}
+// cross product of x, y and z lanes, w lane is zero
+#define sse_cross_number(a, b) sse_sub_number( \
+	sse_mul_number(sse_shuffle_number(a, a, sse_shuffle(3, 0, 2, 1)), sse_shuffle_number(b, b, sse_shuffle(3, 1, 0, 2))), \
+	sse_mul_number(sse_shuffle_number(a, a, sse_shuffle(3, 1, 0, 2)), sse_shuffle_number(b, b, sse_shuffle(3, 0, 2, 1))))
+// sums all lanes, result is stored on every lane
+#define sse_hsum_number(v) { \
+		v = sse_add_number(v, sse_shuffle_number(v, v, sse_shuffle(1, 0, 3, 2))); \
+		v = sse_add_number(v, sse_shuffle_number(v, v, sse_shuffle(2, 3, 0, 1))); \
+	}
 
 namespace rengine {
 	namespace math {
@@ -143,6 +170,14 @@ namespace rengine {
 				result.n[3] = second.n[b1];
 				return result;
 			}
+
+			// sign bit of each lane
+			inline int movemask(const m128_t& value) {
+				int result = 0;
+				for (u8 i = 0; i < 4; ++i)
+					result |= signbit(value.n[i]) ? 1 << i : 0;
+				return result;
+			}
 		
 			constexpr m128i_t cast_int(const m128_t& x) {
 				m128i_t ret;
@@ -238,4 +273,117 @@ namespace rengine {
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+#if ENGINE_SSE && defined(HIGH_DEFINITION_PRECISION)
+namespace rengine {
+	namespace math {
+		/*
+		* Double precision lanes with same semantics of float sse operations,
+		* a register holds 4 numbers then all kernels written with sse_*_number macros works on both precisions.
+		* Builds with avx uses a single 256 bits register, otherwise a pair of sse2 registers is used.
+		*/
+		namespace sse_pd {
+			struct m256_t {
+#if SSE_PD_AVX
+				__m256d v;
+#else
+				// x, y
+				__m128d lo;
+				// z, w
+				__m128d hi;
+#endif
+			};
+
+#if SSE_PD_AVX
+			inline m256_t load(const double* ptr) { return { _mm256_loadu_pd(ptr) }; }
+			inline m256_t load_aligned(const double* ptr) { return { _mm256_load_pd(ptr) }; }
+			inline void store(double* ptr, const m256_t& val) { _mm256_storeu_pd(ptr, val.v); }
+			inline void store_aligned(double* ptr, const m256_t& val) { _mm256_store_pd(ptr, val.v); }
+			inline m256_t set(double w, double z, double y, double x) { return { _mm256_set_pd(w, z, y, x) }; }
+			inline m256_t set_single(double x) { return { _mm256_set1_pd(x) }; }
+			inline m256_t cmpeq(const m256_t& a, const m256_t& b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ) }; }
+			inline m256_t _and(const m256_t& a, const m256_t& b) { return { _mm256_and_pd(a.v, b.v) }; }
+			inline m256_t add(const m256_t& a, const m256_t& b) { return { _mm256_add_pd(a.v, b.v) }; }
+			inline m256_t sub(const m256_t& a, const m256_t& b) { return { _mm256_sub_pd(a.v, b.v) }; }
+			inline m256_t mul(const m256_t& a, const m256_t& b) { return { _mm256_mul_pd(a.v, b.v) }; }
+			inline m256_t div(const m256_t& a, const m256_t& b) { return { _mm256_div_pd(a.v, b.v) }; }
+			// a0 a1 b0 b1
+			inline m256_t movelh(const m256_t& a, const m256_t& b) { return { _mm256_permute2f128_pd(a.v, b.v, 0x20) }; }
+			// b2 b3 a2 a3
+			inline m256_t movehl(const m256_t& a, const m256_t& b) { return { _mm256_permute2f128_pd(a.v, b.v, 0x13) }; }
+			// a0 b0 a1 b1, in lane unpack gives a0 b0 a2 b2 and a1 b1 a3 b3
+			inline m256_t unpacklo(const m256_t& a, const m256_t& b) {
+				return { _mm256_permute2f128_pd(_mm256_unpacklo_pd(a.v, b.v), _mm256_unpackhi_pd(a.v, b.v), 0x20) };
+			}
+			// a2 b2 a3 b3
+			inline m256_t unpackhi(const m256_t& a, const m256_t& b) {
+				return { _mm256_permute2f128_pd(_mm256_unpacklo_pd(a.v, b.v), _mm256_unpackhi_pd(a.v, b.v), 0x31) };
+			}
+			inline double first(const m256_t& x) { return _mm_cvtsd_f64(_mm256_castpd256_pd128(x.v)); }
+			inline int first_int(const m256_t& x) { return _mm_cvtsi128_si32(_mm_castpd_si128(_mm256_castpd256_pd128(x.v))); }
+			inline int movemask(const m256_t& x) { return _mm256_movemask_pd(x.v); }
+
+			// picks lanes i0 and i1 of x
+			template<int i0, int i1>
+			inline __m128d pick(const m256_t& x) {
+				const __m128d lo = _mm256_castpd256_pd128(x.v);
+				const __m128d hi = _mm256_extractf128_pd(x.v, 1);
+				return _mm_shuffle_pd(i0 < 2 ? lo : hi, i1 < 2 ? lo : hi, (i0 & 1) | ((i1 & 1) << 1));
+			}
+
+			template<int imm>
+			inline m256_t shuffle(const m256_t& a, const m256_t& b) {
+#if defined(__AVX2__)
+				return { _mm256_blend_pd(_mm256_permute4x64_pd(a.v, imm), _mm256_permute4x64_pd(b.v, imm), 0xC) };
+#else
+				const __m128d lo = pick<imm & 3, (imm >> 2) & 3>(a);
+				const __m128d hi = pick<(imm >> 4) & 3, (imm >> 6) & 3>(b);
+				return { _mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1) };
+#endif
+			}
+#else
+			inline m256_t load(const double* ptr) { return { _mm_loadu_pd(ptr), _mm_loadu_pd(ptr + 2) }; }
+			inline m256_t load_aligned(const double* ptr) { return { _mm_load_pd(ptr), _mm_load_pd(ptr + 2) }; }
+			inline void store(double* ptr, const m256_t& val) {
+				_mm_storeu_pd(ptr, val.lo);
+				_mm_storeu_pd(ptr + 2, val.hi);
+			}
+			inline void store_aligned(double* ptr, const m256_t& val) {
+				_mm_store_pd(ptr, val.lo);
+				_mm_store_pd(ptr + 2, val.hi);
+			}
+			inline m256_t set(double w, double z, double y, double x) { return { _mm_set_pd(y, x), _mm_set_pd(w, z) }; }
+			inline m256_t set_single(double x) { return { _mm_set1_pd(x), _mm_set1_pd(x) }; }
+			inline m256_t cmpeq(const m256_t& a, const m256_t& b) { return { _mm_cmpeq_pd(a.lo, b.lo), _mm_cmpeq_pd(a.hi, b.hi) }; }
+			inline m256_t _and(const m256_t& a, const m256_t& b) { return { _mm_and_pd(a.lo, b.lo), _mm_and_pd(a.hi, b.hi) }; }
+			inline m256_t add(const m256_t& a, const m256_t& b) { return { _mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi) }; }
+			inline m256_t sub(const m256_t& a, const m256_t& b) { return { _mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi) }; }
+			inline m256_t mul(const m256_t& a, const m256_t& b) { return { _mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi) }; }
+			inline m256_t div(const m256_t& a, const m256_t& b) { return { _mm_div_pd(a.lo, b.lo), _mm_div_pd(a.hi, b.hi) }; }
+			// a0 a1 b0 b1
+			inline m256_t movelh(const m256_t& a, const m256_t& b) { return { a.lo, b.lo }; }
+			// b2 b3 a2 a3
+			inline m256_t movehl(const m256_t& a, const m256_t& b) { return { b.hi, a.hi }; }
+			// a0 b0 a1 b1
+			inline m256_t unpacklo(const m256_t& a, const m256_t& b) { return { _mm_unpacklo_pd(a.lo, b.lo), _mm_unpackhi_pd(a.lo, b.lo) }; }
+			// a2 b2 a3 b3
+			inline m256_t unpackhi(const m256_t& a, const m256_t& b) { return { _mm_unpacklo_pd(a.hi, b.hi), _mm_unpackhi_pd(a.hi, b.hi) }; }
+			inline double first(const m256_t& x) { return _mm_cvtsd_f64(x.lo); }
+			inline int first_int(const m256_t& x) { return _mm_cvtsi128_si32(_mm_castpd_si128(x.lo)); }
+			inline int movemask(const m256_t& x) { return _mm_movemask_pd(x.lo) | (_mm_movemask_pd(x.hi) << 2); }
+
+			// picks lanes i0 and i1 of x
+			template<int i0, int i1>
+			inline __m128d pick(const m256_t& x) {
+				return _mm_shuffle_pd(i0 < 2 ? x.lo : x.hi, i1 < 2 ? x.lo : x.hi, (i0 & 1) | ((i1 & 1) << 1));
+			}
+
+			template<int imm>
+			inline m256_t shuffle(const m256_t& a, const m256_t& b) {
+				return { pick<imm & 3, (imm >> 2) & 3>(a), pick<(imm >> 4) & 3, (imm >> 6) & 3>(b) };
+			}
+#endif
+		}
+	}
+}
+#endif
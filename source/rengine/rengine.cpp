@@ -1,12 +1,14 @@
 #include "./rengine.h"
 #include "./rengine_private.h"
 #include "./core/arena_private.h"
+#include "./core/job_system_private.h"
 #include "./core/string_pool_private.h"
 #include "./core/profiler.h"
 #include "./core/window_private.h"
 #include "./core/profiler_private.h"
 #include "./graphics/graphics_private.h"
 #include "./io/logger_private.h"
+#include "./math/simd_private.h"
 #include "./resources/resources_private.h"
 
 namespace rengine {
@@ -22,7 +24,9 @@ namespace rengine {
 
         action_t actions[] = {
             io::logger__init,
+            math::simd__init,
             core::arena__init,
+            core::job_system__init,
             core::string_pool__init,
             core::window__init,
             core::profiler__init,
@@ -45,9 +49,12 @@ namespace rengine {
         action_t actions[] = {
             graphics::deinit,
             core::window__deinit,
-            core::profiler__deinit,
             resources::resources__deinit,
             core::string_pool__deinit,
+            // workers and logger thread must be joined before profiler frees their trace buffers
+            core::job_system__deinit,
+            io::logger__stop,
+            core::profiler__deinit,
             core::arena__deinit,
             io::logger__deinit,
         };
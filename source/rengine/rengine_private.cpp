@@ -1,6 +1,7 @@
 #include "./rengine_private.h"
 #include "./events/engine_events.h"
 #include "./core/profiler_private.h"
+#include "./core/allocator_private.h"
 #include "./core/window.h"
 #include "./core/arena.h"
 #include "./graphics/graphics_private.h"
@@ -29,6 +30,8 @@ namespace rengine {
 		if (core::window_is_destroyed(g_engine_state.window_id))
 			g_engine_state.window_id = core::no_window;
 
+		events::event_bus_dispatch_all();
+
 		EVENT_EMIT(engine, begin_update)();
 
 		engine__begin_timer();
@@ -48,7 +51,9 @@ namespace rengine {
 		graphics::end();
 
 		EVENT_EMIT(engine, end_update)();
+		events::event_bus_dispatch_all();
 
+		core::alloc__sample_general_stats();
 		core::profiler__end_frame();
 	}
 
@@ -17,7 +17,7 @@ namespace rengine {
 		// TODO: add memory reuse for images
 		ptr image__malloc(size_t size)
 		{
-			return core::alloc(size);
+			return core::alloc(size, core::alloc_tag::image);
 		}
 
 		ptr image__realloc(ptr mem, size_t size)
@@ -49,12 +49,8 @@ namespace rengine {
 
 			if (pos.x >= img->size.x || pos.y >= img->size.y) {
 				const auto log = g_image_state.logger;
-				if (log) {
-					log->warn(
-						fmt::format(strings::logs::g_image_pos_exceeds_bounds,
-							pos.x, pos.y, img->size.x, img->size.y)
-						.c_str());
-				}
+				if (log)
+					log_warn_limited(log, strings::logs::g_image_pos_exceeds_bounds, pos.x, pos.y, img->size.x, img->size.y);
 				pos.x = math::min<u32>(pos.x, img->size.x - 1);
 				pos.y = math::min<u32>(pos.y, img->size.y - 1);
 			}
@@ -65,7 +61,7 @@ namespace rengine {
 			auto& state = g_image_state;
 			auto pixelbuffer_size = desc.size.x * desc.size.y * desc.components;
 
-			image_t* img = (image_t*)core::alloc(sizeof(image_t) + pixelbuffer_size);
+			image_t* img = (image_t*)core::alloc(sizeof(image_t) + pixelbuffer_size, core::alloc_tag::image);
 			img->prev = state.root;
 			img->next = null;
 			img->size = desc.size;
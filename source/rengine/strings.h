@@ -17,6 +17,26 @@ namespace rengine {
             "index buffer",
             "constant buffer"
         };
+        // must follow core::alloc_tag order
+        constexpr static c_str g_alloc_tag_names[] = {
+            "general",
+            "drawing",
+            "imgui",
+            "diligent",
+            "image",
+            "string_pool",
+            "logger",
+            "render_command",
+            "profiler",
+            "events"
+        };
+        // must follow math::simd_level order
+        constexpr static c_str g_simd_level_names[] = {
+            "scalar",
+            "sse2",
+            "avx2",
+            "avx512"
+        };
 
         constexpr static c_str g_pool_id = "pool";
         constexpr static c_str g_engine_monitor_fps = "FPS: {:.1f}";
@@ -26,6 +46,32 @@ namespace rengine {
         namespace profiler {
             constexpr static c_str engine_loop = "rengine::loop";
             constexpr static c_str graphics_loop = "graphics";
+            constexpr static c_str main_thread = "rengine::main";
+            constexpr static c_str job_worker_thread = "rengine::worker {0}";
+            constexpr static c_str logger_thread = "rengine::logger";
+            constexpr static c_str trace_thread = "thread {0}";
+            constexpr static c_str trace_unknown = "unknown";
+            constexpr static c_str pipeline_cache_hits = "rengine::pipeline_cache::hits";
+            constexpr static c_str pipeline_cache_misses = "rengine::pipeline_cache::misses";
+            constexpr static c_str pipeline_cache_collisions = "rengine::pipeline_cache::collisions";
+            constexpr static c_str srb_cache_hits = "rengine::srb_cache::hits";
+            constexpr static c_str srb_cache_misses = "rengine::srb_cache::misses";
+            constexpr static c_str srb_cache_collisions = "rengine::srb_cache::collisions";
+            constexpr static c_str program_cache_hits = "rengine::program_cache::hits";
+            constexpr static c_str program_cache_misses = "rengine::program_cache::misses";
+            constexpr static c_str program_cache_collisions = "rengine::program_cache::collisions";
+            constexpr static c_str render_cmd_cache_hits = "rengine::render_command_cache::hits";
+            constexpr static c_str render_cmd_cache_misses = "rengine::render_command_cache::misses";
+            constexpr static c_str render_cmd_cache_collisions = "rengine::render_command_cache::collisions";
+            constexpr static c_str frame_draws = "rengine::frame::draws";
+            constexpr static c_str frame_primitives = "rengine::frame::primitives";
+            constexpr static c_str frame_pipeline_binds = "rengine::frame::pipeline_binds";
+            constexpr static c_str frame_srb_commits = "rengine::frame::srb_commits";
+            constexpr static c_str frame_vbuffer_binds = "rengine::frame::vbuffer_binds";
+            constexpr static c_str frame_redundant_sets = "rengine::frame::redundant_sets";
+            constexpr static c_str frame_uploaded_bytes = "rengine::frame::uploaded_bytes";
+            constexpr static c_str frame_pipelines_created = "rengine::frame::pipelines_created";
+            constexpr static c_str frame_srbs_created = "rengine::frame::srbs_created";
         }
 
         namespace graphics {
@@ -42,6 +88,7 @@ namespace rengine {
             constexpr static c_str g_default_cmd_name = "rengine::render_command";
 
             constexpr static c_str g_frame_buffer_name = "rengine::graphics::frame::cbuffer";
+            constexpr static c_str g_frame_fence_name = "rengine::graphics::frame::fence";
 
 			constexpr static c_str g_imgui_mgr_name = "rengine::imgui::manager::font_texture";
             constexpr static c_str g_imgui_mgr_tex_slot = "g_texture";
@@ -165,6 +212,7 @@ namespace rengine {
         namespace logs {
             constexpr static c_str g_engine_tag = "rengine";
             constexpr static c_str g_arena_tag = "core::arena";
+            constexpr static c_str g_job_system_tag = "core::job_system";
             constexpr static c_str g_graphics_tag = "graphics";
             constexpr static c_str g_diligent_tag = "diligent";
             constexpr static c_str g_buffer_mgr_tag = "buffer_mgr";
@@ -174,16 +222,28 @@ namespace rengine {
             constexpr static c_str g_srb_mgr_tag = "srb";
             constexpr static c_str g_tex_mgr_tag = "texture_mgr";
             constexpr static c_str g_image_tag = "image";
+            constexpr static c_str g_logger_tag = "io::logger";
+            constexpr static c_str g_math_tag = "math";
 
             constexpr static c_str g_image_pos_exceeds_bounds =
                 "Position exceeds Image Bounds. pos.x = {0}, pos.y = {1}, width = {2}, height = {3}";
 
             constexpr static c_str g_logger_fmt = "[{0}/{1}/{2} {3}:{4}:{5}][{6}][{7}]: {8}";
+            constexpr static c_str g_logger_site_suppressed = "{0} previous messages from this call site were suppressed, call site is limited to {1} messages every {2}ms";
+            constexpr static c_str g_logger_dropped_records = "{0} log records were dropped because thread ring was full. Increase IO_LOGGER_RING_SIZE ({1}) to keep them";
+            constexpr static c_str g_logger_truncated_mark = "...";
 
             constexpr static c_str g_engine_already_stopped = "Engine is already stopped";
 
             constexpr static c_str g_arena_free_invalid = "Invalid Arena. Can't free an Arena that has not been created by the Engine";
 
+            constexpr static c_str g_job_system_started = "Job System has been started with {0} workers";
+
+            constexpr static c_str g_math_simd_level = "Math kernels are using {0} instruction set, best supported by this CPU is {1}";
+            constexpr static c_str g_math_simd_validation_failed = "Math validation failed, {0} differs from scalar reference by {1}";
+
+            constexpr static c_str g_profiler_mem_events_dropped = "Profiler dropped {0} memory events before start, memory tracking is disabled. Increase CORE_PROFILER_DELAYED_MAX_CHUNKS to continue";
+
             constexpr static c_str g_graphics_invalid_adapter_id = "Invalid adapter id {0}. Engine will try to select a best match device";
             constexpr static c_str g_graphics_no_suitable_device_found = "No suitable device found, using first available.";
             constexpr static c_str g_graphics_swapchain_has_been_created = "SwapChain has been created for window {0}";
@@ -222,6 +282,9 @@ namespace rengine {
         namespace exceptions {
             constexpr static c_str g_null_object = "{0} is null";
             constexpr static c_str g_core_alloc_memory_exceeded = "Memory limit exceeded!";
+			constexpr static c_str g_core_virtual_memory_reserve_failed = "Failed to reserve virtual memory. Reserve Size = {0} bytes";
+			constexpr static c_str g_core_virtual_memory_commit_failed = "Failed to commit virtual memory. Commit Size = {0} bytes";
+			constexpr static c_str g_core_alloc_scratch_invalid_rewind = "Invalid scratch rewind. Scratch scopes must be released in reverse order. Marker Depth = {0}, Current Depth = {1}";
 			constexpr static c_str g_core_alloc_scratch_memory_exceeded = "Scratch memory limit exceeded! Increase the size of scratch buffer to continue. Current size = {0} bytes, Required size = {1} bytes";
 
             constexpr static c_str g_window_invalid_id = "Invalid window id";
@@ -233,8 +296,15 @@ namespace rengine {
 			constexpr static c_str g_logger_reached_max_log_objects = "Reached max of created log objects.";
 
             constexpr static c_str g_queue_empty = "Queue is empty";
+            constexpr static c_str g_profiler_capture_in_progress = "Profiler capture is already in progress";
+            constexpr static c_str g_profiler_capture_not_started = "Profiler capture has not been started";
+            constexpr static c_str g_profiler_capture_open_failed = "Failed to open trace file '{0}'";
+            constexpr static c_str g_profiler_capture_invalid_file = "Invalid trace file '{0}'";
+            constexpr static c_str g_string_pool_hash_mismatch = "Static hash of '{0}' ({1}) doesn't match runtime hash ({2})";
+
 
-            constexpr static c_str g_profiler_reached_entries = "Reached max of profiler entries. Increase the current capacity to continue";
+            constexpr static c_str g_job_system_not_initialized = "Job System is not initialized";
+            constexpr static c_str g_job_system_reached_dependents = "Job {0} has reached max of {1} dependents. Increase CORE_JOB_SYSTEM_MAX_DEPENDENTS to continue";
 
             constexpr static c_str g_graphics_unsupported_backend = "Unsupported graphics backend {0} on this platform";
             constexpr static c_str g_graphics_not_initialized = "Graphics is not initialized";
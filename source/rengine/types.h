@@ -16,7 +16,7 @@ namespace rengine {
     // data primitives
     typedef const char* c_str;
     typedef unsigned char byte;
-    typedef unsigned short entity;
+    typedef unsigned int entity;
     typedef void* ptr;
 
     #ifdef HIGH_DEFINITION_PRECISION
@@ -37,20 +37,23 @@ namespace rengine {
         typedef u32 window_t;
         static u32 no_window = MAX_U32_VALUE;
         typedef u32 hash_t;
+        typedef u64 hash64_t;
+        typedef u32 job_t;
+        static u32 no_job = MAX_U32_VALUE;
     }
 
     namespace graphics {
         // buffer objects
-        typedef u16 vertex_buffer_t;
-        typedef u16 index_buffer_t;
-        typedef u16 constant_buffer_t;
+        typedef u32 vertex_buffer_t;
+        typedef u32 index_buffer_t;
+        typedef u32 constant_buffer_t;
         typedef u16 instancing_buffer_t;
         // texture objects
-        typedef u16 texture2d_t;
-        typedef u16 texture_3d_t;
-        typedef u16 texture_cube_t;
-        typedef u16 texture_array_t;
-        typedef u16 render_target_t;
+        typedef u32 texture2d_t;
+        typedef u32 texture_3d_t;
+        typedef u32 texture_cube_t;
+        typedef u32 texture_array_t;
+        typedef u32 render_target_t;
         typedef u32 pipeline_state_t;
         typedef u32 srb_t;
         // shader objects
@@ -65,17 +68,17 @@ namespace rengine {
         typedef u8 camera_t;
         typedef LIGHT_ENTITY_SIZE light_t;
 
-        static u16 no_vertex_buffer       = MAX_U16_VALUE;
-        static u16 no_index_buffer        = MAX_U16_VALUE;
-        static u16 no_constant_buffer     = MAX_U8_VALUE;
+        static u32 no_vertex_buffer       = MAX_U32_VALUE;
+        static u32 no_index_buffer        = MAX_U32_VALUE;
+        static u32 no_constant_buffer     = MAX_U32_VALUE;
         static u8 no_instancing_buffer    = MAX_U8_VALUE;
-        static u8 no_texture_2d           = MAX_U8_VALUE;
-        static u8 no_texture_3d           = MAX_U8_VALUE;
-        static u8 no_texture_cube         = MAX_U8_VALUE;
-        static u8 no_texture_array        = MAX_U8_VALUE;
-        static u8 no_render_target        = MAX_U8_VALUE;
-        static u16 no_pipeline_state      = MAX_U16_VALUE;
-        static u16 no_srb                 = MAX_U16_VALUE;
+        static u32 no_texture_2d          = MAX_U32_VALUE;
+        static u32 no_texture_3d          = MAX_U32_VALUE;
+        static u32 no_texture_cube        = MAX_U32_VALUE;
+        static u32 no_texture_array       = MAX_U32_VALUE;
+        static u32 no_render_target       = MAX_U32_VALUE;
+        static u32 no_pipeline_state      = MAX_U32_VALUE;
+        static u32 no_srb                 = MAX_U32_VALUE;
         static u32 no_shader              = MAX_U32_VALUE;
         static u32 no_shader_program      = MAX_U32_VALUE;
 		static u32 no_render_command      = 0;
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+
+#include <rengine/core/ring_queue.h>
+
+using namespace rengine;
+
+// values carries producer index on high bits and sequence on low bits,
+// then consumer can check that nothing was lost, duplicated or reordered
+constexpr u32 g_queue_capacity = 1024;
+constexpr u32 g_batch_size = 32;
+constexpr u64 g_default_items = 10000000;
+
+static u64 make_value(u32 producer, u64 seq)
+{
+    return ((u64)producer << 40) | seq;
+}
+
+struct stress_result
+{
+    u64 num_items{ 0 };
+    u64 num_errors{ 0 };
+    double seconds{ 0 };
+};
+
+template<typename Queue>
+static stress_result run_stress(Queue& queue, u32 num_producers, u64 items_per_producer, bool batch)
+{
+    stress_result result;
+    std::vector<u64> next_seq(num_producers, 0);
+    std::vector<std::thread> producers;
+    producers.reserve(num_producers);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 producer = 0; producer < num_producers; ++producer)
+    {
+        producers.emplace_back([&queue, producer, items_per_producer, batch]()
+        {
+            u64 values[g_batch_size];
+            u64 seq = 0;
+            while (seq < items_per_producer)
+            {
+                if (!batch)
+                {
+                    if (queue.try_push(make_value(producer, seq)))
+                        ++seq;
+                    else
+                        std::this_thread::yield();
+                    continue;
+                }
+
+                const u64 left = items_per_producer - seq;
+                const u32 count = (u32)(left < g_batch_size ? left : g_batch_size);
+                for (u32 i = 0; i < count; ++i)
+                    values[i] = make_value(producer, seq + i);
+
+                const u32 pushed = queue.try_push_batch(values, count);
+                seq += pushed;
+                if (pushed == 0)
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    const u64 total = items_per_producer * num_producers;
+    u64 values[g_batch_size];
+    while (result.num_items < total)
+    {
+        const u32 count = batch ? queue.try_pop_batch(values, g_batch_size) : (u32)queue.try_pop(values[0]);
+        if (count == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            const u32 producer = (u32)(values[i] >> 40);
+            const u64 seq = values[i] & ((1ull << 40) - 1);
+            // items of a single producer must arrive in push order
+            if (producer >= num_producers || seq != next_seq[producer])
+                ++result.num_errors;
+            else
+                ++next_seq[producer];
+        }
+        result.num_items += count;
+    }
+
+    for (auto& thread : producers)
+        thread.join();
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!queue.empty())
+        ++result.num_errors;
+    return result;
+}
+
+static bool report(const char* name, const stress_result& result)
+{
+    const double mops = result.seconds > 0 ? result.num_items / result.seconds / 1e6 : 0;
+    std::cout << name << ": " << result.num_items << " items in " << result.seconds << "s ("
+        << mops << " M items/s), " << result.num_errors << " errors" << std::endl;
+    return result.num_errors == 0;
+}
+
+int main(int argc, char** argv)
+{
+    u64 num_items = g_default_items;
+    if (argc > 1)
+        num_items = std::stoull(argv[1]);
+
+    const u32 num_threads = std::thread::hardware_concurrency();
+    const u32 num_producers = num_threads > 2 ? num_threads - 1 : 2;
+
+    // queues are too large to live on stack
+    auto* spsc = new core::spsc_queue<u64, g_queue_capacity>();
+    auto* mpsc = new core::mpsc_queue<u64, g_queue_capacity>();
+
+    bool success = true;
+    success &= report("spsc", run_stress(*spsc, 1, num_items, false));
+    success &= report("spsc batch", run_stress(*spsc, 1, num_items, true));
+    success &= report("mpsc 1 producer", run_stress(*mpsc, 1, num_items, false));
+    success &= report("mpsc", run_stress(*mpsc, num_producers, num_items / num_producers, false));
+    success &= report("mpsc batch", run_stress(*mpsc, num_producers, num_items / num_producers, true));
+
+    delete spsc;
+    delete mpsc;
+
+    if (!success)
+    {
+        std::cerr << "Queue stress test failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
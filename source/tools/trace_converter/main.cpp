@@ -0,0 +1,25 @@
+#include <iostream>
+
+#include <rengine/rengine.h>
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: trace_converter <binary trace file> <json output file>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        rengine::core::profiler_capture_convert(argv[1], argv[2]);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Trace written to " << argv[2] << std::endl;
+    return 0;
+}